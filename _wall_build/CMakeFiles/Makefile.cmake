@@ -0,0 +1,86 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/compute_node/CMakeLists.txt"
+  "/root/repo/compute_node/handler/CMakeLists.txt"
+  "/root/repo/compute_node/run/CMakeLists.txt"
+  "/root/repo/memory_node/CMakeLists.txt"
+  "/root/repo/memory_node/server/CMakeLists.txt"
+  "/root/repo/thirdparty/rlib/CMakeLists.txt"
+  "/root/repo/txn/CMakeLists.txt"
+  "/root/repo/workload/CMakeLists.txt"
+  "/root/repo/workload/micro/CMakeLists.txt"
+  "/root/repo/workload/smallbank/CMakeLists.txt"
+  "/root/repo/workload/tatp/CMakeLists.txt"
+  "/root/repo/workload/tpcc/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "thirdparty/rlib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "txn/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "workload/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "workload/tatp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "workload/tpcc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "workload/smallbank/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "workload/micro/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "compute_node/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "compute_node/handler/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "compute_node/run/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "memory_node/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "memory_node/server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "thirdparty/rlib/CMakeFiles/rlib.dir/DependInfo.cmake"
+  "txn/CMakeFiles/motor.dir/DependInfo.cmake"
+  "workload/tatp/CMakeFiles/tatp_db.dir/DependInfo.cmake"
+  "workload/tatp/CMakeFiles/tatp_txn.dir/DependInfo.cmake"
+  "workload/tpcc/CMakeFiles/tpcc_db.dir/DependInfo.cmake"
+  "workload/tpcc/CMakeFiles/tpcc_txn.dir/DependInfo.cmake"
+  "workload/smallbank/CMakeFiles/smallbank_db.dir/DependInfo.cmake"
+  "workload/smallbank/CMakeFiles/smallbank_txn.dir/DependInfo.cmake"
+  "workload/micro/CMakeFiles/micro_db.dir/DependInfo.cmake"
+  "workload/micro/CMakeFiles/micro_txn.dir/DependInfo.cmake"
+  "compute_node/handler/CMakeFiles/handler.dir/DependInfo.cmake"
+  "compute_node/run/CMakeFiles/run.dir/DependInfo.cmake"
+  "compute_node/run/CMakeFiles/run_micro.dir/DependInfo.cmake"
+  "compute_node/run/CMakeFiles/ipc_loadgen.dir/DependInfo.cmake"
+  "compute_node/run/CMakeFiles/addr_cache_bench.dir/DependInfo.cmake"
+  "memory_node/server/CMakeFiles/motor_mempool.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,32 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/compute_node/handler/config_cn.cc" "compute_node/handler/CMakeFiles/handler.dir/config_cn.cc.o" "gcc" "compute_node/handler/CMakeFiles/handler.dir/config_cn.cc.o.d"
+  "/root/repo/compute_node/handler/gen_output.cc" "compute_node/handler/CMakeFiles/handler.dir/gen_output.cc.o" "gcc" "compute_node/handler/CMakeFiles/handler.dir/gen_output.cc.o.d"
+  "/root/repo/compute_node/handler/ipc.cc" "compute_node/handler/CMakeFiles/handler.dir/ipc.cc.o" "gcc" "compute_node/handler/CMakeFiles/handler.dir/ipc.cc.o.d"
+  "/root/repo/compute_node/handler/worker.cc" "compute_node/handler/CMakeFiles/handler.dir/worker.cc.o" "gcc" "compute_node/handler/CMakeFiles/handler.dir/worker.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_wall_build/txn/CMakeFiles/motor.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/tatp/CMakeFiles/tatp_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/tatp/CMakeFiles/tatp_txn.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/smallbank/CMakeFiles/smallbank_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/smallbank/CMakeFiles/smallbank_txn.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/tpcc/CMakeFiles/tpcc_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/tpcc/CMakeFiles/tpcc_txn.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/micro/CMakeFiles/micro_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/micro/CMakeFiles/micro_txn.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/thirdparty/rlib/CMakeFiles/rlib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/handler.dir/config_cn.cc.o"
+  "CMakeFiles/handler.dir/config_cn.cc.o.d"
+  "CMakeFiles/handler.dir/gen_output.cc.o"
+  "CMakeFiles/handler.dir/gen_output.cc.o.d"
+  "CMakeFiles/handler.dir/ipc.cc.o"
+  "CMakeFiles/handler.dir/ipc.cc.o.d"
+  "CMakeFiles/handler.dir/worker.cc.o"
+  "CMakeFiles/handler.dir/worker.cc.o.d"
+  "libhandler.a"
+  "libhandler.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/handler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
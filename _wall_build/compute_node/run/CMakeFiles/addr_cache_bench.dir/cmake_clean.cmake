@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/addr_cache_bench.dir/addr_cache_bench.cc.o"
+  "CMakeFiles/addr_cache_bench.dir/addr_cache_bench.cc.o.d"
+  "addr_cache_bench"
+  "addr_cache_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/addr_cache_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
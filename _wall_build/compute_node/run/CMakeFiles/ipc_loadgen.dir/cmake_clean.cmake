@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ipc_loadgen.dir/ipc_loadgen.cc.o"
+  "CMakeFiles/ipc_loadgen.dir/ipc_loadgen.cc.o.d"
+  "ipc_loadgen"
+  "ipc_loadgen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ipc_loadgen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
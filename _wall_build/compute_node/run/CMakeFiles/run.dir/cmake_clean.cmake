@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/run.dir/run.cc.o"
+  "CMakeFiles/run.dir/run.cc.o.d"
+  "run"
+  "run.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/run.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
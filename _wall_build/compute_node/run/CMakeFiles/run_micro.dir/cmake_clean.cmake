@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/run_micro.dir/run_micro.cc.o"
+  "CMakeFiles/run_micro.dir/run_micro.cc.o.d"
+  "run_micro"
+  "run_micro.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/run_micro.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/memory_node/server/server.cc" "memory_node/server/CMakeFiles/motor_mempool.dir/server.cc.o" "gcc" "memory_node/server/CMakeFiles/motor_mempool.dir/server.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_wall_build/workload/tatp/CMakeFiles/tatp_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/smallbank/CMakeFiles/smallbank_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/tpcc/CMakeFiles/tpcc_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/workload/micro/CMakeFiles/micro_db.dir/DependInfo.cmake"
+  "/root/repo/_wall_build/thirdparty/rlib/CMakeFiles/rlib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
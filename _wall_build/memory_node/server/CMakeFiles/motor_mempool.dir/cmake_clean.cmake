@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/motor_mempool.dir/server.cc.o"
+  "CMakeFiles/motor_mempool.dir/server.cc.o.d"
+  "motor_mempool"
+  "motor_mempool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/motor_mempool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/txn/connection/meta_manager.cc" "txn/CMakeFiles/motor.dir/connection/meta_manager.cc.o" "gcc" "txn/CMakeFiles/motor.dir/connection/meta_manager.cc.o.d"
+  "/root/repo/txn/process/check_cvt.cc" "txn/CMakeFiles/motor.dir/process/check_cvt.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/check_cvt.cc.o.d"
+  "/root/repo/txn/process/check_value.cc" "txn/CMakeFiles/motor.dir/process/check_value.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/check_value.cc.o.d"
+  "/root/repo/txn/process/collect_attr.cc" "txn/CMakeFiles/motor.dir/process/collect_attr.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/collect_attr.cc.o.d"
+  "/root/repo/txn/process/commit.cc" "txn/CMakeFiles/motor.dir/process/commit.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/commit.cc.o.d"
+  "/root/repo/txn/process/framework.cc" "txn/CMakeFiles/motor.dir/process/framework.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/framework.cc.o.d"
+  "/root/repo/txn/process/kv.cc" "txn/CMakeFiles/motor.dir/process/kv.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/kv.cc.o.d"
+  "/root/repo/txn/process/lease.cc" "txn/CMakeFiles/motor.dir/process/lease.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/lease.cc.o.d"
+  "/root/repo/txn/process/overflow.cc" "txn/CMakeFiles/motor.dir/process/overflow.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/overflow.cc.o.d"
+  "/root/repo/txn/process/read_cvt.cc" "txn/CMakeFiles/motor.dir/process/read_cvt.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/read_cvt.cc.o.d"
+  "/root/repo/txn/process/read_value.cc" "txn/CMakeFiles/motor.dir/process/read_value.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/read_value.cc.o.d"
+  "/root/repo/txn/process/recovery.cc" "txn/CMakeFiles/motor.dir/process/recovery.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/recovery.cc.o.d"
+  "/root/repo/txn/process/scan.cc" "txn/CMakeFiles/motor.dir/process/scan.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/scan.cc.o.d"
+  "/root/repo/txn/process/validate.cc" "txn/CMakeFiles/motor.dir/process/validate.cc.o" "gcc" "txn/CMakeFiles/motor.dir/process/validate.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_wall_build/thirdparty/rlib/CMakeFiles/rlib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
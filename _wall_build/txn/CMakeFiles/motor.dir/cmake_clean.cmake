@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/motor.dir/connection/meta_manager.cc.o"
+  "CMakeFiles/motor.dir/connection/meta_manager.cc.o.d"
+  "CMakeFiles/motor.dir/process/check_cvt.cc.o"
+  "CMakeFiles/motor.dir/process/check_cvt.cc.o.d"
+  "CMakeFiles/motor.dir/process/check_value.cc.o"
+  "CMakeFiles/motor.dir/process/check_value.cc.o.d"
+  "CMakeFiles/motor.dir/process/collect_attr.cc.o"
+  "CMakeFiles/motor.dir/process/collect_attr.cc.o.d"
+  "CMakeFiles/motor.dir/process/commit.cc.o"
+  "CMakeFiles/motor.dir/process/commit.cc.o.d"
+  "CMakeFiles/motor.dir/process/framework.cc.o"
+  "CMakeFiles/motor.dir/process/framework.cc.o.d"
+  "CMakeFiles/motor.dir/process/kv.cc.o"
+  "CMakeFiles/motor.dir/process/kv.cc.o.d"
+  "CMakeFiles/motor.dir/process/lease.cc.o"
+  "CMakeFiles/motor.dir/process/lease.cc.o.d"
+  "CMakeFiles/motor.dir/process/overflow.cc.o"
+  "CMakeFiles/motor.dir/process/overflow.cc.o.d"
+  "CMakeFiles/motor.dir/process/read_cvt.cc.o"
+  "CMakeFiles/motor.dir/process/read_cvt.cc.o.d"
+  "CMakeFiles/motor.dir/process/read_value.cc.o"
+  "CMakeFiles/motor.dir/process/read_value.cc.o.d"
+  "CMakeFiles/motor.dir/process/recovery.cc.o"
+  "CMakeFiles/motor.dir/process/recovery.cc.o.d"
+  "CMakeFiles/motor.dir/process/scan.cc.o"
+  "CMakeFiles/motor.dir/process/scan.cc.o.d"
+  "CMakeFiles/motor.dir/process/validate.cc.o"
+  "CMakeFiles/motor.dir/process/validate.cc.o.d"
+  "libmotor.a"
+  "libmotor.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/motor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/micro_db.dir/micro_db.cc.o"
+  "CMakeFiles/micro_db.dir/micro_db.cc.o.d"
+  "libmicro_db.a"
+  "libmicro_db.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/micro_db.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libmicro_db.a"
+)
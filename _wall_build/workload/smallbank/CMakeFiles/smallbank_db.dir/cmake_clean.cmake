@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/smallbank_db.dir/smallbank_db.cc.o"
+  "CMakeFiles/smallbank_db.dir/smallbank_db.cc.o.d"
+  "libsmallbank_db.a"
+  "libsmallbank_db.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/smallbank_db.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
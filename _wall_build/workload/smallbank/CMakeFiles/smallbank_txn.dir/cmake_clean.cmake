@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/smallbank_txn.dir/smallbank_txn.cc.o"
+  "CMakeFiles/smallbank_txn.dir/smallbank_txn.cc.o.d"
+  "libsmallbank_txn.a"
+  "libsmallbank_txn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/smallbank_txn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tatp_db.dir/tatp_db.cc.o"
+  "CMakeFiles/tatp_db.dir/tatp_db.cc.o.d"
+  "libtatp_db.a"
+  "libtatp_db.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tatp_db.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tatp_txn.dir/tatp_txn.cc.o"
+  "CMakeFiles/tatp_txn.dir/tatp_txn.cc.o.d"
+  "libtatp_txn.a"
+  "libtatp_txn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tatp_txn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tpcc_db.dir/tpcc_db.cc.o"
+  "CMakeFiles/tpcc_db.dir/tpcc_db.cc.o.d"
+  "libtpcc_db.a"
+  "libtpcc_db.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tpcc_db.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
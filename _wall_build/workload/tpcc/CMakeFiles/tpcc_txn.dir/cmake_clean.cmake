@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tpcc_txn.dir/tpcc_txn.cc.o"
+  "CMakeFiles/tpcc_txn.dir/tpcc_txn.cc.o.d"
+  "libtpcc_txn.a"
+  "libtpcc_txn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tpcc_txn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -22,6 +22,8 @@ void Handler::ConfigureComputeNode(int argc, char* argv[]) {
     iso_level_value = 1;
   } else if (iso_level == "SR") {
     iso_level_value = 2;
+  } else if (iso_level == "RC") {
+    iso_level_value = 3;
   }
 
   std::string s = "sed -i '9c \"iso_level\": " + std::to_string(iso_level_value) + ",' " + config_file;
@@ -66,6 +68,8 @@ void Handler::ConfigureComputeNodeForMICRO(int argc, char* argv[]) {
     iso_level_value = 1;
   } else if (iso_level == "SR") {
     iso_level_value = 2;
+  } else if (iso_level == "RC") {
+    iso_level_value = 3;
   }
   s = "sed -i '9c \"iso_level\": " + std::to_string(iso_level_value) + ",' " + config_file;
   system(s.c_str());
@@ -11,9 +11,15 @@
 #include <thread>
 
 #include "handler/handler.h"
+#include "handler/ipc.h"
 #include "handler/worker.h"
+#include "micro/micro_txn.h"
 #include "process/oplog.h"
+#include "process/procedure.h"
 #include "process/stat.h"
+#include "smallbank/smallbank_txn.h"
+#include "tatp/tatp_txn.h"
+#include "tpcc/tpcc_txn.h"
 #include "util/json_config.h"
 
 ///////////// For control and statistics ///////////////
@@ -28,12 +34,22 @@ std::vector<double> medianlat_vec;
 std::vector<double> taillat_vec;
 std::vector<uint64_t> total_try_times;
 std::vector<uint64_t> total_commit_times;
+
+// The running benchmark registers its procedures before the threads run
+ProcRegistry proc_registry;
 std::vector<double> delta_usage;
+std::vector<double> delta_reused;
+std::vector<double> delta_grabbed;
 
 // Get the frequency of accessing old versions
 uint64_t access_old_version_cnt[MAX_TNUM_PER_CN];
 uint64_t access_new_version_cnt[MAX_TNUM_PER_CN];
 
+uint64_t no_read_pos_abort_cnt[MAX_TNUM_PER_CN];
+uint64_t no_write_pos_abort_cnt[MAX_TNUM_PER_CN];
+uint64_t vcell_reclaim_cnt[MAX_TNUM_PER_CN];
+uint64_t vcell_in_use_cnt[MAX_TNUM_PER_CN];
+
 EventCount event_counter;
 KeyCount key_counter;
 
@@ -74,18 +90,63 @@ void Handler::GenThreads(std::string bench_name) {
   node_id_t machine_id = (node_id_t)client_conf.get("machine_id").get_int64();
   t_id_t thread_num_per_machine = (t_id_t)client_conf.get("thread_num_per_machine").get_int64();
   const int coro_num = (int)client_conf.get("coroutine_num").get_int64();
+  const int group_commit_size = (int)client_conf.get("group_commit_size").get_int64();
+  const uint64_t gc_watermark_refresh_us = (uint64_t)client_conf.get("gc_watermark_refresh_us").get_int64();
+  const std::string ipc_socket_path = client_conf.get("ipc_socket_path").get_str();
+  const int ipc_response_batch = (int)client_conf.get("ipc_response_batch").get_int64();
   int crash_tnum = 0;
 
+  if (coro_num > MAX_CORO_NUM_PER_THREAD) {
+    RDMA_LOG(FATAL) << "coroutine_num " << coro_num << " exceeds MAX_CORO_NUM_PER_THREAD " << MAX_CORO_NUM_PER_THREAD;
+  }
+
 #if HAVE_COORD_CRASH
   crash_tnum = (int)client_conf.get("crash_tnum").get_int64();
 #endif
+
+  // Each thread has coordinator status slots in memory nodes, and its coordinator ids are in the lock words
+  if ((size_t)machine_num * thread_num_per_machine > MAX_CLIENT_NUM_PER_MN) {
+    RDMA_LOG(FATAL) << "Total thread number " << machine_num * thread_num_per_machine << " exceeds MAX_CLIENT_NUM_PER_MN " << MAX_CLIENT_NUM_PER_MN;
+  }
   assert(machine_id >= 0 && machine_id < machine_num && thread_num_per_machine > 2 * crash_tnum);
 
-  AddrCache* addr_caches = new AddrCache[thread_num_per_machine - crash_tnum];
+  // All threads share one address cache with a fixed number of entries
+  size_t addr_cache_entries = (size_t)client_conf.get("addr_cache_entries").get_int64();
+  AddrCache* addr_cache = new AddrCache(addr_cache_entries);
+  RDMA_LOG(INFO) << "Address cache memory cost: " << (double)addr_cache->TotalSize() / 1024.0 / 1024.0 << " MB";
+
+  // All threads share one copy of the read-only tables
+  TableCache* table_cache = nullptr;
+  if (client_conf.get("enable_table_cache").get_int64()) {
+    table_cache = new TableCache();
+  }
+
+  // All threads share one cache of the read-mostly records
+  VersionCache* version_cache = nullptr;
+  size_t version_cache_entries = (size_t)client_conf.get("version_cache_entries").get_int64();
+  if (version_cache_entries > 0) {
+    version_cache = new VersionCache(version_cache_entries);
+    RDMA_LOG(INFO) << "Version cache memory cost: " << (double)version_cache->TotalSize() / 1024.0 / 1024.0 << " MB";
+  }
+
+  // The delta blocks unlinked by inserts are reused once the running txns cannot read them. With several CNs,
+  // only the GC watermark covers the txns of the others
+  TxnWatermark* txn_watermark = nullptr;
+  if (client_conf.get("enable_delta_reclamation").get_int64()) {
+    if (machine_num > 1 && gc_watermark_refresh_us == 0) {
+      RDMA_LOG(WARNING) << "Delta reclamation is disabled, since " << machine_num << " CNs run without the GC watermark";
+    } else {
+      txn_watermark = new TxnWatermark(thread_num_per_machine, coro_num);
+    }
+  }
 
   for (int i = 0; i < MAX_TNUM_PER_CN; i++) {
     access_old_version_cnt[i] = 0;
     access_new_version_cnt[i] = 0;
+    no_read_pos_abort_cnt[i] = 0;
+    no_write_pos_abort_cnt[i] = 0;
+    vcell_reclaim_cnt[i] = 0;
+    vcell_in_use_cnt[i] = 0;
   }
 
   /*** Coordinator crash model
@@ -132,36 +193,47 @@ void Handler::GenThreads(std::string bench_name) {
   auto thread_arr = new std::thread[thread_num_per_machine];
 
   auto* global_meta_man = new MetaManager();
-  RDMA_LOG(INFO) << "Alloc local memory: " << (size_t)(thread_num_per_machine * PER_THREAD_ALLOC_SIZE) / (1024 * 1024) << " MB. Waiting...";
-  auto* global_rdma_region = new LocalRegionAllocator(global_meta_man, thread_num_per_machine);
-
-  auto* global_delta_region = new RemoteDeltaRegionAllocator(global_meta_man, global_meta_man->remote_nodes);
+  auto* global_rdma_region = new LocalRegionAllocator(global_meta_man, thread_num_per_machine, coro_num);
+  RDMA_LOG(INFO) << "Registered local memory: " << (thread_num_per_machine * global_rdma_region->GetPerThreadSize()) / (1024 * 1024)
+                 << " MB. Per thread: " << global_rdma_region->GetPerThreadSize() / (1024 * 1024)
+                 << " MB (shared: " << PER_THREAD_SHARED_ALLOC_SIZE / (1024 * 1024)
+                 << " MB, per coroutine: " << PER_CORO_ALLOC_SIZE / (1024 * 1024) << " MB)";
 
   auto* global_locked_key_table = new LockedKeyTable[thread_num_per_machine * coro_num];
 
   auto* param_arr = new struct thread_params[thread_num_per_machine];
 
+  // Local processes submit txns to the running threads. The threads prepared for recovery do not serve them
+  IPCServer* ipc_server = nullptr;
+  if (!ipc_socket_path.empty()) {
+    ipc_server = new IPCServer(ipc_socket_path, thread_num_per_machine - crash_tnum);
+  }
+
   TATP* tatp_client = nullptr;
   SmallBank* smallbank_client = nullptr;
   TPCC* tpcc_client = nullptr;
 
   if (bench_name == "tatp") {
     tatp_client = new TATP();
-    total_try_times.resize(TATP_TX_TYPES, 0);
-    total_commit_times.resize(TATP_TX_TYPES, 0);
+    RegisterTATPProcedures(&proc_registry, tatp_client);
   } else if (bench_name == "smallbank") {
     smallbank_client = new SmallBank();
-    total_try_times.resize(SmallBank_TX_TYPES, 0);
-    total_commit_times.resize(SmallBank_TX_TYPES, 0);
+    RegisterSmallBankProcedures(&proc_registry, smallbank_client);
   } else if (bench_name == "tpcc") {
     tpcc_client = new TPCC();
-    total_try_times.resize(TPCC_TX_TYPES, 0);
-    total_commit_times.resize(TPCC_TX_TYPES, 0);
+    RegisterTPCCProcedures(&proc_registry, tpcc_client);
   } else if (bench_name == "micro") {
-    total_try_times.resize(MICRO_TX_TYPES, 0);
-    total_commit_times.resize(MICRO_TX_TYPES, 0);
+    auto micro_config = JsonConfig::load_file("../../../config/micro_config.json");
+    RegisterMicroProcedures(&proc_registry, micro_config.get("micro").get("write_ratio").get_uint64());
   }
 
+  const ProcWorkload* workload = proc_registry.GetWorkload(bench_name);
+  if (!workload) {
+    RDMA_LOG(FATAL) << "No procedures are registered for " << bench_name;
+  }
+  total_try_times.resize(workload->procs.size(), 0);
+  total_commit_times.resize(workload->procs.size(), 0);
+
   RDMA_LOG(INFO) << "Running on isolation level: " << global_meta_man->iso_level;
   RDMA_LOG(INFO) << "Executing...";
 
@@ -169,18 +241,21 @@ void Handler::GenThreads(std::string bench_name) {
     param_arr[i].thread_local_id = i;
     param_arr[i].thread_global_id = (machine_id * thread_num_per_machine) + i;
     param_arr[i].coro_num = coro_num;
+    param_arr[i].group_commit_size = group_commit_size;
+    param_arr[i].gc_watermark_refresh_us = gc_watermark_refresh_us;
+    param_arr[i].ipc_region = ipc_server ? ipc_server->GetRegion() : nullptr;
+    param_arr[i].ipc_response_batch = ipc_response_batch;
     param_arr[i].bench_name = bench_name;
     param_arr[i].global_meta_man = global_meta_man;
-    param_arr[i].addr_cache = &(addr_caches[i]);
+    param_arr[i].addr_cache = addr_cache;
+    param_arr[i].table_cache = table_cache;
+    param_arr[i].version_cache = version_cache;
+    param_arr[i].txn_watermark = txn_watermark;
     param_arr[i].global_rdma_region = global_rdma_region;
-    param_arr[i].global_delta_region = global_delta_region;
     param_arr[i].global_locked_key_table = global_locked_key_table;
     param_arr[i].running_tnum = thread_num_per_machine - crash_tnum;
     thread_arr[i] = std::thread(run_thread,
                                 &param_arr[i],
-                                tatp_client,
-                                smallbank_client,
-                                tpcc_client,
                                 &(tp_probe_vec[i]));
 
     /* Pin thread i to hardware thread i */
@@ -255,18 +330,21 @@ void Handler::GenThreads(std::string bench_name) {
     param_arr[i].thread_local_id = i;
     param_arr[i].thread_global_id = (machine_id * thread_num_per_machine) + i;
     param_arr[i].coro_num = coro_num;
+    param_arr[i].group_commit_size = group_commit_size;
+    param_arr[i].gc_watermark_refresh_us = gc_watermark_refresh_us;
+    param_arr[i].ipc_region = nullptr;
+    param_arr[i].ipc_response_batch = ipc_response_batch;
     param_arr[i].bench_name = bench_name;
     param_arr[i].global_meta_man = global_meta_man;
-    param_arr[i].addr_cache = &(addr_caches[crasher]);
+    param_arr[i].addr_cache = addr_cache;
+    param_arr[i].table_cache = table_cache;
+    param_arr[i].version_cache = version_cache;
+    param_arr[i].txn_watermark = txn_watermark;
     param_arr[i].global_rdma_region = global_rdma_region;
-    param_arr[i].global_delta_region = global_delta_region;
     param_arr[i].global_locked_key_table = global_locked_key_table;
     param_arr[i].running_tnum = crash_tnum;
     thread_arr[i] = std::thread(recovery,
                                 &param_arr[i],
-                                tatp_client,
-                                smallbank_client,
-                                tpcc_client,
                                 try_times[crasher],
                                 &(tp_probe_vec[i]),
                                 crasher);
@@ -299,7 +377,19 @@ void Handler::GenThreads(std::string bench_name) {
 
   RDMA_LOG(INFO) << "DONE";
 
-  delete[] addr_caches;
+  if (ipc_server) {
+    delete ipc_server;
+  }
+  delete addr_cache;
+  if (table_cache) {
+    delete table_cache;
+  }
+  if (version_cache) {
+    delete version_cache;
+  }
+  if (txn_watermark) {
+    delete txn_watermark;
+  }
   delete[] global_locked_key_table;
   delete[] param_arr;
   delete global_rdma_region;
@@ -347,47 +437,15 @@ void Handler::OutputResult(std::string bench_name, std::string system_name) {
   std::string abort_rate_file = "../../../bench_results/" + bench_name + "/abort_rate.txt";
   of_abort_rate.open(abort_rate_file.c_str(), std::ios::app);
   of_abort_rate << system_name << " tx_type try_num commit_num abort_rate" << std::endl;
-  if (bench_name == "tatp") {
-    for (int i = 0; i < TATP_TX_TYPES; i++) {
-      of_abort_rate << TATP_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-
-      // Output the specific txn's abort rate
-      std::string onetxn_abort_rate_file = "../../../bench_results/" + bench_name + "/" + TATP_TX_NAME[i] + "_abort_rate.txt";
-      std::ofstream of_onetxn_abort_rate;
-      of_onetxn_abort_rate.open(onetxn_abort_rate_file.c_str(), std::ios::app);
-      of_onetxn_abort_rate << system_name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
-
-  } else if (bench_name == "smallbank") {
-    for (int i = 0; i < SmallBank_TX_TYPES; i++) {
-      of_abort_rate << SmallBank_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-
-      // Output the specific txn's abort rate
-      std::string onetxn_abort_rate_file = "../../../bench_results/" + bench_name + "/" + SmallBank_TX_NAME[i] + "_abort_rate.txt";
-      std::ofstream of_onetxn_abort_rate;
-      of_onetxn_abort_rate.open(onetxn_abort_rate_file.c_str(), std::ios::app);
-      of_onetxn_abort_rate << system_name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
-  } else if (bench_name == "tpcc") {
-    for (int i = 0; i < TPCC_TX_TYPES; i++) {
-      of_abort_rate << TPCC_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-
-      // Output the specific txn's abort rate
-      std::string onetxn_abort_rate_file = "../../../bench_results/" + bench_name + "/" + TPCC_TX_NAME[i] + "_abort_rate.txt";
-      std::ofstream of_onetxn_abort_rate;
-      of_onetxn_abort_rate.open(onetxn_abort_rate_file.c_str(), std::ios::app);
-      of_onetxn_abort_rate << system_name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
-  } else if (bench_name == "micro") {
-    for (int i = 0; i < MICRO_TX_TYPES; i++) {
-      of_abort_rate << MICRO_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-
-      // Output the specific txn's abort rate
-      std::string onetxn_abort_rate_file = "../../../bench_results/" + bench_name + "/" + MICRO_TX_NAME[i] + "_abort_rate.txt";
-      std::ofstream of_onetxn_abort_rate;
-      of_onetxn_abort_rate.open(onetxn_abort_rate_file.c_str(), std::ios::app);
-      of_onetxn_abort_rate << system_name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
+  const std::vector<Procedure>& procs = proc_registry.GetWorkload(bench_name)->procs;
+  for (size_t i = 0; i < procs.size(); i++) {
+    of_abort_rate << procs[i].name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
+
+    // Output the specific txn's abort rate
+    std::string onetxn_abort_rate_file = "../../../bench_results/" + bench_name + "/" + procs[i].name + "_abort_rate.txt";
+    std::ofstream of_onetxn_abort_rate;
+    of_onetxn_abort_rate.open(onetxn_abort_rate_file.c_str(), std::ios::app);
+    of_onetxn_abort_rate << system_name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
   }
 
   of_abort_rate << std::endl;
@@ -396,10 +454,31 @@ void Handler::OutputResult(std::string bench_name, std::string system_name) {
   std::cout << system_name << " " << total_attemp_tp / 1000 << " " << total_tp / 1000 << " " << avg_median << " " << avg_tail << std::endl;
 
   double total_delta_usage_MB = 0;
+  double total_delta_reused_MB = 0;
+  double total_delta_grabbed_MB = 0;
   for (int i = 0; i < delta_usage.size(); i++) {
     total_delta_usage_MB += delta_usage[i];
+    total_delta_reused_MB += delta_reused[i];
+    total_delta_grabbed_MB += delta_grabbed[i];
+  }
+
+  RDMA_LOG(INFO) << "Delta space grabbed from the pools: " << total_delta_grabbed_MB << " MB, consumed: " << total_delta_usage_MB
+                 << " MB, reused from the reclaimed blocks: " << total_delta_reused_MB << " MB";
+
+  uint64_t total_no_read_pos = 0;
+  uint64_t total_no_write_pos = 0;
+  uint64_t total_vcell_reclaim = 0;
+  uint64_t total_vcell_in_use = 0;
+  for (int i = 0; i < MAX_TNUM_PER_CN; i++) {
+    total_no_read_pos += no_read_pos_abort_cnt[i];
+    total_no_write_pos += no_write_pos_abort_cnt[i];
+    total_vcell_reclaim += vcell_reclaim_cnt[i];
+    total_vcell_in_use += vcell_in_use_cnt[i];
   }
 
+  RDMA_LOG(INFO) << "Aborts due to no readable version: " << total_no_read_pos << ", no writable vcell: " << total_no_write_pos
+                 << ". Oldest vcells reclaimed below the GC watermark: " << total_vcell_reclaim << ", kept for running readers: " << total_vcell_in_use;
+
   // std::cout << "TOTAL delta: " << total_delta_usage_MB << " MB"
   //           << ". AVG delta/thread: " << (double)total_delta_usage_MB / thread_num << " MB" << std::endl;
 
@@ -415,26 +494,9 @@ void Handler::OutputResult(std::string bench_name, std::string system_name) {
 
   std::cout << std::endl;
   std::cout << "abort rate:" << std::endl;
-  if (bench_name == "tatp") {
-    for (int i = 0; i < TATP_TX_TYPES; i++) {
-      of_event_count << TATP_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-      std::cout << TATP_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
-  } else if (bench_name == "smallbank") {
-    for (int i = 0; i < SmallBank_TX_TYPES; i++) {
-      of_event_count << SmallBank_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-      std::cout << SmallBank_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
-  } else if (bench_name == "tpcc") {
-    for (int i = 0; i < TPCC_TX_TYPES; i++) {
-      of_event_count << TPCC_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-      std::cout << TPCC_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
-  } else if (bench_name == "micro") {
-    for (int i = 0; i < MICRO_TX_TYPES; i++) {
-      of_event_count << MICRO_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-      std::cout << MICRO_TX_NAME[i] << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
-    }
+  for (size_t i = 0; i < procs.size(); i++) {
+    of_event_count << procs[i].name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
+    std::cout << procs[i].name << " " << total_try_times[i] << " " << total_commit_times[i] << " " << (double)(total_try_times[i] - total_commit_times[i]) / (double)total_try_times[i] << std::endl;
   }
 
   event_counter.Output(of_event_count);
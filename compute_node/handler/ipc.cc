@@ -0,0 +1,270 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include "handler/ipc.h"
+
+#include <poll.h>
+
+#include <algorithm>
+
+#include "rlib/logging.hpp"
+
+using namespace rdmaio;
+
+IPCServer::IPCServer(const std::string& path, uint32_t thread_num)
+    : socket_path(path), listen_fd(-1), running(false) {
+  for (uint32_t c = 0; c < IPC_MAX_CLIENTS; c++) {
+    conn_fds[c] = -1;
+  }
+  shm_name = "/motor_ipc_" + std::to_string(getpid());
+  region_size = IPCRegionSize(thread_num);
+  region = MapIPCRegion(shm_name.c_str(), region_size, true);
+  if (!region) {
+    RDMA_LOG(FATAL) << "Fail to create the IPC region " << shm_name << ", size: " << region_size;
+  }
+
+  // The new region is zeroed, i.e., all the rings are empty
+  IPCRegionHeader* header = (IPCRegionHeader*)region;
+  header->magic = IPC_MAGIC;
+  header->thread_num = thread_num;
+  header->client_num.store(0, std::memory_order_release);
+
+  listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+  unlink(socket_path.c_str());
+  if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, IPC_MAX_CLIENTS) != 0) {
+    RDMA_LOG(FATAL) << "Fail to listen on the IPC socket " << socket_path;
+  }
+
+  running = true;
+  listener = std::thread(&IPCServer::Listen, this);
+  RDMA_LOG(INFO) << "IPC front-end listens on " << socket_path << ", region: " << shm_name << " ("
+                 << (double)region_size / 1024.0 / 1024.0 << " MB)";
+}
+
+IPCServer::~IPCServer() {
+  running = false;
+  if (listener.joinable()) {
+    listener.join();
+  }
+  close(listen_fd);
+  for (uint32_t c = 0; c < IPC_MAX_CLIENTS; c++) {
+    if (conn_fds[c] >= 0) close(conn_fds[c]);
+  }
+  unlink(socket_path.c_str());
+  munmap(region, region_size);
+  shm_unlink(shm_name.c_str());
+}
+
+void IPCServer::Listen() {
+  IPCRegionHeader* header = (IPCRegionHeader*)region;
+  struct pollfd pfd;
+  pfd.fd = listen_fd;
+  pfd.events = POLLIN;
+
+  while (running) {
+    // Wake up periodically to see whether the CN stops
+    int ready = poll(&pfd, 1, 100);
+    ExpireLeases();
+    CheckConnections();
+    if (ready <= 0) {
+      continue;
+    }
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+
+    uint32_t client_id = AllocSlot();
+    IPCHello hello;
+    memset(&hello, 0, sizeof(hello));
+    hello.magic = IPC_MAGIC;
+    hello.client_id = client_id;
+    hello.thread_num = header->thread_num;
+    hello.ring_depth = IPC_RING_DEPTH;
+    strncpy(hello.shm_name, shm_name.c_str(), sizeof(hello.shm_name) - 1);
+
+    if (client_id == IPC_MAX_CLIENTS) {
+      RDMA_LOG(WARNING) << "IPC front-end rejects a client: " << IPC_MAX_CLIENTS << " clients are attached or being drained";
+    }
+
+    if (write(fd, &hello, sizeof(hello)) != sizeof(hello)) {
+      RDMA_LOG(WARNING) << "IPC front-end fails to reply client " << client_id;
+    }
+    if (client_id == IPC_MAX_CLIENTS) {
+      close(fd);
+    } else {
+      // Kept open until the client leaves. Its slot is not reused before then
+      conn_fds[client_id] = fd;
+    }
+  }
+}
+
+void IPCServer::CheckConnections() {
+  IPCRegionHeader* header = (IPCRegionHeader*)region;
+  struct pollfd pfds[IPC_MAX_CLIENTS];
+  uint32_t clients[IPC_MAX_CLIENTS];
+  nfds_t n = 0;
+  for (uint32_t c = 0; c < IPC_MAX_CLIENTS; c++) {
+    if (conn_fds[c] < 0) continue;
+    pfds[n].fd = conn_fds[c];
+    pfds[n].events = POLLIN;
+    pfds[n].revents = 0;
+    clients[n++] = c;
+  }
+  if (n == 0 || poll(pfds, n, 0) <= 0) {
+    return;
+  }
+
+  for (nfds_t i = 0; i < n; i++) {
+    if (!pfds[i].revents) continue;
+    // A client sends nothing on the connection, so a readable connection is closed by the client
+    char byte;
+    if ((pfds[i].revents & POLLIN) && read(pfds[i].fd, &byte, 1) > 0) continue;
+    uint32_t c = clients[i];
+    close(conn_fds[c]);
+    conn_fds[c] = -1;
+    uint32_t expected = kIPCAttached;
+    if (header->clients[c].state.compare_exchange_strong(expected, kIPCDetached)) {
+      RDMA_LOG(WARNING) << "IPC client " << c << " is detached: its connection is closed";
+    }
+  }
+}
+
+void IPCServer::ExpireLeases() {
+  IPCRegionHeader* header = (IPCRegionHeader*)region;
+  uint32_t client_num = header->client_num.load(std::memory_order_relaxed);
+  uint64_t now_ms = IPCNowMs();
+  for (uint32_t c = 0; c < client_num; c++) {
+    IPCClientSlot& slot = header->clients[c];
+    if (slot.state.load(std::memory_order_acquire) == kIPCAttached &&
+        now_ms > slot.lease_ms.load(std::memory_order_acquire) + IPC_LEASE_MS) {
+      uint32_t expected = kIPCAttached;
+      if (slot.state.compare_exchange_strong(expected, kIPCDetached)) {
+        RDMA_LOG(WARNING) << "IPC client " << c << " is detached: its lease expires";
+      }
+    }
+  }
+}
+
+uint32_t IPCServer::AllocSlot() {
+  IPCRegionHeader* header = (IPCRegionHeader*)region;
+  uint32_t client_num = header->client_num.load(std::memory_order_relaxed);
+
+  for (uint32_t c = 0; c < client_num; c++) {
+    IPCClientSlot& slot = header->clients[c];
+    if (slot.state.load(std::memory_order_acquire) != kIPCDetached || conn_fds[c] >= 0) {
+      // A detached client may only be slow, and still produce into its rings until it leaves
+      continue;
+    }
+
+    // The old client sends no more requests. Its rings are drained once the workers finish all of them
+    bool drained = true;
+    for (uint32_t t = 0; t < header->thread_num && drained; t++) {
+      IPCChannel* ch = GetIPCChannel(region, c, t);
+      drained = ch->done.pos.load(std::memory_order_acquire) == ch->req.tail.pos.load(std::memory_order_acquire);
+    }
+    if (!drained) {
+      continue;
+    }
+
+    // The ring positions keep growing. The responses that the old client has not taken are discarded
+    for (uint32_t t = 0; t < header->thread_num; t++) {
+      IPCRing<IPCResponse>& resp = GetIPCChannel(region, c, t)->resp;
+      resp.head.pos.store(resp.tail.pos.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    slot.lease_ms.store(IPCNowMs(), std::memory_order_release);
+    slot.state.store(kIPCAttached, std::memory_order_release);
+    return c;
+  }
+
+  if (client_num == IPC_MAX_CLIENTS) {
+    return IPC_MAX_CLIENTS;
+  }
+
+  // Workers start to poll the rings of this client
+  header->clients[client_num].lease_ms.store(IPCNowMs(), std::memory_order_release);
+  header->clients[client_num].state.store(kIPCAttached, std::memory_order_release);
+  header->client_num.store(client_num + 1, std::memory_order_release);
+  return client_num;
+}
+
+IPCWorker::IPCWorker(char* ipc_region, uint32_t thread_local_id, size_t response_batch)
+    : region(ipc_region),
+      thread_id(thread_local_id),
+      batch(response_batch > 0 ? response_batch : 1),
+      next_client(0),
+      idle_polls(0),
+      backoff_us(1),
+      staged_tails(IPC_MAX_CLIENTS, 0),
+      staged_num(0) {}
+
+bool IPCWorker::Pop(IPCRequest& req, uint32_t& client_id) {
+  IPCRegionHeader* header = (IPCRegionHeader*)region;
+  uint32_t client_num = header->client_num.load(std::memory_order_acquire);
+  // The clients take turns, so that a busy client does not starve others
+  for (uint32_t i = 0; i < client_num; i++) {
+    uint32_t c = (next_client + i) % client_num;
+    IPCChannel* ch = GetIPCChannel(region, c, thread_id);
+    while (ch->req.Pop(req)) {
+      // The state is checked after the pop. A request of the next client of this slot is sent after it is attached
+      if (header->clients[c].state.load(std::memory_order_acquire) == kIPCAttached) {
+        client_id = c;
+        next_client = c + 1;
+        idle_polls = 0;
+        backoff_us = 1;
+        return true;
+      }
+      // No one waits for the requests of a detached client
+      ch->done.pos.store(ch->done.pos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+  }
+  return false;
+}
+
+void IPCWorker::Respond(uint32_t client_id, const IPCResponse& resp) {
+  IPCChannel* ch = GetIPCChannel(region, client_id, thread_id);
+  IPCRing<IPCResponse>& ring = ch->resp;
+  bool first_staged = (staged_tails[client_id] == ring.tail.pos.load(std::memory_order_relaxed));
+  if (!ring.Stage(staged_tails[client_id], resp)) {
+    // The client sends more than IPC_RING_DEPTH outstanding requests, or it stops taking the responses.
+    // The response is dropped, and the client is detached instead of blocking this thread
+    ch->done.pos.store(ch->done.pos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    uint32_t expected = kIPCAttached;
+    if (((IPCRegionHeader*)region)->clients[client_id].state.compare_exchange_strong(expected, kIPCDetached)) {
+      RDMA_LOG(WARNING) << "Thread " << thread_id << " detaches IPC client " << client_id << ": its response ring is full. A client keeps at most "
+                        << IPC_RING_DEPTH << " outstanding requests per thread";
+    }
+    return;
+  }
+  if (first_staged) {
+    staged_clients.push_back(client_id);
+  }
+  if (++staged_num >= batch) {
+    Flush();
+  }
+}
+
+void IPCWorker::Flush() {
+  for (auto c : staged_clients) {
+    IPCChannel* ch = GetIPCChannel(region, c, thread_id);
+    uint64_t published = staged_tails[c] - ch->resp.tail.pos.load(std::memory_order_relaxed);
+    ch->resp.Publish(staged_tails[c]);
+    ch->done.pos.store(ch->done.pos.load(std::memory_order_relaxed) + published, std::memory_order_release);
+  }
+  staged_clients.clear();
+  staged_num = 0;
+}
+
+void IPCWorker::Idle(int idle_coro_num, bool rdma_inflight) {
+  if (++idle_polls < idle_coro_num || rdma_inflight) {
+    // Others may still find a request in this round, or wait for their RDMA completions
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::microseconds(backoff_us));
+  backoff_us = std::min(backoff_us * 2, IPC_MAX_BACKOFF_US);
+  idle_polls = 0;
+}
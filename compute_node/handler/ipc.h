@@ -0,0 +1,300 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Local processes submit stored-procedure invocations to a running CN through shared memory.
+// A client first connects to the CN's Unix socket, which assigns it a client id and tells the
+// name of the shared memory. Each <client, worker thread> pair has a request ring and a response ring,
+// both with one producer and one consumer. A client spreads its requests over the worker threads,
+// and keeps at most IPC_RING_DEPTH outstanding requests per thread, so that a response ring is never full.
+// A client that breaks this, or stops taking its responses, is detached when its response ring is full.
+// A client renews its lease in the region, and detaches when it leaves. A client keeps its socket connection
+// open while it is attached. The slot of a detached or expired client is given to a new client only after
+// its connection is closed, i.e., the old client has unmapped the rings or exited, and the workers have finished
+// all its requests. A slow client whose lease expires keeps its slot until then, so that each ring never has
+// two producers
+
+const uint32_t IPC_MAGIC = 0x4d4f5452;
+
+const size_t IPC_RING_DEPTH = 256;  // Power of 2
+
+const uint32_t IPC_MAX_CLIENTS = 16;
+
+// A client that does not renew its lease for this long is detached
+const uint64_t IPC_LEASE_MS = 1000;
+
+const size_t IPC_MAX_ARG_SIZE = 48;
+
+// An idle worker thread sleeps for at most this long between polls of the request rings
+const uint64_t IPC_MAX_BACKOFF_US = 64;
+
+// The procedure id is a txn type of the running benchmark, e.g., TATPTxType. Its arguments are encoded in args
+// as the procedure's adapter decodes them (see procedure.h), e.g., the itemkey_t of a MICRO txn, or the uint64_t
+// seed of a TATP txn. Without arguments, the CN draws the inputs
+struct IPCRequest {
+  uint64_t req_id;
+  uint64_t client_ts;  // Echoed back, e.g., the send time
+  uint32_t proc_id;
+  uint32_t arg_size;
+  char args[IPC_MAX_ARG_SIZE];
+};
+
+enum IPCStatus : uint32_t {
+  kIPCCommitted = 0,
+  kIPCAborted,
+  kIPCBadProc,  // No such procedure in the running benchmark
+  kIPCBadArgs,  // arg_size exceeds IPC_MAX_ARG_SIZE
+};
+
+struct IPCResponse {
+  uint64_t req_id;
+  uint64_t client_ts;
+  uint32_t proc_id;
+  uint32_t status;
+  uint64_t padding;
+};
+
+// Ring positions grow monotonically. Padded so that the producer and the consumer do not share a cache line
+struct IPCPos {
+  std::atomic<uint64_t> pos;
+  char padding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+template <typename T>
+struct IPCRing {
+  IPCPos head;  // Next to consume. Written by the consumer
+  IPCPos tail;  // Next to produce. Written by the producer
+  T entries[IPC_RING_DEPTH];
+
+  // Consumer
+  bool Pop(T& entry) {
+    uint64_t h = head.pos.load(std::memory_order_relaxed);
+    if (h == tail.pos.load(std::memory_order_acquire)) {
+      return false;
+    }
+    entry = entries[h & (IPC_RING_DEPTH - 1)];
+    head.pos.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer. The entries at [tail, staged_tail) are invisible until published
+  bool Stage(uint64_t& staged_tail, const T& entry) {
+    if (staged_tail - head.pos.load(std::memory_order_acquire) >= IPC_RING_DEPTH) {
+      return false;
+    }
+    entries[staged_tail & (IPC_RING_DEPTH - 1)] = entry;
+    staged_tail++;
+    return true;
+  }
+
+  void Publish(uint64_t staged_tail) {
+    tail.pos.store(staged_tail, std::memory_order_release);
+  }
+
+  bool Push(const T& entry) {
+    uint64_t t = tail.pos.load(std::memory_order_relaxed);
+    if (!Stage(t, entry)) {
+      return false;
+    }
+    Publish(t);
+    return true;
+  }
+};
+
+struct IPCChannel {
+  IPCRing<IPCRequest> req;
+  IPCRing<IPCResponse> resp;
+  IPCPos done;  // Requests finished by the worker, i.e., their responses are published or dropped
+};
+
+enum IPCClientState : uint32_t {
+  kIPCUnused = 0,
+  kIPCAttached,
+  kIPCDetached,  // The workers drop its requests. The slot is reused once they are all finished and the connection is closed
+};
+
+struct IPCClientSlot {
+  std::atomic<uint32_t> state;
+  std::atomic<uint64_t> lease_ms;  // Renewed by the client
+  char padding[64 - 2 * sizeof(uint64_t)];
+};
+
+struct IPCRegionHeader {
+  uint32_t magic;
+  uint32_t thread_num;
+  std::atomic<uint32_t> client_num;  // Slots [0, client_num) have been used, and are polled by the workers
+  char padding[64 - 3 * sizeof(uint32_t)];
+  IPCClientSlot clients[IPC_MAX_CLIENTS];
+};
+
+// Replied by the CN to a connecting client
+struct IPCHello {
+  uint32_t magic;
+  uint32_t client_id;  // IPC_MAX_CLIENTS if the CN takes no more clients
+  uint32_t thread_num;
+  uint32_t ring_depth;
+  char shm_name[64];
+};
+
+inline size_t IPCRegionSize(uint32_t thread_num) {
+  return sizeof(IPCRegionHeader) + (size_t)IPC_MAX_CLIENTS * thread_num * sizeof(IPCChannel);
+}
+
+inline IPCChannel* GetIPCChannel(char* region, uint32_t client_id, uint32_t thread_id) {
+  uint32_t thread_num = ((IPCRegionHeader*)region)->thread_num;
+  return (IPCChannel*)(region + sizeof(IPCRegionHeader)) + (size_t)client_id * thread_num + thread_id;
+}
+
+// Map the region of a CN. Used by both the CN and the clients
+inline char* MapIPCRegion(const char* shm_name, size_t size, bool create) {
+  int fd = shm_open(shm_name, create ? (O_CREAT | O_RDWR | O_TRUNC) : O_RDWR, 0666);
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (create && ftruncate(fd, (off_t)size) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  return (p == MAP_FAILED) ? nullptr : (char*)p;
+}
+
+// The clock of the leases, which is shared by the processes of a machine
+inline uint64_t IPCNowMs() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+// Client side: called more often than IPC_LEASE_MS, otherwise the CN detaches me
+inline void RenewIPCLease(char* region, uint32_t client_id) {
+  ((IPCRegionHeader*)region)->clients[client_id].lease_ms.store(IPCNowMs(), std::memory_order_release);
+}
+
+// Client side: I send no more requests, and my outstanding responses may be dropped. I touch my rings no more
+// after this, since closing the connection lets the CN give my slot to the next client
+inline void DetachIPC(char* region, uint32_t client_id, int conn_fd) {
+  ((IPCRegionHeader*)region)->clients[client_id].state.store(kIPCDetached, std::memory_order_release);
+  close(conn_fd);
+}
+
+// Client side: get a client id from the CN. Return the connection, which stays open while I am attached,
+// or -1 if the CN is unreachable
+inline int ConnectIPC(const std::string& socket_path, IPCHello& hello) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+  if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  size_t got = 0;
+  while (got < sizeof(IPCHello)) {
+    ssize_t n = read(fd, (char*)&hello + got, sizeof(IPCHello) - got);
+    if (n <= 0) break;
+    got += (size_t)n;
+  }
+  if (got != sizeof(IPCHello) || hello.magic != IPC_MAGIC) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// CN side: creates the region, and attaches the clients that connect to the socket
+class IPCServer {
+ public:
+  IPCServer(const std::string& path, uint32_t thread_num);
+
+  ~IPCServer();
+
+  char* GetRegion() const {
+    return region;
+  }
+
+ private:
+  void Listen();
+
+  // Detach the clients whose leases expire
+  void ExpireLeases();
+
+  // Detach the clients whose connections are closed, e.g., they have exited
+  void CheckConnections();
+
+  // A free slot for a new client. IPC_MAX_CLIENTS if none
+  uint32_t AllocSlot();
+
+  std::string socket_path;
+
+  std::string shm_name;
+
+  char* region;
+
+  size_t region_size;
+
+  int listen_fd;
+
+  int conn_fds[IPC_MAX_CLIENTS];  // The connection of the client in each slot. -1 if it is closed
+
+  std::atomic<bool> running;
+
+  std::thread listener;
+};
+
+// A worker thread's view of the region. The coroutines of the thread take requests from all the clients in turn,
+// and stage the responses, which are published in batches
+class IPCWorker {
+ public:
+  IPCWorker(char* ipc_region, uint32_t thread_local_id, size_t response_batch);
+
+  bool Pop(IPCRequest& req, uint32_t& client_id);
+
+  // Dropped if the client's response ring is full, and the client is detached
+  void Respond(uint32_t client_id, const IPCResponse& resp);
+
+  // Publish the staged responses
+  void Flush();
+
+  // Called by a coroutine that finds no request. Once every idle coroutine in a row finds none and no RDMA
+  // request of the thread is in flight, the thread sleeps with exponential back-off instead of spinning
+  void Idle(int idle_coro_num, bool rdma_inflight);
+
+ private:
+  char* region;
+
+  uint32_t thread_id;
+
+  size_t batch;
+
+  uint32_t next_client;  // Where the next Pop starts
+
+  int idle_polls;  // Consecutive Pops that find no request
+
+  uint64_t backoff_us;
+
+  std::vector<uint64_t> staged_tails;  // Per client
+
+  std::vector<uint32_t> staged_clients;  // The clients with staged responses
+
+  size_t staged_num;
+};
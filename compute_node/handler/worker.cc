@@ -11,7 +11,9 @@
 
 #include "allocator/buffer_allocator.h"
 #include "connection/qp_manager.h"
+#include "handler/ipc.h"
 #include "micro/micro_txn.h"
+#include "process/procedure.h"
 #include "process/txn.h"
 #include "smallbank/smallbank_txn.h"
 #include "tatp/tatp_txn.h"
@@ -34,10 +36,14 @@ extern std::vector<double> tp_vec;
 extern std::vector<double> medianlat_vec;
 extern std::vector<double> taillat_vec;
 extern std::vector<double> delta_usage;
+extern std::vector<double> delta_reused;
+extern std::vector<double> delta_grabbed;
 
 extern std::vector<uint64_t> total_try_times;
 extern std::vector<uint64_t> total_commit_times;
 
+extern ProcRegistry proc_registry;
+
 extern std::atomic<bool> to_crash[MAX_TNUM_PER_CN];
 extern std::atomic<bool> report_crash[MAX_TNUM_PER_CN];
 extern uint64_t try_times[MAX_TNUM_PER_CN];
@@ -53,10 +59,6 @@ __thread FastRandom* random_generator = nullptr;  // Per coroutine random genera
 __thread t_id_t thread_gid;
 __thread t_id_t thread_local_id;
 
-__thread TATP* tatp_client = nullptr;
-__thread SmallBank* smallbank_client = nullptr;
-__thread TPCC* tpcc_client = nullptr;
-
 __thread MetaManager* meta_man;
 __thread QPManager* qp_man;
 
@@ -64,13 +66,21 @@ __thread LocalBufferAllocator* rdma_buffer_allocator;
 __thread RemoteDeltaOffsetAllocator* delta_offset_allocator;
 __thread LockedKeyTable* locked_key_table;
 __thread AddrCache* addr_cache;
+__thread TableCache* table_cache;
+__thread VersionCache* version_cache;
+__thread TxnWatermark* txn_watermark;
 
-__thread TATPTxType* tatp_workgen_arr;
-__thread SmallBankTxType* smallbank_workgen_arr;
-__thread TPCCTxType* tpcc_workgen_arr;
+__thread const ProcWorkload* workload;  // The registered procedures of the running benchmark
+__thread proc_id_t* workgen_arr;
+__thread bool stop_on_committed;  // Count the committed txns rather than the attempted ones towards ATTEMPTED_NUM
+__thread bool check_crash;        // Check the coordinator crash and the throughput probe after each txn, as TPCC did
 
 __thread coro_id_t coro_num;
 __thread CoroutineScheduler* coro_sched;  // Each transaction thread has a coroutine scheduler
+__thread CommitStage* commit_stage;      // Group commit of the coroutines. nullptr if disabled
+__thread GCWatermark* gc_watermark;      // View of the cluster-wide GC watermark. nullptr if disabled
+__thread LeaseClock* lease_clock;        // View of the lease epoch. nullptr without LEASE_LOCK
+__thread IPCWorker* ipc_worker;          // Request rings of this thread. nullptr if disabled
 
 // Performance measurement (thread granularity)
 __thread struct timespec msr_start, msr_end, last_end;
@@ -97,10 +107,17 @@ __thread uint64_t* thread_local_commit_times;
 void Poll(coro_yield_t& yield) {
   while (true) {
     coro_sched->PollCompletion(thread_gid);
+    if (ipc_worker) {
+      // The responses of this round are published together
+      ipc_worker->Flush();
+    }
     Coroutine* next = coro_sched->coro_head->next_coro;
     if (next->coro_id != POLL_ROUTINE_ID) {
       // RDMA_LOG(DBG) << "Coro 0 yields to coro " << next->coro_id;
       coro_sched->RunCoroutine(yield, next);
+    } else if (commit_stage && !commit_stage->IsEmpty()) {
+      // All coroutines wait. Post the staged commits of this round
+      commit_stage->Flush();
     }
   }
 }
@@ -131,99 +148,25 @@ void RecordTpLat(double msr_sec) {
   mux.unlock();
 }
 
-// Run actual transactions
-void RunTATP(coro_yield_t& yield, coro_id_t coro_id) {
-  // Each coroutine has a txn: Each coroutine is a coordinator
-  TXN* txn = new TXN(meta_man,
-                     qp_man,
-                     thread_gid,
-                     coro_id,
-                     coro_sched,
-                     rdma_buffer_allocator,
-                     delta_offset_allocator,
-                     locked_key_table,
-                     addr_cache);
-  struct timespec tx_start_time, tx_end_time;
-  bool tx_committed = false;
-
-  // Running transactions
-  clock_gettime(CLOCK_REALTIME, &msr_start);
+// Run a procedure with its retry policy. The latency counts from the last try
+bool RunProcedure(const Procedure& proc, coro_yield_t& yield, TXN* txn, ProcArgs& args, struct timespec& tx_start_time) {
+  int retry_times = 0;
   while (true) {
-    // Guarantee that each coroutine has a different seed
-    TATPTxType tx_type = tatp_workgen_arr[FastRand(&seed) % 100];
-    uint64_t iter = ++tx_id_generator;  // Global atomic transaction id
-    stat_attempted_tx_total++;
+    thread_local_try_times[proc.id]++;
     clock_gettime(CLOCK_REALTIME, &tx_start_time);
-    switch (tx_type) {
-      case TATPTxType::kGetSubsciberData: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxGetSubsciberData(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case TATPTxType::kGetNewDestination: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxGetNewDestination(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case TATPTxType::kGetAccessData: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxGetAccessData(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case TATPTxType::kUpdateSubscriberData: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxUpdateSubscriberData(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case TATPTxType::kUpdateLocation: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxUpdateLocation(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case TATPTxType::kInsertCallForwarding: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxInsertCallForwarding(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case TATPTxType::kDeleteCallForwarding: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxDeleteCallForwarding(tatp_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      default:
-        printf("Unexpected transaction type %d\n", static_cast<int>(tx_type));
-        abort();
+    if (proc.handler(txn, args, yield)) {
+      thread_local_commit_times[proc.id]++;
+      return true;
     }
-
-    /********************************** Stat begin *****************************************/
-    // Stat after one transaction finishes
-    if (tx_committed) {
-      clock_gettime(CLOCK_REALTIME, &tx_end_time);
-      double tx_usec = (tx_end_time.tv_sec - tx_start_time.tv_sec) * 1000000 + (double)(tx_end_time.tv_nsec - tx_start_time.tv_nsec) / 1000;
-      timer[stat_committed_tx_total++] = tx_usec;
+    if (proc.max_retry != RETRY_UNTIL_COMMIT && retry_times++ >= proc.max_retry) {
+      return false;
     }
-    if (stat_attempted_tx_total >= ATTEMPTED_NUM) {
-      // A coroutine calculate the total execution time and exits
-      clock_gettime(CLOCK_REALTIME, &msr_end);
-      // double msr_usec = (msr_end.tv_sec - msr_start.tv_sec) * 1000000 + (double) (msr_end.tv_nsec - msr_start.tv_nsec) / 1000;
-      double msr_sec = (msr_end.tv_sec - msr_start.tv_sec) + (double)(msr_end.tv_nsec - msr_start.tv_nsec) / 1000000000;
-      RecordTpLat(msr_sec);
-      break;
-    }
-    /********************************** Stat end *****************************************/
+    args.tx_id = ++tx_id_generator;
   }
-
-  delete txn;
 }
 
-void RunSmallBank(coro_yield_t& yield, coro_id_t coro_id) {
+// Run actual transactions. The procedures are picked from the mix of the registered workload
+void RunWorkload(coro_yield_t& yield, coro_id_t coro_id, int finished_num) {
   // Each coroutine has a txn: Each coroutine is a coordinator
   TXN* txn = new TXN(meta_man,
                      qp_man,
@@ -233,142 +176,41 @@ void RunSmallBank(coro_yield_t& yield, coro_id_t coro_id) {
                      rdma_buffer_allocator,
                      delta_offset_allocator,
                      locked_key_table,
-                     addr_cache);
+                     addr_cache,
+                     table_cache,
+                     version_cache,
+                     commit_stage,
+                     txn_watermark,
+                     gc_watermark,
+                     lease_clock);
   struct timespec tx_start_time, tx_end_time;
   bool tx_committed = false;
 
-  // Running transactions
-  clock_gettime(CLOCK_REALTIME, &msr_start);
-  while (true) {
-    SmallBankTxType tx_type = smallbank_workgen_arr[FastRand(&seed) % 100];
-    uint64_t iter = ++tx_id_generator;  // Global atomic transaction id
-    stat_attempted_tx_total++;
-    clock_gettime(CLOCK_REALTIME, &tx_start_time);
-    switch (tx_type) {
-      case SmallBankTxType::kAmalgamate: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxAmalgamate(smallbank_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case SmallBankTxType::kBalance: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxBalance(smallbank_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case SmallBankTxType::kDepositChecking: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxDepositChecking(smallbank_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case SmallBankTxType::kSendPayment: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxSendPayment(smallbank_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case SmallBankTxType::kTransactSaving: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxTransactSaving(smallbank_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      case SmallBankTxType::kWriteCheck: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxWriteCheck(smallbank_client, &seed, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-        break;
-      }
-      default:
-        printf("Unexpected transaction type %d\n", static_cast<int>(tx_type));
-        abort();
-    }
-
-    /********************************** Stat begin *****************************************/
-    // Stat after one transaction finishes
-    if (tx_committed) {
-      clock_gettime(CLOCK_REALTIME, &tx_end_time);
-      double tx_usec = (tx_end_time.tv_sec - tx_start_time.tv_sec) * 1000000 + (double)(tx_end_time.tv_nsec - tx_start_time.tv_nsec) / 1000;
-      timer[stat_committed_tx_total++] = tx_usec;
-    }
-    if (stat_attempted_tx_total >= ATTEMPTED_NUM) {
-      // A coroutine calculate the total execution time and exits
-      clock_gettime(CLOCK_REALTIME, &msr_end);
-      // double msr_usec = (msr_end.tv_sec - msr_start.tv_sec) * 1000000 + (double) (msr_end.tv_nsec - msr_start.tv_nsec) / 1000;
-      double msr_sec = (msr_end.tv_sec - msr_start.tv_sec) + (double)(msr_end.tv_nsec - msr_start.tv_nsec) / 1000000000;
-      RecordTpLat(msr_sec);
-      break;
-    }
-    /********************************** Stat end *****************************************/
-  }
-
-  delete txn;
-}
-
-void RunTPCC(coro_yield_t& yield, coro_id_t coro_id, int finished_num) {
-  // Each coroutine has a txn: Each coroutine is a coordinator
-  TXN* txn = new TXN(meta_man,
-                     qp_man,
-                     thread_gid,
-                     coro_id,
-                     coro_sched,
-                     rdma_buffer_allocator,
-                     delta_offset_allocator,
-                     locked_key_table,
-                     addr_cache);
-  struct timespec tx_start_time, tx_end_time;
-  bool tx_committed = false;
+  // All coroutines draw from the generator of coroutine 0, which keeps the key streams of TPCC
+  ProcArgs args{.client = workload->client,
+                .seed = &seed,
+                .random = random_generator,
+                .key = 0,
+                .tx_id = 0,
+                .payload = nullptr,
+                .payload_size = 0};
 
   // Running transactions
   clock_gettime(CLOCK_REALTIME, &msr_start);
   last_end = msr_start;
   while (true) {
+    if (zipf_gen) {
+      // The single-key workload, i.e., MICRO. The key is drawn before the procedure
+      args.key = is_skewed ? (itemkey_t)(zipf_gen->next()) : (itemkey_t)FastRand(&seed) & (num_keys_global - 1);
+      assert(args.key >= 0 && args.key < num_keys_global);
+    }
+
     // Guarantee that each coroutine has a different seed
-    TPCCTxType tx_type = tpcc_workgen_arr[FastRand(&seed) % 100];
-    uint64_t iter = ++tx_id_generator;  // Global atomic transaction id
-    stat_attempted_tx_total++;
-    // TLOG(INFO, thread_gid) << "Thread " << thread_gid << " attemps txn " << stat_attempted_tx_total << " txn id: " << iter;
+    const Procedure& proc = workload->procs[workgen_arr[FastRand(&seed) % 100]];
+    args.tx_id = ++tx_id_generator;  // Global atomic transaction id
 
-    clock_gettime(CLOCK_REALTIME, &tx_start_time);
-    switch (tx_type) {
-      case TPCCTxType::kDelivery: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxDelivery(tpcc_client, random_generator, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-      } break;
-      case TPCCTxType::kNewOrder: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxNewOrder(tpcc_client, random_generator, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-      } break;
-      case TPCCTxType::kOrderStatus: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxOrderStatus(tpcc_client, random_generator, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-      } break;
-      case TPCCTxType::kPayment: {
-        thread_local_try_times[uint64_t(tx_type)]++;
-        tx_committed = TxPayment(tpcc_client, random_generator, yield, iter, txn);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-      } break;
-      case TPCCTxType::kStockLevel: {
-        do {
-          thread_local_try_times[uint64_t(tx_type)]++;
-          clock_gettime(CLOCK_REALTIME, &tx_start_time);
-
-          tx_committed = TxStockLevel(tpcc_client, random_generator, yield, iter, txn);
-          if (!tx_committed) {
-            iter = ++tx_id_generator;
-          }
-        } while (tx_committed != true);
-        if (tx_committed) thread_local_commit_times[uint64_t(tx_type)]++;
-      } break;
-      default:
-        printf("Unexpected transaction type %d\n", static_cast<int>(tx_type));
-        abort();
-    }
+    stat_attempted_tx_total++;
+    tx_committed = RunProcedure(proc, yield, txn, args, tx_start_time);
 
     /********************************** Stat begin *****************************************/
     // Stat after one transaction finishes
@@ -378,7 +220,8 @@ void RunTPCC(coro_yield_t& yield, coro_id_t coro_id, int finished_num) {
       timer[stat_committed_tx_total++] = tx_usec;
     }
 
-    if (stat_attempted_tx_total >= (ATTEMPTED_NUM - finished_num)) {
+    uint64_t stat_done_tx_total = stop_on_committed ? stat_committed_tx_total : stat_attempted_tx_total;
+    if (stat_done_tx_total >= (ATTEMPTED_NUM - finished_num)) {
       // A coroutine calculate the total execution time and exits
       clock_gettime(CLOCK_REALTIME, &msr_end);
       // double msr_usec = (msr_end.tv_sec - msr_start.tv_sec) * 1000000 + (double) (msr_end.tv_nsec - msr_start.tv_nsec) / 1000;
@@ -388,6 +231,10 @@ void RunTPCC(coro_yield_t& yield, coro_id_t coro_id, int finished_num) {
       break;
     }
 
+    if (!check_crash) {
+      continue;
+    }
+
     try_times[thread_local_id] = stat_attempted_tx_total;
 
     if (to_crash[thread_local_id]) {
@@ -395,11 +242,6 @@ void RunTPCC(coro_yield_t& yield, coro_id_t coro_id, int finished_num) {
       // std::cerr << "Thread " << thread_gid << " crash" << std::endl;
       double msr_sec = (msr_end.tv_sec - msr_start.tv_sec) + (double)(msr_end.tv_nsec - msr_start.tv_nsec) / 1000000000;
       RecordTpLat(msr_sec);
-      // for (int i = 0; i < coro_num; i++) {
-      //   if (locked_key_table[i].num_entry) {
-      //     RDMA_LOG(INFO) << "cid: " << i << ", txid: " << locked_key_table[i].tx_id << ", num_entry: " << locked_key_table[i].num_entry;
-      //   }
-      // }
       report_crash[thread_local_id] = true;
 
       break;
@@ -432,8 +274,36 @@ void RunTPCC(coro_yield_t& yield, coro_id_t coro_id, int finished_num) {
   delete txn;
 }
 
-void RunMICRO(coro_yield_t& yield, coro_id_t coro_id) {
-  double total_msr_us = 0;
+// Run one procedure invoked by a local process. The procedure decodes its arguments from the request.
+// Without arguments, its inputs are drawn as in the built-in generator
+IPCStatus ExecProcedure(coro_yield_t& yield, uint64_t iter, TXN* txn, const IPCRequest& req, struct timespec& tx_start_time) {
+  if (req.proc_id >= workload->procs.size()) {
+    return kIPCBadProc;
+  }
+  if (req.arg_size > IPC_MAX_ARG_SIZE) {
+    return kIPCBadArgs;
+  }
+
+  uint64_t proc_seed = FastRand(&seed);
+  FastRandom proc_random(proc_seed);
+  ProcArgs args{.client = workload->client,
+                .seed = &proc_seed,
+                .random = &proc_random,
+                .key = 0,
+                .tx_id = iter,
+                .payload = req.arg_size ? req.args : nullptr,
+                .payload_size = req.arg_size};
+
+  if (zipf_gen) {
+    args.key = (itemkey_t)FastRand(&proc_seed) & (num_keys_global - 1);
+  }
+
+  return RunProcedure(workload->procs[req.proc_id], yield, txn, args, tx_start_time) ? kIPCCommitted : kIPCAborted;
+}
+
+// Serve the requests from local processes instead of the built-in generators. A coroutine takes
+// a request whenever it is idle, and the aborted txns are reported to the clients, which decide to retry
+void RunIPC(coro_yield_t& yield, coro_id_t coro_id) {
   // Each coroutine has a txn: Each coroutine is a coordinator
   TXN* txn = new TXN(meta_man,
                      qp_man,
@@ -443,75 +313,64 @@ void RunMICRO(coro_yield_t& yield, coro_id_t coro_id) {
                      rdma_buffer_allocator,
                      delta_offset_allocator,
                      locked_key_table,
-                     addr_cache);
+                     addr_cache,
+                     table_cache,
+                     version_cache,
+                     commit_stage,
+                     txn_watermark,
+                     gc_watermark,
+                     lease_clock);
   struct timespec tx_start_time, tx_end_time;
-  bool tx_committed = false;
+  IPCRequest req;
+  uint32_t client_id;
 
-  // Running transactions
-  clock_gettime(CLOCK_REALTIME, &msr_start);
   while (true) {
-    uint64_t iter = ++tx_id_generator;  // Global atomic transaction id
-    itemkey_t key;
-
-    if (is_skewed) {
-      // Skewed distribution
-      key = (itemkey_t)(zipf_gen->next());
-    } else {
-      // Uniformed distribution
-      key = (itemkey_t)FastRand(&seed) & (num_keys_global - 1);
+    if (!ipc_worker->Pop(req, client_id)) {
+      // An idle coroutine never joins a group, so the staged commits of others need not wait for it
+      if (commit_stage && !commit_stage->IsEmpty()) {
+        commit_stage->Flush();
+      }
+      ipc_worker->Idle(coro_num - 1, coro_sched->HasPending());
+      coro_sched->YieldIdle(yield, coro_id);
+      continue;
     }
 
-    assert(key >= 0 && key < num_keys_global);
-
-    if (FastRand(&seed) % 100 < write_ratio) {
-      // rw
-      thread_local_try_times[uint64_t(MicroTxType::kUpdateOne)]++;
-      stat_attempted_tx_total++;
-
-      clock_gettime(CLOCK_REALTIME, &tx_start_time);
-
-      tx_committed = TxUpdateOne(yield, iter, txn, key);
-
-      if (tx_committed) thread_local_commit_times[uint64_t(MicroTxType::kUpdateOne)]++;
-    } else {
-      // ro
-      thread_local_try_times[uint64_t(MicroTxType::kReadOne)]++;
-      stat_attempted_tx_total++;
+    if (stat_attempted_tx_total == 0) {
+      // The measurement starts from the first request
+      clock_gettime(CLOCK_REALTIME, &msr_start);
+    }
 
-      clock_gettime(CLOCK_REALTIME, &tx_start_time);
+    uint64_t iter = ++tx_id_generator;  // Global atomic transaction id
+    stat_attempted_tx_total++;
+    clock_gettime(CLOCK_REALTIME, &tx_start_time);
 
-      tx_committed = TxReadOne(yield, iter, txn, key);
-
-      if (tx_committed) thread_local_commit_times[uint64_t(MicroTxType::kReadOne)]++;
-    }
+    IPCStatus status = ExecProcedure(yield, iter, txn, req, tx_start_time);
+    ipc_worker->Respond(client_id, IPCResponse{.req_id = req.req_id,
+                                               .client_ts = req.client_ts,
+                                               .proc_id = req.proc_id,
+                                               .status = status,
+                                               .padding = 0});
 
     /********************************** Stat begin *****************************************/
-    // Stat after one transaction finishes
-    if (tx_committed) {
+    if (status == kIPCCommitted) {
       clock_gettime(CLOCK_REALTIME, &tx_end_time);
       double tx_usec = (tx_end_time.tv_sec - tx_start_time.tv_sec) * 1000000 + (double)(tx_end_time.tv_nsec - tx_start_time.tv_nsec) / 1000;
       timer[stat_committed_tx_total++] = tx_usec;
     }
-
-    if (stat_committed_tx_total >= ATTEMPTED_NUM) {
-      // A coroutine calculate the total execution time and exits
+    if (stat_attempted_tx_total >= ATTEMPTED_NUM) {
+      ipc_worker->Flush();
       clock_gettime(CLOCK_REALTIME, &msr_end);
-      // double msr_usec = (msr_end.tv_sec - msr_start.tv_sec) * 1000000 + (double) (msr_end.tv_nsec - msr_start.tv_nsec) / 1000;
       double msr_sec = (msr_end.tv_sec - msr_start.tv_sec) + (double)(msr_end.tv_nsec - msr_start.tv_nsec) / 1000000000;
       RecordTpLat(msr_sec);
       break;
     }
+    /********************************** Stat end *****************************************/
   }
 
-  /********************************** Stat end *****************************************/
-
   delete txn;
 }
 
 void run_thread(thread_params* params,
-                TATP* tatp_cli,
-                SmallBank* smallbank_cli,
-                TPCC* tpcc_cli,
                 std::vector<TpProbe>* thread_tp_probe) {
   auto bench_name = params->bench_name;
   std::string config_filepath = "../../../config/" + bench_name + "_config.json";
@@ -520,41 +379,40 @@ void run_thread(thread_params* params,
   auto conf = json_config.get(bench_name);
   ATTEMPTED_NUM = conf.get("attempted_num").get_uint64();
 
-  if (bench_name == "tatp") {
-    tatp_client = tatp_cli;
-    tatp_workgen_arr = tatp_client->CreateWorkgenArray();
-    thread_local_try_times = new uint64_t[TATP_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[TATP_TX_TYPES]();
-  } else if (bench_name == "smallbank") {
-    smallbank_client = smallbank_cli;
-    smallbank_workgen_arr = smallbank_client->CreateWorkgenArray();
-    thread_local_try_times = new uint64_t[SmallBank_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[SmallBank_TX_TYPES]();
-  } else if (bench_name == "tpcc") {
-    tpcc_client = tpcc_cli;
-    tpcc_workgen_arr = tpcc_client->CreateWorkgenArray();
-    thread_local_try_times = new uint64_t[TPCC_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[TPCC_TX_TYPES]();
-  } else if (bench_name == "micro") {
-    thread_local_try_times = new uint64_t[MICRO_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[MICRO_TX_TYPES]();
+  workload = proc_registry.GetWorkload(bench_name);
+  if (!workload) {
+    RDMA_LOG(FATAL) << "No procedures are registered for " << bench_name;
   }
+  workgen_arr = proc_registry.CreateWorkgenArray(bench_name);
+  stop_on_committed = (bench_name == "micro");
+  check_crash = (bench_name == "tpcc");
+  thread_local_try_times = new uint64_t[workload->procs.size()]();
+  thread_local_commit_times = new uint64_t[workload->procs.size()]();
 
   thread_gid = params->thread_global_id;
   thread_local_id = params->thread_local_id;
   meta_man = params->global_meta_man;
   coro_num = (coro_id_t)params->coro_num;
   coro_sched = new CoroutineScheduler(thread_gid, coro_num);
+  commit_stage = (params->group_commit_size > 0) ? new CommitStage(coro_sched, params->group_commit_size) : nullptr;
+  gc_watermark = (params->gc_watermark_refresh_us > 0) ? new GCWatermark(coro_num, params->gc_watermark_refresh_us) : nullptr;
+#if LEASE_LOCK
+  // The thread 0 of the cluster ticks the lease epoch
+  lease_clock = new LeaseClock(thread_gid == 0);
+#else
+  lease_clock = nullptr;
+#endif
+  ipc_worker = params->ipc_region ? new IPCWorker(params->ipc_region, thread_local_id, params->ipc_response_batch) : nullptr;
 
   addr_cache = params->addr_cache;
+  table_cache = params->table_cache;
+  version_cache = params->version_cache;
+  txn_watermark = params->txn_watermark;
 
   auto alloc_rdma_region_range = params->global_rdma_region->GetThreadLocalRegion(thread_local_id);
   rdma_buffer_allocator = new LocalBufferAllocator(alloc_rdma_region_range.first, alloc_rdma_region_range.second);
 
-  std::unordered_map<node_id_t, DeltaRange> thread_delta_region;
-  params->global_delta_region->GetThreadDeltaRegion(thread_gid, thread_delta_region);
-
-  delta_offset_allocator = new RemoteDeltaOffsetAllocator(thread_delta_region);
+  delta_offset_allocator = new RemoteDeltaOffsetAllocator(txn_watermark, gc_watermark);
 
   char* p = (char*)(params->global_locked_key_table);
   p += sizeof(LockedKeyTable) * thread_local_id * coro_num;
@@ -592,16 +450,10 @@ void run_thread(thread_params* params,
     // Bind workload to coroutine
     if (coro_i == POLL_ROUTINE_ID) {
       coro_sched->coro_array[coro_i].func = coro_call_t(bind(Poll, _1));
+    } else if (ipc_worker) {
+      coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunIPC, _1, coro_i));
     } else {
-      if (bench_name == "tatp") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunTATP, _1, coro_i));
-      } else if (bench_name == "smallbank") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunSmallBank, _1, coro_i));
-      } else if (bench_name == "tpcc") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunTPCC, _1, coro_i, 0));
-      } else if (bench_name == "micro") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunMICRO, _1, coro_i));
-      }
+      coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunWorkload, _1, coro_i, 0));
     }
   }
 
@@ -612,6 +464,11 @@ void run_thread(thread_params* params,
   qp_man = new QPManager(thread_gid);
   qp_man->BuildQPConnection(meta_man);
 
+  // One thread copies the read-only tables before any transaction runs
+  if (table_cache && thread_local_id == 0) {
+    table_cache->Load(meta_man, qp_man, rdma_buffer_allocator);
+  }
+
   // Sync qp connections in one compute node before running transactions
   connected_t_num += 1;
   while (connected_t_num != params->running_tnum) {
@@ -624,16 +481,20 @@ void run_thread(thread_params* params,
   mux.lock();
 
   delta_usage.push_back(delta_offset_allocator->GetDeltaUsage());
+  delta_reused.push_back(delta_offset_allocator->GetReusedDelta());
+  delta_grabbed.push_back(delta_offset_allocator->GetGrabbedDelta());
 
   mux.unlock();
 
   // Clean
   delete[] timer;
-  if (tatp_workgen_arr) delete[] tatp_workgen_arr;
-  if (smallbank_workgen_arr) delete[] smallbank_workgen_arr;
-  if (tpcc_workgen_arr) delete[] tpcc_workgen_arr;
+  if (workgen_arr) delete[] workgen_arr;
   if (random_generator) delete[] random_generator;
   if (zipf_gen) delete zipf_gen;
+  if (commit_stage) delete commit_stage;
+  if (gc_watermark) delete gc_watermark;
+  if (lease_clock) delete lease_clock;
+  if (ipc_worker) delete ipc_worker;
   delete coro_sched;
   delete thread_local_try_times;
   delete thread_local_commit_times;
@@ -642,9 +503,6 @@ void run_thread(thread_params* params,
 }
 
 void recovery(thread_params* params,
-              TATP* tatp_cli,
-              SmallBank* smallbank_cli,
-              TPCC* tpcc_cli,
               int finished_num,
               std::vector<TpProbe>* thread_tp_probe,
               t_id_t crasher) {
@@ -655,41 +513,39 @@ void recovery(thread_params* params,
   auto conf = json_config.get(bench_name);
   ATTEMPTED_NUM = conf.get("attempted_num").get_uint64();
 
-  if (bench_name == "tatp") {
-    tatp_client = tatp_cli;
-    tatp_workgen_arr = tatp_client->CreateWorkgenArray();
-    thread_local_try_times = new uint64_t[TATP_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[TATP_TX_TYPES]();
-  } else if (bench_name == "smallbank") {
-    smallbank_client = smallbank_cli;
-    smallbank_workgen_arr = smallbank_client->CreateWorkgenArray();
-    thread_local_try_times = new uint64_t[SmallBank_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[SmallBank_TX_TYPES]();
-  } else if (bench_name == "tpcc") {
-    tpcc_client = tpcc_cli;
-    tpcc_workgen_arr = tpcc_client->CreateWorkgenArray();
-    thread_local_try_times = new uint64_t[TPCC_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[TPCC_TX_TYPES]();
-  } else if (bench_name == "micro") {
-    thread_local_try_times = new uint64_t[MICRO_TX_TYPES]();
-    thread_local_commit_times = new uint64_t[MICRO_TX_TYPES]();
+  workload = proc_registry.GetWorkload(bench_name);
+  if (!workload) {
+    RDMA_LOG(FATAL) << "No procedures are registered for " << bench_name;
   }
+  workgen_arr = proc_registry.CreateWorkgenArray(bench_name);
+  stop_on_committed = (bench_name == "micro");
+  check_crash = (bench_name == "tpcc");
+  thread_local_try_times = new uint64_t[workload->procs.size()]();
+  thread_local_commit_times = new uint64_t[workload->procs.size()]();
 
   thread_gid = params->thread_global_id;
   thread_local_id = params->thread_local_id;
   meta_man = params->global_meta_man;
   coro_num = (coro_id_t)params->coro_num;
   coro_sched = new CoroutineScheduler(thread_gid, coro_num);
+  commit_stage = (params->group_commit_size > 0) ? new CommitStage(coro_sched, params->group_commit_size) : nullptr;
+  gc_watermark = (params->gc_watermark_refresh_us > 0) ? new GCWatermark(coro_num, params->gc_watermark_refresh_us) : nullptr;
+#if LEASE_LOCK
+  // The thread 0 of the cluster ticks the lease epoch
+  lease_clock = new LeaseClock(thread_gid == 0);
+#else
+  lease_clock = nullptr;
+#endif
 
   addr_cache = params->addr_cache;
+  table_cache = params->table_cache;
+  version_cache = params->version_cache;
+  txn_watermark = params->txn_watermark;
 
   auto alloc_rdma_region_range = params->global_rdma_region->GetThreadLocalRegion(thread_local_id);
   rdma_buffer_allocator = new LocalBufferAllocator(alloc_rdma_region_range.first, alloc_rdma_region_range.second);
 
-  std::unordered_map<node_id_t, DeltaRange> thread_delta_region;
-  params->global_delta_region->GetThreadDeltaRegion(thread_gid, thread_delta_region);
-
-  delta_offset_allocator = new RemoteDeltaOffsetAllocator(thread_delta_region);
+  delta_offset_allocator = new RemoteDeltaOffsetAllocator(txn_watermark, gc_watermark);
 
   char* p = (char*)(params->global_locked_key_table);
   p += sizeof(LockedKeyTable) * thread_local_id * coro_num;
@@ -728,15 +584,7 @@ void recovery(thread_params* params,
     if (coro_i == POLL_ROUTINE_ID) {
       coro_sched->coro_array[coro_i].func = coro_call_t(bind(Poll, _1));
     } else {
-      if (bench_name == "tatp") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunTATP, _1, coro_i));
-      } else if (bench_name == "smallbank") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunSmallBank, _1, coro_i));
-      } else if (bench_name == "tpcc") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunTPCC, _1, coro_i, 0));
-      } else if (bench_name == "micro") {
-        coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunMICRO, _1, coro_i));
-      }
+      coro_sched->coro_array[coro_i].func = coro_call_t(bind(RunWorkload, _1, coro_i, 0));
     }
   }
 
@@ -788,7 +636,7 @@ void recovery(thread_params* params,
         *(lock_t*)cas_buf = 0;
 
         auto* qp = qp_man->GetRemoteDataQPWithNodeID(target[i].entries[j].remote_node);
-        qp->post_cas(cas_buf, target[i].entries[j].remote_off, target[i].tx_id, 0, 0);
+        qp->post_cas(cas_buf, target[i].entries[j].remote_off, target[i].lock, 0, 0);
       }
     }
   }
@@ -816,16 +664,19 @@ void recovery(thread_params* params,
   mux.lock();
 
   delta_usage.push_back(delta_offset_allocator->GetDeltaUsage());
+  delta_reused.push_back(delta_offset_allocator->GetReusedDelta());
+  delta_grabbed.push_back(delta_offset_allocator->GetGrabbedDelta());
 
   mux.unlock();
 
   // Clean
   delete[] timer;
-  if (tatp_workgen_arr) delete[] tatp_workgen_arr;
-  if (smallbank_workgen_arr) delete[] smallbank_workgen_arr;
-  if (tpcc_workgen_arr) delete[] tpcc_workgen_arr;
+  if (workgen_arr) delete[] workgen_arr;
   if (random_generator) delete[] random_generator;
   if (zipf_gen) delete zipf_gen;
+  if (commit_stage) delete commit_stage;
+  if (gc_watermark) delete gc_watermark;
+  if (lease_clock) delete lease_clock;
   delete coro_sched;
   delete thread_local_try_times;
   delete thread_local_commit_times;
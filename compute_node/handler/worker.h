@@ -6,12 +6,15 @@
 #include "allocator/region_allocator.h"
 #include "base/common.h"
 #include "cache/addr_cache.h"
+#include "cache/table_cache.h"
+#include "cache/version_cache.h"
 #include "connection/meta_manager.h"
 #include "micro/micro_db.h"
 #include "smallbank/smallbank_db.h"
 #include "tatp/tatp_db.h"
 #include "tpcc/tpcc_db.h"
 #include "process/oplog.h"
+#include "process/watermark.h"
 
 struct thread_params {
   t_id_t thread_local_id;
@@ -19,10 +22,16 @@ struct thread_params {
   t_id_t running_tnum;
   MetaManager* global_meta_man;
   AddrCache* addr_cache;
+  TableCache* table_cache;
+  VersionCache* version_cache;
+  TxnWatermark* txn_watermark;
   LocalRegionAllocator* global_rdma_region;
-  RemoteDeltaRegionAllocator* global_delta_region;
   LockedKeyTable* global_locked_key_table;
   int coro_num;
+  int group_commit_size;
+  uint64_t gc_watermark_refresh_us;
+  char* ipc_region;  // Requests from local processes. nullptr if the coroutines run the built-in generators
+  int ipc_response_batch;
   std::string bench_name;
 };
 
@@ -33,15 +42,9 @@ struct TpProbe {
 };
 
 void run_thread(thread_params* params,
-                TATP* tatp_client,
-                SmallBank* smallbank_client,
-                TPCC* tpcc_client,
                 std::vector<TpProbe>* thread_tp_probe);
 
 void recovery(thread_params* params,
-              TATP* tatp_client,
-              SmallBank* smallbank_client,
-              TPCC* tpcc_client,
               int finished_num,
               std::vector<TpProbe>* thread_tp_probe,
               t_id_t crasher);
@@ -0,0 +1,145 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include <time.h>
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cache/addr_cache.h"
+#include "util/zipf.h"
+
+// Compare the shared address cache with the per-thread maps it replaces. Each thread looks up keys drawn
+// from a Zipfian distribution, and inserts the address on a miss, as a hash read does. The lookup cost
+// includes the inserts. No RDMA is involved
+
+static uint64_t NowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// The former per-thread cache: <node, table, key> -> addresses, unbounded
+class PerThreadMap {
+ public:
+  void Insert(node_id_t node_id, table_id_t table_id, itemkey_t key, offset_t remote_offset, offset_t fv_off) {
+    addr_map[node_id][table_id][key] = CachedAddr{remote_offset, fv_off};
+  }
+
+  offset_t Search(node_id_t node_id, table_id_t table_id, itemkey_t key, offset_t& fv_off) {
+    fv_off = NOT_FOUND;
+    auto node_search = addr_map.find(node_id);
+    if (node_search == addr_map.end()) return NOT_FOUND;
+    auto table_search = node_search->second.find(table_id);
+    if (table_search == node_search->second.end()) return NOT_FOUND;
+    auto offset_search = table_search->second.find(key);
+    if (offset_search == table_search->second.end()) return NOT_FOUND;
+    fv_off = offset_search->second.remote_full_value_offset;
+    return offset_search->second.remote_offset;
+  }
+
+  // Nodes of the key maps, ignoring the buckets and the outer maps
+  size_t ApproxSize() const {
+    size_t entries = 0;
+    for (auto& node : addr_map) {
+      for (auto& table : node.second) {
+        entries += table.second.size();
+      }
+    }
+    return entries * (sizeof(std::pair<const itemkey_t, CachedAddr>) + 2 * sizeof(void*));
+  }
+
+ private:
+  struct CachedAddr {
+    offset_t remote_offset;
+    offset_t remote_full_value_offset;
+  };
+
+  std::unordered_map<node_id_t, std::unordered_map<table_id_t, std::unordered_map<itemkey_t, CachedAddr>>> addr_map;
+};
+
+struct BenchResult {
+  double mops;
+  double hit_rate;
+};
+
+// The addresses are derived from the key, so that a wrong hit is detected
+template <typename Cache>
+static void Lookup(Cache& cache, ZipfGen& zipf, uint64_t op_num, uint64_t& hit, uint64_t& wrong) {
+  for (uint64_t i = 0; i < op_num; i++) {
+    itemkey_t key = zipf.next();
+    table_id_t table_id = (table_id_t)(key % 4);
+    offset_t fv_off;
+    offset_t off = cache.Search(0, table_id, key, fv_off);
+    if (off != NOT_FOUND) {
+      hit++;
+      if (off != (offset_t)(key * 64) || fv_off != (offset_t)(key * 64 + 32)) wrong++;
+      continue;
+    }
+    cache.Insert(0, table_id, key, (offset_t)(key * 64), (offset_t)(key * 64 + 32));
+  }
+}
+
+template <typename Run>
+static BenchResult RunThreads(int thread_num, uint64_t op_num, Run run) {
+  std::vector<std::thread> threads;
+  std::vector<uint64_t> hits(thread_num, 0);
+  std::atomic<uint64_t> wrong(0);
+  uint64_t start = NowNs();
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      uint64_t w = 0;
+      run(t, hits[t], w);
+      wrong += w;
+    });
+  }
+  for (auto& th : threads) th.join();
+  double sec = (double)(NowNs() - start) / 1000000000;
+
+  uint64_t hit = 0;
+  for (auto h : hits) hit += h;
+  if (wrong) {
+    std::cerr << "Wrong addresses are returned: " << wrong << std::endl;
+  }
+  return BenchResult{(double)op_num * thread_num / sec / 1000000, (double)hit / (op_num * thread_num)};
+}
+
+int main(int argc, char* argv[]) {
+  if (argc != 6) {
+    std::cerr << "./addr_cache_bench <thread_num> <key_num> <cache_entries> <zipf_theta, e.g., 0.99, 0 for uniform> <lookups_per_thread>" << std::endl;
+    return 0;
+  }
+
+  int thread_num = std::stoi(argv[1]);
+  uint64_t key_num = std::stoull(argv[2]);
+  size_t cache_entries = std::stoull(argv[3]);
+  double theta = std::stod(argv[4]);
+  uint64_t op_num = std::stoull(argv[5]);
+
+  ZipfGen zipf_base(key_num, theta, 0);
+
+  AddrCache shared(cache_entries);
+  BenchResult shared_res = RunThreads(thread_num, op_num, [&](int t, uint64_t& hit, uint64_t& wrong) {
+    ZipfGen zipf(zipf_base, t + 1);
+    Lookup(shared, zipf, op_num, hit, wrong);
+  });
+
+  std::vector<PerThreadMap> maps(thread_num);
+  BenchResult map_res = RunThreads(thread_num, op_num, [&](int t, uint64_t& hit, uint64_t& wrong) {
+    ZipfGen zipf(zipf_base, t + 1);
+    Lookup(maps[t], zipf, op_num, hit, wrong);
+  });
+  size_t map_size = 0;
+  for (auto& m : maps) map_size += m.ApproxSize();
+
+  std::cout << "Threads: " << thread_num << ", keys: " << key_num << ", theta: " << theta << ", lookups per thread: " << op_num << std::endl;
+  std::cout << "Shared cache (" << cache_entries << " entries, " << (double)shared.TotalSize() / 1024 / 1024 << " MB): "
+            << shared_res.mops << " Mops, hit rate " << shared_res.hit_rate << std::endl;
+  std::cout << "Per-thread maps (~" << (double)map_size / 1024 / 1024 << " MB): "
+            << map_res.mops << " Mops, hit rate " << map_res.hit_rate << std::endl;
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include <time.h>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "handler/ipc.h"
+
+static uint64_t NowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// A local process that submits txns to a running compute node through its IPC front-end, and measures
+// the end-to-end throughput and latency. Each request invokes a procedure chosen uniformly at random.
+// Its argument is a random key in [0, key_num) if key_num is given, e.g., for MICRO, otherwise a random seed
+int main(int argc, char* argv[]) {
+  if (argc != 5 && argc != 6) {
+    std::cerr << "./ipc_loadgen <socket_path> <procedure_num, e.g., 7 for TATP> <duration_sec> <outstanding_per_thread> [key_num]" << std::endl;
+    return 0;
+  }
+
+  std::string socket_path = argv[1];
+  uint32_t proc_num = (uint32_t)std::stoul(argv[2]);
+  uint64_t duration_ns = std::stoull(argv[3]) * 1000000000;
+  uint64_t window = std::min((uint64_t)std::stoull(argv[4]), (uint64_t)IPC_RING_DEPTH);
+  uint64_t key_num = (argc == 6) ? std::stoull(argv[5]) : 0;
+
+  IPCHello hello;
+  int conn_fd = ConnectIPC(socket_path, hello);
+  if (conn_fd < 0) {
+    std::cerr << "Fail to connect to the compute node on " << socket_path << std::endl;
+    return 1;
+  }
+  if (hello.client_id >= IPC_MAX_CLIENTS) {
+    std::cerr << "The compute node takes no more clients" << std::endl;
+    close(conn_fd);
+    return 1;
+  }
+
+  char* region = MapIPCRegion(hello.shm_name, IPCRegionSize(hello.thread_num), false);
+  if (!region) {
+    std::cerr << "Fail to map the IPC region " << hello.shm_name << std::endl;
+    close(conn_fd);
+    return 1;
+  }
+
+  std::cout << "Client " << hello.client_id << " attaches to " << hello.thread_num << " threads, "
+            << window << " outstanding requests per thread" << std::endl;
+
+  std::vector<IPCChannel*> channels(hello.thread_num);
+  std::vector<uint64_t> outstanding(hello.thread_num, 0);
+  for (uint32_t t = 0; t < hello.thread_num; t++) {
+    channels[t] = GetIPCChannel(region, hello.client_id, t);
+  }
+
+  std::mt19937_64 rand_gen(NowNs());
+  std::vector<uint64_t> latency_ns;
+  uint64_t next_req_id = 0;
+  uint64_t committed = 0, aborted = 0, bad_proc = 0;
+
+  uint64_t start = NowNs();
+  uint64_t now = start;
+  while (now - start < duration_ns) {
+    RenewIPCLease(region, hello.client_id);
+
+    for (uint32_t t = 0; t < hello.thread_num; t++) {
+      IPCResponse resp;
+      while (channels[t]->resp.Pop(resp)) {
+        outstanding[t]--;
+        if (resp.status == kIPCCommitted) {
+          committed++;
+          latency_ns.push_back(NowNs() - resp.client_ts);
+        } else if (resp.status == kIPCAborted) {
+          aborted++;
+        } else {
+          bad_proc++;
+        }
+      }
+    }
+
+    // Each request goes to the thread with the fewest outstanding requests of mine
+    now = NowNs();
+    while (true) {
+      uint32_t target = (uint32_t)(std::min_element(outstanding.begin(), outstanding.end()) - outstanding.begin());
+      if (outstanding[target] >= window) {
+        break;
+      }
+      IPCRequest req;
+      req.req_id = next_req_id++;
+      req.client_ts = now;
+      req.proc_id = (uint32_t)(rand_gen() % proc_num);
+      uint64_t arg = key_num ? rand_gen() % key_num : rand_gen();
+      req.arg_size = sizeof(arg);
+      memcpy(req.args, &arg, sizeof(arg));
+      if (!channels[target]->req.Push(req)) {
+        break;
+      }
+      outstanding[target]++;
+    }
+  }
+
+  // The outstanding requests are dropped, and my slot is given to the next client
+  DetachIPC(region, hello.client_id, conn_fd);
+
+  double elapsed_sec = (double)(NowNs() - start) / 1000000000;
+  std::sort(latency_ns.begin(), latency_ns.end());
+  double p50_us = latency_ns.empty() ? 0 : (double)latency_ns[latency_ns.size() / 2] / 1000;
+  double p99_us = latency_ns.empty() ? 0 : (double)latency_ns[latency_ns.size() * 99 / 100] / 1000;
+
+  std::cout << "Committed: " << committed << ", aborted: " << aborted << ", bad procedure or arguments: " << bad_proc << std::endl;
+  std::cout << "Throughput: " << (double)committed / elapsed_sec / 1000 << " KOPS (attempted: "
+            << (double)(committed + aborted) / elapsed_sec / 1000 << " KOPS)" << std::endl;
+  std::cout << "End-to-end latency: p50 " << p50_us << " us, p99 " << p99_us << " us" << std::endl;
+
+  munmap(region, IPCRegionSize(hello.thread_num));
+  return 0;
+}
@@ -6,7 +6,7 @@
 // Entrance to run threads that spawn coroutines as coordinators to run distributed transactions
 int main(int argc, char* argv[]) {
   if (argc != 5) {
-    std::cerr << "./run <benchmark_name> <thread_num> <coroutine_num> <isolation_level>" << std::endl;
+    std::cerr << "./run <benchmark_name> <thread_num> <coroutine_num> <isolation_level: SI/SR/RC>" << std::endl;
     return 0;
   }
 
@@ -16,5 +16,6 @@ int main(int argc, char* argv[]) {
 
   handler->GenThreads(std::string(argv[1]));
 
-  handler->OutputResult(std::string(argv[1]), "Motor");
+  // Results of different isolation levels are distinguished by the system name
+  handler->OutputResult(std::string(argv[1]), "Motor@" + std::string(argv[4]));
 }
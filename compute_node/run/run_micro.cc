@@ -6,7 +6,7 @@
 // Entrance to run threads that spawn coroutines as coordinators to run distributed transactions
 int main(int argc, char* argv[]) {
   if (argc != 7) {
-    std::cerr << "./run_micro <thread_num> <coroutine_num> <access_pattern> <skewness> <write_ratio> <isolation_level>" << std::endl;
+    std::cerr << "./run_micro <thread_num> <coroutine_num> <access_pattern> <skewness> <write_ratio> <isolation_level: SI/SR/RC>" << std::endl;
     return 0;
   }
 
@@ -16,5 +16,6 @@ int main(int argc, char* argv[]) {
 
   handler->GenThreads("micro");
 
-  handler->OutputResult("micro", "Motor");
+  // Results of different isolation levels are distinguished by the system name
+  handler->OutputResult("micro", "Motor@" + std::string(argv[6]));
 }
@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <thread>
 
 #include "util/json_config.h"
@@ -86,34 +87,37 @@ void Server::ConnectMN() {
 
     other_mn_mrs[remote_node_id] = remote_mr;
 
-    // 2. Build QP connection
+    // 2. Build QP connections, one for each migration thread
     MemoryAttr local_mr = rdma_ctrl->get_local_mr(SERVER_HASH_BUFF_ID);
 
-    // 1000 is used to distinguish qps between MNs with qps between MNs and CNs.
-    // This number should be larger than the total amount of CN threads in the cluster
-    RCQP* data_qp = rdma_ctrl->create_rc_qp(create_rc_idx(remote_node_id, 1000 + my_mn_id),
-                                            rdma_ctrl->get_device(),
-                                            &local_mr);
+    for (int q = 0; q < MIGRATE_THREAD_NUM; q++) {
+      // 1000 is used to distinguish qps between MNs with qps between MNs and CNs.
+      // This number should be larger than the total amount of CN threads in the cluster
+      RCQP* data_qp = rdma_ctrl->create_rc_qp(create_rc_idx(remote_node_id, 1000 + my_mn_id + q * MAX_REMOTE_NODE_NUM),
+                                              rdma_ctrl->get_device(),
+                                              &local_mr);
 
-    ConnStatus rc;
-    do {
-      rc = data_qp->connect(remote_ip, remote_port);
-      if (rc == SUCC) {
-        // Bind the hash mr as the default remote mr for convenient parameter passing
-        data_qp->bind_remote_mr(remote_mr);
+      ConnStatus rc;
+      do {
+        rc = data_qp->connect(remote_ip, remote_port);
+        if (rc == SUCC) {
+          // Bind the hash mr as the default remote mr for convenient parameter passing
+          data_qp->bind_remote_mr(remote_mr);
 
-        other_mn_qps[remote_node_id] = data_qp;
+          other_mn_qps[remote_node_id][q] = data_qp;
 
-        RDMA_LOG(INFO) << "Connect QP with MN ID: " << remote_node_id << " IP: " << remote_ip << " PORT: " << remote_port << " Success!";
-      }
-      usleep(2000);
-    } while (rc != SUCC);
+          RDMA_LOG(INFO) << "Connect QP " << q << " with MN ID: " << remote_node_id << " IP: " << remote_ip << " PORT: " << remote_port << " Success!";
+        }
+        usleep(2000);
+      } while (rc != SUCC);
+    }
   }
 }
 
 // All servers need to load data
 void Server::LoadData(node_id_t machine_id,
                       node_id_t machine_num,  // number of memory nodes
+                      const int* table_backup_num,
                       std::string& workload) {
   /************************************* Load Data ***************************************/
   RDMA_LOG(INFO) << "Start loading database data...";
@@ -136,6 +140,7 @@ void Server::LoadData(node_id_t machine_id,
     tatp_server = new TATP();
     tatp_server->LoadTable(machine_id,
                            machine_num,
+                           table_backup_num,
                            &mem_store_alloc_param,
                            total_size,
                            ht_loadfv_size,
@@ -146,6 +151,7 @@ void Server::LoadData(node_id_t machine_id,
     smallbank_server = new SmallBank();
     smallbank_server->LoadTable(machine_id,
                                 machine_num,
+                                table_backup_num,
                                 &mem_store_alloc_param,
                                 total_size,
                                 ht_loadfv_size,
@@ -156,6 +162,7 @@ void Server::LoadData(node_id_t machine_id,
     tpcc_server = new TPCC();
     tpcc_server->LoadTable(machine_id,
                            machine_num,
+                           table_backup_num,
                            &mem_store_alloc_param,
                            total_size,
                            ht_loadfv_size,
@@ -166,6 +173,7 @@ void Server::LoadData(node_id_t machine_id,
     micro_server = new MICRO();
     micro_server->LoadTable(machine_id,
                             machine_num,
+                            table_backup_num,
                             &mem_store_alloc_param,
                             total_size,
                             ht_loadfv_size,
@@ -182,6 +190,8 @@ void Server::LoadData(node_id_t machine_id,
   // std::cerr << (double)total_size / 1024.0 / 1024.0 << " " << (double)ht_size / 1024.0 / 1024.0 << " " << (double)real_cvt_size / 1024.0 / 1024.0 << " " << (double)initfv_size / 1024.0 / 1024.0 << std::endl;
   // std::cerr << "----------------------------------------------------------" << std::endl;
 
+  ReportReplication(machine_num, table_backup_num, ht_loadfv_size, workload);
+
   std::cerr << "Data area: " << (double)data_size / 1024.0 / 1024.0 << " MB" << std::endl;
   std::cerr << "Delta area: " << (double)delta_size / 1024.0 / 1024.0 << " MB" << std::endl;
   std::cerr << "----------------------------------------------------------" << std::endl;
@@ -209,6 +219,35 @@ void Server::LoadData(node_id_t machine_id,
   RDMA_LOG(INFO) << "Loading table successfully!";
 }
 
+// The replica number of each table decides how many MNs each commit writes, and how much
+// memory this MN spends on the tables as backups
+void Server::ReportReplication(node_id_t machine_num, const int* table_backup_num, size_t loaded_mem, std::string& workload) {
+  std::vector<HashStore*> primary_tables;
+  std::vector<HashStore*> backup_tables;
+  GetHashStores(workload, primary_tables, backup_tables);
+
+  size_t primary_mem = 0;
+  size_t backup_mem = 0;
+
+  for (auto* table : primary_tables) {
+    primary_mem += table->GetHTInitFVSize();
+    int replica_num = std::min(table_backup_num[table->GetTableID()], (int)machine_num - 1) + 1;
+    std::cerr << "Table " << table->GetTableID() << ": " << replica_num << " replicas" << std::endl;
+  }
+
+  for (auto* table : backup_tables) {
+    backup_mem += table->GetHTInitFVSize();
+  }
+
+  std::cerr << "Primary tables on this MN: " << primary_tables.size() << ", " << (double)primary_mem / 1024.0 / 1024.0 << " MB" << std::endl;
+  std::cerr << "Backup tables on this MN: " << backup_tables.size() << ", " << (double)backup_mem / 1024.0 / 1024.0 << " MB" << std::endl;
+  // All the tables are loaded in every MN at the same offsets, so a smaller replica number saves
+  // commit writes, but not the memory of the tables this MN neither serves nor backs up
+  std::cerr << "Loaded tables on this MN: " << (double)loaded_mem / 1024.0 / 1024.0 << " MB, unused: "
+            << (double)(loaded_mem - primary_mem - backup_mem) / 1024.0 / 1024.0 << " MB" << std::endl;
+  std::cerr << "----------------------------------------------------------" << std::endl;
+}
+
 void Server::CleanTable() {
   if (tatp_server) {
     delete tatp_server;
@@ -234,11 +273,12 @@ void Server::SendMeta(node_id_t machine_id,
                       std::string& workload,
                       size_t compute_node_num,
                       offset_t delta_start_off,
-                      size_t per_thread_delta_size) {
+                      size_t delta_pool_size,
+                      offset_t status_start_off) {
   // Prepare hash meta
   char* hash_meta_buffer = nullptr;
   size_t total_meta_size = 0;
-  PrepareHashMeta(machine_id, workload, &hash_meta_buffer, total_meta_size, delta_start_off, per_thread_delta_size);
+  PrepareHashMeta(machine_id, workload, &hash_meta_buffer, total_meta_size, delta_start_off, delta_pool_size, status_start_off);
   assert(hash_meta_buffer != nullptr);
   assert(total_meta_size != 0);
   RDMA_LOG(INFO) << "total meta size(B): " << total_meta_size;
@@ -255,7 +295,8 @@ void Server::PrepareHashMeta(node_id_t machine_id,
                              char** hash_meta_buffer,
                              size_t& total_meta_size,
                              offset_t delta_start_off,
-                             size_t per_thread_delta_size) {
+                             size_t delta_pool_size,
+                             offset_t status_start_off) {
   // Get all hash meta
   std::vector<HashMeta*> primary_hash_meta_vec;
   std::vector<HashMeta*> backup_hash_meta_vec;
@@ -307,7 +348,8 @@ void Server::PrepareHashMeta(node_id_t machine_id,
                     sizeof(backup_hash_meta_num) +
                     sizeof(machine_id) +
                     sizeof(delta_start_off) +
-                    sizeof(per_thread_delta_size) +
+                    sizeof(delta_pool_size) +
+                    sizeof(status_start_off) +
                     primary_hash_meta_num * hash_meta_len +
                     backup_hash_meta_num * hash_meta_len +
                     sizeof(MEM_STORE_META_END);
@@ -329,8 +371,11 @@ void Server::PrepareHashMeta(node_id_t machine_id,
   *((offset_t*)local_buf) = delta_start_off;
   local_buf += sizeof(delta_start_off);
 
-  *((size_t*)local_buf) = per_thread_delta_size;
-  local_buf += sizeof(per_thread_delta_size);
+  *((size_t*)local_buf) = delta_pool_size;
+  local_buf += sizeof(delta_pool_size);
+
+  *((offset_t*)local_buf) = status_start_off;
+  local_buf += sizeof(status_start_off);
 
   for (size_t i = 0; i < primary_hash_meta_num; i++) {
     memcpy(local_buf + i * hash_meta_len, (char*)primary_hash_meta_vec[i], hash_meta_len);
@@ -420,7 +465,7 @@ void Server::SendHashMeta(char* hash_meta_buffer, size_t& total_meta_size) {
   close(listen_socket);
 }
 
-void Server::AcceptReq() {
+void Server::AcceptReq(std::string& workload) {
   struct sockaddr_in server_addr;
   server_addr.sin_family = AF_INET;
   server_addr.sin_port = htons(local_meta_port);    // change host little endian to big endian
@@ -481,97 +526,196 @@ void Server::AcceptReq() {
   RDMA_LOG(INFO) << "[AcceptReq] IsPrimaryFail: " << is_primary_fail << ". I migrate table " << table_id << " from me to MN " << target_mn_id;
 
   // migrate data
+  std::vector<HashStore*> primary_tables;
+  std::vector<HashStore*> backup_tables;
+  GetHashStores(workload, primary_tables, backup_tables);
 
-  std::vector<HashStore*> tables;
+  // Use backup to recover primary, or use primary to recover backup
+  std::vector<HashStore*>& tables = is_primary_fail ? backup_tables : primary_tables;
 
-  if (is_primary_fail) {
-    // Use backup to recover primary
-    tables = tpcc_server->GetBackupHashStore();
-  } else {
-    // Use primary to recover backup
-    tables = tpcc_server->GetPrimaryHashStore();
+  HashStore* table = nullptr;
+  for (auto* t : tables) {
+    if (t->GetTableID() == table_id) {
+      table = t;
+      break;
+    }
   }
 
-  char* start_copy = nullptr;
-  size_t migration_size = 0;
+  if (table == nullptr) {
+    RDMA_LOG(FATAL) << "[AcceptReq] Table " << table_id << " is not found in this MN";
+  }
+
+  // Each thread copies a contiguous range of buckets and the delta-region data they point to
+  MigrateStat stats[MIGRATE_THREAD_NUM];
+  std::vector<std::thread> migrate_threads;
+  uint64_t bkt_num = table->GetBucketNum();
+  uint64_t bkt_per_thread = (bkt_num + MIGRATE_THREAD_NUM - 1) / MIGRATE_THREAD_NUM;
+
+  for (int q = 0; q < MIGRATE_THREAD_NUM; q++) {
+    uint64_t bkt_begin = std::min(bkt_num, q * bkt_per_thread);
+    uint64_t bkt_end = std::min(bkt_num, bkt_begin + bkt_per_thread);
+    migrate_threads.emplace_back([this, table, q, bkt_begin, bkt_end, target_mn_id, &stats]() {
+      MigrateBuckets(table, other_mn_qps[target_mn_id][q], bkt_begin, bkt_end, stats[q]);
+    });
+  }
+
+  for (auto& t : migrate_threads) {
+    t.join();
+  }
+
+  MigrateStat total;
+  for (auto& stat : stats) {
+    total.migration_size += stat.migration_size;
+    total.write_cnt += stat.write_cnt;
+    total.new_attr_bar_cnt += stat.new_attr_bar_cnt;
+    total.new_insert_cnt += stat.new_insert_cnt;
+  }
+
+  RDMA_LOG(INFO) << "[AcceptReq] Migrate SUCCESS: " << (double)total.migration_size / 1024.0 << " KB."
+                 << " Write cnt: " << total.write_cnt << ". new_attr_bar_cnt: " << total.new_attr_bar_cnt << ". new_insert_cnt: " << total.new_insert_cnt;
+
+  char ack[] = "MIGRATE_OK";
+  send(from_client_socket, ack, strlen(ack) + 1, 0);
 
-  int write_cnt = 0;
+  free(recv_buf);
+  close(from_client_socket);
+  close(listen_socket);
+}
+
+// Posts RDMA writes to a QP with selective signaling, so that many writes are in flight.
+// The last write is held back and signaled in Drain() to know that all the writes complete
+class MigrateWriter {
+ public:
+  MigrateWriter(RCQP* qp, MigrateStat& stat) : qp(qp), stat(stat) {}
 
-  int new_attr_bar_cnt = 0;
-  int new_insert_cnt = 0;
+  void Write(char* local_addr, size_t size, offset_t remote_off) {
+    if (held.size) {
+      Post(held, (stat.write_cnt + 1) % MIGRATE_SIGNAL_INTERVAL == 0);
+    }
+    held = WriteReq{local_addr, size, remote_off};
+  }
 
-  for (int i = 0; i < tables.size(); i++) {
-    if (tables[i]->GetTableID() == table_id) {
-      start_copy = tables[i]->GetTablePtr();
-      migration_size += tables[i]->GetHTInitFVSize();
+  void Drain() {
+    if (held.size) {
+      Post(held, true);
+      held.size = 0;
+    }
+    while (pending_signals) {
+      Poll();
+    }
+  }
 
-      // I have the same table offset with remote node
-      other_mn_qps[target_mn_id]->post_send(IBV_WR_RDMA_WRITE, start_copy, migration_size, tables[i]->GetBaseOff(), IBV_SEND_SIGNALED);
+ private:
+  struct WriteReq {
+    char* local_addr;
+    size_t size;
+    offset_t remote_off;
+  };
 
-      ibv_wc wc{};
-      other_mn_qps[target_mn_id]->poll_till_completion(wc, no_timeout);
+  void Post(const WriteReq& req, bool signaled) {
+    if (signaled && pending_signals == MIGRATE_MAX_PENDING_SIGNALS) {
+      Poll();
+    }
+    auto rc = qp->post_send(IBV_WR_RDMA_WRITE, req.local_addr, req.size, req.remote_off, signaled ? IBV_SEND_SIGNALED : 0);
+    if (rc != SUCC) {
+      RDMA_LOG(FATAL) << "[MigrateWriter] post write fails";
+    }
+    if (signaled) pending_signals++;
+    stat.write_cnt++;
+    stat.migration_size += req.size;
+  }
 
-      write_cnt++;
+  void Poll() {
+    ibv_wc wc{};
+    if (qp->poll_till_completion(wc, no_timeout) != SUCC) {
+      RDMA_LOG(FATAL) << "[MigrateWriter] write fails. status: " << wc.status;
+    }
+    pending_signals--;
+  }
 
-      for (int k = 0; k < tables[i]->GetBucketNum(); k++) {
-        // HashBucket* bkt = (HashBucket*)(k * HashBucketSize + start_copy);
+  RCQP* qp;
+  MigrateStat& stat;
+  WriteReq held{nullptr, 0, 0};
+  int pending_signals = 0;
+};
 
-        size_t bkt_size = SLOT_NUM[table_id] * CVTSize;
-        char* cvt_start = k * bkt_size + start_copy;
+void Server::MigrateBuckets(HashStore* table, RCQP* qp, uint64_t bkt_begin, uint64_t bkt_end, MigrateStat& stat) {
+  if (bkt_begin >= bkt_end) return;
 
-        for (int j = 0; j < SLOT_NUM[table_id]; j++) {
-          // CVT* cvt = &(bkt->cvts[j]);
-          CVT* cvt = (CVT*)(cvt_start + j * CVTSize);
+  table_id_t table_id = table->GetTableID();
+  size_t bkt_size = table->GetHashBucketSize();
+  size_t vpkg_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;
+  bool is_last = (bkt_end == table->GetBucketNum());
 
-          if (cvt->header.value_size) {
-            if (cvt->header.remote_attribute_offset != UN_INIT_POS) {
-              migration_size += ATTR_BAR_SIZE[table_id];
-              char* local_attr_addr = mem_region + cvt->header.remote_attribute_offset;
+  MigrateWriter writer(qp, stat);
 
-              other_mn_qps[target_mn_id]->post_send(IBV_WR_RDMA_WRITE, local_attr_addr, ATTR_BAR_SIZE[table_id], cvt->header.remote_attribute_offset, IBV_SEND_SIGNALED);
+  // I have the same table offset with remote node. The last part also carries the initial full values
+  char* start_copy = table->GetTablePtr() + bkt_begin * bkt_size;
+  offset_t remote_off = table->GetBaseOff() + bkt_begin * bkt_size;
+  size_t copy_size = is_last ? (table->GetHTInitFVSize() - bkt_begin * bkt_size) : (bkt_end - bkt_begin) * bkt_size;
 
-              ibv_wc wc{};
-              other_mn_qps[target_mn_id]->poll_till_completion(wc, no_timeout);
-              write_cnt++;
+  for (size_t copied = 0; copied < copy_size; copied += MIGRATE_MAX_WRITE_SIZE) {
+    size_t len = std::min(MIGRATE_MAX_WRITE_SIZE, copy_size - copied);
+    writer.Write(start_copy + copied, len, remote_off + copied);
+  }
 
-              new_attr_bar_cnt++;
-            }
+  // Attribute bars and user-inserted values are in the delta region
+  std::vector<std::pair<offset_t, size_t>> ranges;
 
-            if (cvt->header.user_inserted) {
-              size_t vpkg_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;
-              migration_size += vpkg_size;
-              char* local_fv_addr = mem_region + cvt->header.remote_full_value_offset;
+  for (uint64_t k = bkt_begin; k < bkt_end; k++) {
+    char* cvt_start = table->GetTablePtr() + k * bkt_size;
 
-              other_mn_qps[target_mn_id]->post_send(IBV_WR_RDMA_WRITE, local_fv_addr, vpkg_size, cvt->header.remote_full_value_offset, IBV_SEND_SIGNALED);
-              write_cnt++;
+    for (int j = 0; j < SLOT_NUM[table_id]; j++) {
+      CVT* cvt = (CVT*)(cvt_start + j * CVTSize);
 
-              ibv_wc wc{};
-              other_mn_qps[target_mn_id]->poll_till_completion(wc, no_timeout);
+      if (!cvt->header.value_size) continue;
 
-              new_insert_cnt++;
-            }
-          }
-        }
+      if (cvt->header.remote_attribute_offset != UN_INIT_POS) {
+        ranges.emplace_back(cvt->header.remote_attribute_offset, ATTR_BAR_SIZE[table_id]);
+        stat.new_attr_bar_cnt++;
       }
 
-      break;
+      if (cvt->header.user_inserted) {
+        ranges.emplace_back(cvt->header.remote_full_value_offset, vpkg_size);
+        stat.new_insert_cnt++;
+      }
     }
   }
 
-  RDMA_LOG(INFO) << "[AcceptReq] Migrate SUCCESS: " << (double)migration_size / 1024.0 << " KB."
-                 << " Write cnt: " << write_cnt << ". new_attr_bar_cnt: " << new_attr_bar_cnt << ". new_insert_cnt: " << new_insert_cnt;
-
-  // while (write_cnt--) {
-  //   ibv_wc wc{};
-  //   other_mn_qps[target_mn_id]->poll_till_completion(wc, no_timeout);
-  // }
+  // Coalesce adjacent ranges, e.g., those allocated one after another by a coordinator
+  std::sort(ranges.begin(), ranges.end());
+
+  size_t r = 0;
+  while (r < ranges.size()) {
+    offset_t off = ranges[r].first;
+    size_t size = ranges[r].second;
+    r++;
+    while (r < ranges.size() &&
+           ranges[r].first == off + (offset_t)size &&
+           size + ranges[r].second <= MIGRATE_MAX_WRITE_SIZE) {
+      size += ranges[r].second;
+      r++;
+    }
+    writer.Write(mem_region + off, size, off);
+  }
 
-  char ack[] = "MIGRATE_OK";
-  send(from_client_socket, ack, strlen(ack) + 1, 0);
+  writer.Drain();
+}
 
-  free(recv_buf);
-  close(from_client_socket);
-  close(listen_socket);
+void Server::GetHashStores(std::string& workload, std::vector<HashStore*>& primary_tables, std::vector<HashStore*>& backup_tables) {
+  if (workload == "TATP") {
+    primary_tables = tatp_server->GetPrimaryHashStore();
+    backup_tables = tatp_server->GetBackupHashStore();
+  } else if (workload == "SmallBank") {
+    primary_tables = smallbank_server->GetPrimaryHashStore();
+    backup_tables = smallbank_server->GetBackupHashStore();
+  } else if (workload == "TPCC") {
+    primary_tables = tpcc_server->GetPrimaryHashStore();
+    backup_tables = tpcc_server->GetBackupHashStore();
+  } else if (workload == "MICRO") {
+    primary_tables = micro_server->GetPrimaryHashStore();
+    backup_tables = micro_server->GetBackupHashStore();
+  }
 }
 
 void Server::OutputMemoryFootprint(std::string& workload) {
@@ -622,7 +766,7 @@ bool Server::Run(std::string& workload) {
   // std::cerr << "Type c for another round, type q to exit :)" << std::endl;
 
 #if HAVE_PRIMARY_CRASH || HAVE_BACKUP_CRASH
-  AcceptReq();
+  AcceptReq(workload);
 #endif
 
   while (true) {
@@ -653,8 +797,28 @@ int main(int argc, char* argv[]) {
   std::string pm_root = local_node.get("pm_root").get_str();
   std::string workload = local_node.get("workload").get_str();
   auto reserve_GB = local_node.get("reserve_GB").get_uint64();
-  auto max_client_num_per_mn = local_node.get("max_client_num_per_mn").get_uint64();
-  auto per_thread_delta_size_MB = local_node.get("per_thread_delta_size_MB").get_uint64();
+  auto delta_pool_size_MB = local_node.get("delta_pool_size_MB").get_uint64();
+
+  // Backup number of each table. Tables not listed use the default
+  int table_backup_num[MAX_DB_TABLE_NUM];
+  auto backup_num_conf = local_node.get("table_backup_num");
+  int default_backup_num = BACKUP_NUM;
+  if (backup_num_conf.exists() && backup_num_conf.get("default").exists()) {
+    default_backup_num = (int)backup_num_conf.get("default").get_int64();
+  }
+  for (int table_id = 0; table_id < MAX_DB_TABLE_NUM; table_id++) {
+    table_backup_num[table_id] = default_backup_num;
+    if (backup_num_conf.exists() && backup_num_conf.get(std::to_string(table_id)).exists()) {
+      table_backup_num[table_id] = (int)backup_num_conf.get(std::to_string(table_id)).get_int64();
+    }
+    if (table_backup_num[table_id] < 0) {
+      RDMA_LOG(FATAL) << "Table " << table_id << " has a negative backup number";
+    }
+    if (table_backup_num[table_id] >= machine_num) {
+      RDMA_LOG(WARNING) << "Table " << table_id << " wants " << table_backup_num[table_id]
+                        << " backups, but only " << machine_num - 1 << " MNs are available";
+    }
+  }
 
   auto compute_nodes = json_config.get("remote_compute_nodes");
   auto compute_node_ips = compute_nodes.get("compute_node_ips");  // Array
@@ -663,8 +827,26 @@ int main(int argc, char* argv[]) {
   // std::string pm_file = pm_root + "pm_node" + std::to_string(machine_id); // Use fsdax
   std::string pm_file = pm_root;  // Use devdax
   size_t data_size = (size_t)1024 * 1024 * 1024 * reserve_GB;
-  size_t per_thread_delta_size = (size_t)1024 * 1024 * per_thread_delta_size_MB;
-  size_t delta_size = per_thread_delta_size * max_client_num_per_mn;
+  // The delta region is a pool shared by all the CN threads. They grab chunks on demand by FAA on the pool header,
+  // which is zeroed in InitMem
+  size_t delta_pool_size = (size_t)1024 * 1024 * delta_pool_size_MB;
+  size_t delta_size = delta_pool_size;
+
+  // Coordinator status slots for lease-based locks are placed after the delta region
+  offset_t status_start_off = data_size + delta_size;
+  delta_size += (size_t)MAX_CLIENT_NUM_PER_MN * MAX_CORO_NUM_PER_THREAD * sizeof(uint64_t);
+
+  // Followed by the GC watermark slots, one <min start time, min long reader start time, publish time> per CN thread, padded to 32B
+  delta_size += (size_t)MAX_CLIENT_NUM_PER_MN * 4 * sizeof(uint64_t);
+
+  // Followed by the retention floor of the AS OF readers, <floor << 16 | pin count, announced next floor>
+  delta_size += 2 * sizeof(uint64_t);
+
+  // Followed by the lease epoch counter, and the redo logs of the coordinators with lease-based locks
+  delta_size += sizeof(uint64_t);
+#if LEASE_LOCK
+  delta_size += (size_t)MAX_CLIENT_NUM_PER_MN * MAX_CORO_NUM_PER_THREAD * REDO_LOG_SIZE;
+#endif
 
   auto server = std::make_shared<Server>(machine_id,
                                          local_port,
@@ -682,8 +864,8 @@ int main(int argc, char* argv[]) {
   server->ConnectMN();
 #endif
 
-  server->LoadData(machine_id, machine_num, workload);
-  server->SendMeta(machine_id, workload, compute_node_num, data_size, per_thread_delta_size);
+  server->LoadData(machine_id, machine_num, table_backup_num, workload);
+  server->SendMeta(machine_id, workload, compute_node_num, data_size, delta_pool_size, status_start_off);
   bool run_next_round = server->Run(workload);
 
   // Continue to run the next round. RDMA does not need to be inited twice
@@ -696,8 +878,8 @@ int main(int argc, char* argv[]) {
     server->ConnectMN();
 #endif
 
-    server->LoadData(machine_id, machine_num, workload);
-    server->SendMeta(machine_id, workload, compute_node_num, data_size, per_thread_delta_size);
+    server->LoadData(machine_id, machine_num, table_backup_num, workload);
+    server->SendMeta(machine_id, workload, compute_node_num, data_size, delta_pool_size, status_start_off);
     run_next_round = server->Run(workload);
   }
 
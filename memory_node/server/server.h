@@ -21,6 +21,19 @@
 
 using namespace rdmaio;
 
+/*********************** Table migration for recovery **********************/
+const int MIGRATE_THREAD_NUM = 4;  // Each thread migrates a part of the table via its own QP to the target MN
+const int MIGRATE_SIGNAL_INTERVAL = 64;  // Signal one of every these writes
+const int MIGRATE_MAX_PENDING_SIGNALS = 8;  // MIGRATE_SIGNAL_INTERVAL * this should be below the send queue depth
+const size_t MIGRATE_MAX_WRITE_SIZE = (size_t)1024 * 1024;  // Coalesced writes are no larger than this
+
+struct MigrateStat {
+  size_t migration_size = 0;
+  int write_cnt = 0;
+  int new_attr_bar_cnt = 0;
+  int new_insert_cnt = 0;
+};
+
 class Server {
  public:
   Server(int nid,
@@ -83,24 +96,33 @@ class Server {
 
   void ConnectMN();
 
-  void LoadData(node_id_t machine_id, node_id_t machine_num, std::string& workload);
+  void LoadData(node_id_t machine_id, node_id_t machine_num, const int* table_backup_num, std::string& workload);
+
+  void ReportReplication(node_id_t machine_num, const int* table_backup_num, size_t loaded_mem, std::string& workload);
 
   void SendMeta(node_id_t machine_id,
                 std::string& workload,
                 size_t compute_node_num,
                 offset_t delta_start_off,
-                size_t per_thread_delta_size);
+                size_t delta_pool_size,
+                offset_t status_start_off);
 
   void PrepareHashMeta(node_id_t machine_id,
                        std::string& workload,
                        char** hash_meta_buffer,
                        size_t& total_meta_size,
                        offset_t delta_start_off,
-                       size_t per_thread_delta_size);
+                       size_t delta_pool_size,
+                       offset_t status_start_off);
 
   void SendHashMeta(char* hash_meta_buffer, size_t& total_meta_size);
 
-  void AcceptReq();
+  void AcceptReq(std::string& workload);
+
+  // Copy buckets [bkt_begin, bkt_end) of the table, and the delta-region data they point to, to the same offsets in the target MN
+  void MigrateBuckets(HashStore* table, RCQP* qp, uint64_t bkt_begin, uint64_t bkt_end, MigrateStat& stat);
+
+  void GetHashStores(std::string& workload, std::vector<HashStore*>& primary_tables, std::vector<HashStore*>& backup_tables);
 
   void CleanTable();
 
@@ -148,5 +170,5 @@ class Server {
 
   std::unordered_map<node_id_t, MemoryAttr> other_mn_mrs;
 
-  RCQP* other_mn_qps[MAX_REMOTE_NODE_NUM]{nullptr};
+  RCQP* other_mn_qps[MAX_REMOTE_NODE_NUM][MIGRATE_THREAD_NUM]{{nullptr}};
 };
@@ -3,23 +3,28 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
 #include "allocator/region_allocator.h"
 #include "base/common.h"
+#include "process/watermark.h"
+#include "scheduler/corotine_scheduler.h"
 
 // Alloc registered RDMA buffer for each thread
 class LocalBufferAllocator {
  public:
-  LocalBufferAllocator(char* s, char* e) : start(s), end(e), cur_offset(0) {}
+  LocalBufferAllocator(char* s, char* e) : start(s), end(e), cur_offset(0), reserved_end(e) {}
 
   ALWAYS_INLINE
   char* Alloc(int64_t size) {
     // When the thread local region is exhausted, the region
-    // can be re-used (i.e., overwritten) at the front offset, i.e., 0. This is almost always true,
-    // because the local region is typically GB-scale, and hence the front
-    // allocated buffer has already finished serving for RDMA requests and replies, or has already aborted.
-    // As such, our Allocator is extremely fast due to simply moving the pointer.
-    // If anyone relies on a more reliable allocator, you can just re-implement this Alloc interface
-    // using other standard allocators, e.g., ptmalloc/jemalloc/tcmalloc.
+    // can be re-used (i.e., overwritten) at the front offset, i.e., 0.
+    // This is only used outside transactions, e.g., for staging the table cache, where each buffer
+    // has finished serving before the next allocation. Transactions use CoroBufferAllocator.
 
     assert(size > 0);
 
@@ -37,75 +42,300 @@ class LocalBufferAllocator {
     // explicitly deallocate the previously allocated memory region buffer.
   }
 
+  // Carve a buffer that is never reused by Alloc from the end of the region.
+  // Used for the per-coroutine rings and the buffers that outlive a transaction
+  char* Reserve(size_t size) {
+    size = (size + 7) & ~((size_t)7);
+    if (start + cur_offset + size > end) {
+      RDMA_LOG(FATAL) << "Thread local RDMA region is exhausted when reserving " << size << " B. Enlarge PER_THREAD_SHARED_ALLOC_SIZE";
+    }
+    end -= size;
+    return end;
+  }
+
+  size_t ReservedSize() const {
+    return reserved_end - end;
+  }
+
  private:
   // Each thread has a local RDMA region to temporarily alloc a small buffer.
   // This local region has an address range: [start, end)
   char* start;
   char* end;
   uint64_t cur_offset;
+  char* reserved_end;  // The end before any reservation
 };
 
-// Used for a thread to allocate a remote offset to append a full value or attributes into remote delta region
-
-// When writing remote replicas, a coordinator should use the offset provided
-// by NextDeltaOffset plus the remote delta region's start address to form
-// a writable address. The remote delta region's start address is recorded in the meta manager
-class RemoteDeltaOffsetAllocator {
+// Alloc registered RDMA buffer for each coroutine from a small ring. Unlike LocalBufferAllocator,
+// a buffer is never reused while the NIC may still access it:
+// The buffers of a transaction are retired when the coroutine begins its next transaction,
+// and they are freed once all the requests posted by the coroutine so far have completed.
+// The ring never overwrites a live buffer. It fails if one transaction needs more than the ring.
+//
+// This relies on the requests that use the ring being signaled, i.e., counted by the scheduler.
+// An unsignaled request must use a buffer from LocalBufferAllocator::Reserve
+class CoroBufferAllocator {
  public:
-  RemoteDeltaOffsetAllocator(const std::unordered_map<node_id_t, DeltaRange>& thread_delta_region) {
-    for (int i = 0; i < MAX_REMOTE_NODE_NUM; i++) {
-      starts[i] = 0;
-      ends[i] = 0;
-      cur_offsets[i] = 0;
-    }
+  CoroBufferAllocator(char* s, size_t size, CoroutineScheduler* sched, coro_id_t cid)
+      : start(s), capacity(size), coro_sched(sched), coro_id(cid),
+        head(0), cur_offset(0), retired_offset(0), is_empty(true), has_retired(false), txn_allocated(false) {}
+
+  // Retire the buffers of the previous transactions
+  ALWAYS_INLINE
+  void BeginTxn() {
+    retired_offset = cur_offset;
+    has_retired = true;
+    txn_allocated = false;
+    TryRelease();
+  }
 
-    cur_offset = 0;
+  ALWAYS_INLINE
+  char* Alloc(int64_t size) {
+    assert(size > 0);
+    size_t sz = ((size_t)size + 7) & ~((size_t)7);
 
-    for (const auto& node : thread_delta_region) {
-      starts[node.first] = node.second.start;
-      ends[node.first] = node.second.end;
+    TryRelease();
 
-      start = node.second.start;
-      end = node.second.end;
+    if (is_empty) {
+      head = 0;
+      cur_offset = 0;
     }
+
+    size_t off;
+    if (!is_empty && cur_offset == head) {
+      // Full
+      off = capacity;
+    } else if (is_empty || cur_offset > head) {
+      // Live buffers are in [head, cur_offset)
+      if (cur_offset + sz <= capacity) {
+        off = cur_offset;
+      } else if (sz <= head) {
+        off = 0;  // Wrap around. The tail [cur_offset, capacity) is skipped
+      } else {
+        off = capacity;
+      }
+    } else {
+      // Live buffers are in [head, capacity) and [0, cur_offset)
+      off = (cur_offset + sz <= head) ? cur_offset : capacity;
+    }
+
+    if (unlikely(off == capacity)) {
+      RDMA_LOG(FATAL) << "Coroutine " << coro_id << " RDMA buffer is exhausted when allocating " << sz
+                      << " B. Enlarge PER_CORO_ALLOC_SIZE";
+    }
+
+    cur_offset = off + sz;
+    if (cur_offset == capacity) cur_offset = 0;
+    is_empty = false;
+    txn_allocated = true;
+    return start + off;
   }
 
+  size_t Capacity() const {
+    return capacity;
+  }
+
+ private:
+  // All the requests posted before the current transaction have completed if the coroutine
+  // has no pending request now
   ALWAYS_INLINE
-  uintptr_t NextDeltaOffset(node_id_t mn_id, size_t write_size) {
-    if (unlikely(starts[mn_id] + cur_offsets[mn_id] + write_size > ends[mn_id])) {
-      RDMA_LOG(FATAL) << "Delta buffer not enough for this thread!";
+  void TryRelease() {
+    if (!has_retired || coro_sched->PendingCount(coro_id) != 0) {
+      return;
     }
+    head = retired_offset;
+    has_retired = false;
+    if (head == cur_offset && !txn_allocated) {
+      is_empty = true;
+    }
+  }
 
-    uintptr_t ret = starts[mn_id] + cur_offsets[mn_id];
-    cur_offsets[mn_id] += write_size;
+  char* start;
+  size_t capacity;
+  CoroutineScheduler* coro_sched;
+  coro_id_t coro_id;
 
-    return ret;
+  size_t head;            // The oldest live buffer
+  size_t cur_offset;      // Where the next buffer is allocated
+  size_t retired_offset;  // Where the current transaction's buffers start
+  bool is_empty;
+  bool has_retired;
+  bool txn_allocated;  // Whether the current transaction has allocated any buffer
+};
+
+// Used for a thread to allocate a remote offset to append a full value or attributes into remote delta region
+
+// The delta region of memory nodes is a pool shared by all the threads. A thread grabs a chunk of it
+// by FAA on the pool header (see TXN::EnsureDeltaSpace), and allocates from its current chunk.
+// Delta offsets are the same in all memory nodes, so they are written to all the replicas the same way.
+// The chunk size grows for the threads that consume chunks quickly, and shrinks for the idle ones
+class RemoteDeltaOffsetAllocator {
+ public:
+  RemoteDeltaOffsetAllocator(const TxnWatermark* txn_watermark = nullptr, const GCWatermark* thread_gc_watermark = nullptr)
+      : watermark(txn_watermark), gc_watermark(thread_gc_watermark), cached_watermark(0), reclaim_check_cnt(0), retired_size(0), reused_size(0),
+        cur(0), end(0), chunk_size(DELTA_CHUNK_MIN_SIZE), consumed_size(0), grabbed_size(0), chunk_num(0) {}
+
+  // Whether the current chunk holds size bytes
+  ALWAYS_INLINE
+  bool CanAlloc(size_t size) const {
+    return cur + size <= end;
+  }
+
+  // Size of the next chunk to grab, which holds at least need bytes
+  ALWAYS_INLINE
+  size_t NextChunkSize(size_t need) const {
+    return need > chunk_size ? ((need + 7) & ~((size_t)7)) : chunk_size;
+  }
+
+  // The rest of the current chunk is dropped
+  void AddChunk(uintptr_t chunk_start, size_t size) {
+    auto now = std::chrono::steady_clock::now();
+    if (chunk_num > 0) {
+      auto used_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_chunk_time).count();
+      if (used_ms < DELTA_CHUNK_FAST_MS && chunk_size < DELTA_CHUNK_MAX_SIZE) {
+        chunk_size *= 2;
+      } else if (used_ms > DELTA_CHUNK_SLOW_MS && chunk_size > DELTA_CHUNK_MIN_SIZE) {
+        chunk_size /= 2;
+      }
+    }
+    last_chunk_time = now;
+
+    cur = chunk_start;
+    end = chunk_start + size;
+    grabbed_size += size;
+    chunk_num++;
   }
 
-  // Write to all MNs the same way
+  // Write to all MNs the same way. A reclaimed block of the same size is reused first
   ALWAYS_INLINE
   uintptr_t NextDeltaOffset(size_t write_size) {
-    if (unlikely(start + cur_offset + write_size > end)) {
-      RDMA_LOG(FATAL) << "Delta buffer not enough for this thread! Current usage: " << (double)(cur_offset + write_size) / 1024 / 1024 << " MB delta space";
+    if (!retired.empty()) {
+      Reclaim();
     }
 
-    uintptr_t ret = start + cur_offset;
-    cur_offset += write_size;
+    auto free_list = free_lists.find(write_size);
+    if (free_list != free_lists.end() && !free_list->second.empty()) {
+      uintptr_t ret = free_list->second.back();
+      free_list->second.pop_back();
+      reused_size += write_size;
+      return ret;
+    }
+
+    if (unlikely(!CanAlloc(write_size))) {
+      // The committing txn has ensured the space before writing
+      RDMA_LOG(FATAL) << "Delta chunk not enough for this thread! Current usage: " << (double)(consumed_size + write_size) / 1024 / 1024 << " MB delta space";
+    }
+
+    uintptr_t ret = cur;
+    cur += write_size;
+    consumed_size += write_size;
 
     return ret;
   }
 
+  // The block [offset, offset + size) is unlinked from the CVTs, and the unlinking writes have completed
+  // before unlink_ts is taken. It is reused once no running txn has started by unlink_ts.
+  // The block may be allocated by any thread, since the delta regions are at the same offsets in all MNs
+  ALWAYS_INLINE
+  void Retire(uintptr_t offset, size_t size, tx_id_t unlink_ts) {
+    if (!watermark) return;
+    retired.push_back(RetiredDelta{offset, size, unlink_ts});
+    retired_size += size;
+  }
+
+  // The consumed delta space, i.e., the high water of allocation
   ALWAYS_INLINE
   double GetDeltaUsage() {
-    return (double)cur_offset / 1024 / 1024;
+    return (double)consumed_size / 1024 / 1024;
+  }
+
+  // The delta space grabbed from the pool
+  ALWAYS_INLINE
+  double GetGrabbedDelta() {
+    return (double)grabbed_size / 1024 / 1024;
+  }
+
+  ALWAYS_INLINE
+  int GetChunkNum() {
+    return chunk_num;
+  }
+
+  ALWAYS_INLINE
+  double GetReusedDelta() {
+    return (double)reused_size / 1024 / 1024;
+  }
+
+  ALWAYS_INLINE
+  double GetRetiredDelta() {
+    return (double)retired_size / 1024 / 1024;
   }
 
  private:
-  uintptr_t starts[MAX_REMOTE_NODE_NUM];
-  uintptr_t ends[MAX_REMOTE_NODE_NUM];
-  uintptr_t cur_offsets[MAX_REMOTE_NODE_NUM];
+  // The retired blocks are in unlink order. Move the ones below the watermark to the free lists.
+  // The watermark is recomputed only every DELTA_RECLAIM_INTERVAL attempts, since it scans all coordinators
+  ALWAYS_INLINE
+  void Reclaim() {
+    if (retired.front().unlink_ts >= cached_watermark) {
+      if (++reclaim_check_cnt < DELTA_RECLAIM_INTERVAL) return;
+      reclaim_check_cnt = 0;
+      cached_watermark = gc_watermark ? ClusterWatermark() : watermark->Compute();
+    }
 
-  uintptr_t start;
+    while (!retired.empty() && retired.front().unlink_ts < cached_watermark) {
+      RetiredDelta& r = retired.front();
+      free_lists[r.size].push_back(r.offset);
+      retired_size -= r.size;
+      retired.pop_front();
+    }
+  }
+
+  // The long readers are excluded from the GC watermark, but they may still read an unlinked block, and so may
+  // the AS OF readers at the retention floor. Nothing is reclaimed before the first refresh completes
+  ALWAYS_INLINE
+  tx_id_t ClusterWatermark() const {
+    tx_id_t gc_ts = gc_watermark->GetReclaim();
+    tx_id_t long_ts = gc_watermark->GetLong();
+    if (gc_ts == GCWatermark::UNKNOWN || long_ts == GCWatermark::UNKNOWN) {
+      return 0;
+    }
+    return std::min(gc_ts, long_ts);
+  }
+
+  struct RetiredDelta {
+    uintptr_t offset;
+    size_t size;
+    tx_id_t unlink_ts;
+  };
+
+  static const int DELTA_RECLAIM_INTERVAL = 64;
+
+  const TxnWatermark* watermark;  // nullptr if reclamation is disabled
+
+  // The txns in the other CNs read the blocks too. If set, the cluster-wide watermark is used instead
+  const GCWatermark* gc_watermark;
+
+  tx_id_t cached_watermark;
+
+  int reclaim_check_cnt;
+
+  std::deque<RetiredDelta> retired;
+
+  std::unordered_map<size_t, std::vector<uintptr_t>> free_lists;  // <block size, offsets>
+
+  size_t retired_size;
+
+  size_t reused_size;
+
+  uintptr_t cur;  // The current chunk is [cur, end)
   uintptr_t end;
-  size_t cur_offset;
+
+  size_t chunk_size;
+
+  std::chrono::steady_clock::time_point last_chunk_time;
+
+  size_t consumed_size;
+
+  size_t grabbed_size;
+
+  int chunk_num;
 };
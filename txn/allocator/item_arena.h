@@ -0,0 +1,104 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+
+#include "base/common.h"
+#include "rlib/logging.hpp"
+
+const size_t ITEM_ARENA_CHUNK_SIZE = (size_t)64 * 1024;
+
+// A per-coroutine bump allocator for the data set items of one transaction.
+// All the items are released together when the next transaction begins. The chunks are kept
+// across transactions, so no heap allocation occurs once the largest transaction has run
+class ItemArena {
+ public:
+  ItemArena() : cur_chunk(0), cur_off(0) {}
+
+  ~ItemArena() {
+    for (auto& chunk : chunks) {
+      free(chunk.first);
+    }
+  }
+
+  ALWAYS_INLINE
+  void* Alloc(size_t size) {
+    size = (size + 7) & ~((size_t)7);
+
+    while (cur_chunk < chunks.size()) {
+      if (cur_off + size <= chunks[cur_chunk].second) {
+        void* p = chunks[cur_chunk].first + cur_off;
+        cur_off += size;
+        return p;
+      }
+      cur_chunk++;
+      cur_off = 0;
+    }
+
+    // Grow. A larger-than-chunk request gets its own chunk
+    size_t chunk_size = size > ITEM_ARENA_CHUNK_SIZE ? size : ITEM_ARENA_CHUNK_SIZE;
+    char* chunk = (char*)malloc(chunk_size);
+    if (chunk == nullptr) {
+      RDMA_LOG(FATAL) << "Item arena alloc fails, size (B): " << chunk_size;
+    }
+    chunks.emplace_back(chunk, chunk_size);
+    cur_chunk = chunks.size() - 1;
+    cur_off = size;
+    return chunk;
+  }
+
+  ALWAYS_INLINE
+  void Reset() {
+    cur_chunk = 0;
+    cur_off = 0;
+  }
+
+ private:
+  std::vector<std::pair<char*, size_t>> chunks;  // <start, size>
+
+  size_t cur_chunk;
+
+  size_t cur_off;
+};
+
+// Used by std::allocate_shared, so that an item and its control block are placed in the arena.
+// Deallocation is a no-op, since the arena is reset as a whole
+template <typename T>
+struct ArenaAllocator {
+  using value_type = T;
+
+  ArenaAllocator(ItemArena* a) : arena(a) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+  T* allocate(size_t n) {
+    return (T*)arena->Alloc(n * sizeof(T));
+  }
+
+  void deallocate(T* p, size_t n) {}
+
+  ItemArena* arena;
+};
+
+// Used with ArenaAllocator for the objects placed in the arena by hand, e.g., the ones shorter than sizeof(T).
+// Only the destructor runs, and the memory is reclaimed when the arena is reset
+template <typename T>
+struct ArenaDeleter {
+  void operator()(T* p) const {
+    p->~T();
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena != b.arena;
+}
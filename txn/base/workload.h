@@ -67,6 +67,14 @@ constexpr size_t ATTR_BAR_SIZE[TPCC_TOTAL_TABLES] = {
 constexpr size_t SLOT_NUM[TPCC_TOTAL_TABLES] = {
     1, 1, 3, 15, 15, 15, 15, 1, 4, 1, 15};
 
+// Tables never written after loading. They can be cached in compute nodes
+constexpr bool READ_ONLY_TABLE[TPCC_TOTAL_TABLES] = {
+    false, false, false, false, false, false, false, true, false, false, false};
+
+// Tables whose records are read far more than written. Their versions can be cached in compute nodes
+constexpr bool READ_MOSTLY_TABLE[TPCC_TOTAL_TABLES] = {
+    true, true, false, false, false, false, false, false, false, false, false};
+
 constexpr int ATTRIBUTE_NUM[TPCC_TOTAL_TABLES] = {8, 9, 18, 3, 1, 5, 6, 4, 6, 1, 1};
 
 constexpr int ATTR_SIZE[TPCC_TOTAL_TABLES][MAX_ATTRIBUTE_NUM_PER_TABLE] = {
@@ -170,6 +178,14 @@ constexpr size_t TABLE_VALUE_SIZE[TATP_TOTAL_TABLES] =
 constexpr size_t SLOT_NUM[TATP_TOTAL_TABLES] = {
     1, 5, 5, 5, 5};
 
+// Tables never written after loading. They can be cached in compute nodes
+constexpr bool READ_ONLY_TABLE[TATP_TOTAL_TABLES] = {
+    false, true, false, true, false};
+
+// Tables whose records are read far more than written. Their versions can be cached in compute nodes
+constexpr bool READ_MOSTLY_TABLE[TATP_TOTAL_TABLES] = {
+    true, false, false, false, false};
+
 constexpr size_t ATTR_BAR_SIZE[TATP_TOTAL_TABLES] = {
     4 * MAX_VCELL_NUM + 2 * 1,  // according to the frequency
     0,
@@ -216,6 +232,14 @@ constexpr size_t TABLE_VALUE_SIZE[SmallBank_TOTAL_TABLES] = {
 constexpr size_t SLOT_NUM[SmallBank_TOTAL_TABLES] = {
     1, 1};
 
+// Tables never written after loading. They can be cached in compute nodes
+constexpr bool READ_ONLY_TABLE[SmallBank_TOTAL_TABLES] = {
+    false, false};
+
+// Tables whose records are read far more than written. Their versions can be cached in compute nodes
+constexpr bool READ_MOSTLY_TABLE[SmallBank_TOTAL_TABLES] = {
+    false, false};
+
 constexpr size_t ATTR_BAR_SIZE[SmallBank_TOTAL_TABLES] = {
     // fixed
     sizeof(smallbank_savings_val_t::bal) * MAX_VCELL_NUM,
@@ -234,6 +258,12 @@ constexpr int ATTR_SIZE[SmallBank_TOTAL_TABLES][MAX_ATTRIBUTE_NUM_PER_TABLE] = {
 constexpr size_t TABLE_VALUE_SIZE[MICRO_TOTAL_TABLES] = {sizeof(micro_val_t)};
 constexpr size_t SLOT_NUM[MICRO_TOTAL_TABLES] = {1};
 
+// Tables never written after loading. They can be cached in compute nodes
+constexpr bool READ_ONLY_TABLE[MICRO_TOTAL_TABLES] = {false};
+
+// Tables whose records are read far more than written. Their versions can be cached in compute nodes
+constexpr bool READ_MOSTLY_TABLE[MICRO_TOTAL_TABLES] = {false};
+
 constexpr size_t ATTR_BAR_SIZE[MICRO_TOTAL_TABLES] = {
     // fixed
     sizeof(micro_val_t::d2) * MAX_VCELL_NUM,
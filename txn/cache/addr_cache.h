@@ -3,127 +3,201 @@
 
 #pragma once
 
-#include <map>
-#include <unordered_map>
+#include <atomic>
 
 #include "base/common.h"
-
-struct TableKeyDesc {
-  table_id_t table_id;
-  itemkey_t key;
-  offset_t remote_offset;
-  std::string desc;
-  int tx_id;
-};
-
-// For fast remote address lookup
+#include "util/hash.h"
+
+// Number of entries in one set of the address cache. A set spans a few cache lines
+const int ADDR_CACHE_WAYS = 8;
+
+// For fast remote address lookup. It is shared by all the threads in a CN and has a fixed
+// number of entries. Entries are grouped into sets by <table_id, key>, and a full set evicts
+// with CLOCK: a hit marks the entry referenced, and the clock hand skips (and clears) the
+// referenced entries once. Like VersionCache, each entry is guarded by a sequence number
+// (odd = being written). Readers retry nothing and writers never wait: a torn read is a miss,
+// and an insertion into an entry being written by others is skipped.
+//
+// The full value's offset rarely changes (only on insert), so it is cached together with
+// the CVT's offset. Then the CVT and the full value can be read in one round trip.
+// A stale address is overwritten with NOT_FOUND, i.e., a negative entry, which tells the
+// readers to locate the key by a hash read
 class AddrCache {
  public:
-  void Insert(node_id_t remote_node_id,
-              table_id_t table_id,
-              itemkey_t key,
-              offset_t remote_offset) {
-    auto node_search = addr_map.find(remote_node_id);
-    if (node_search == addr_map.end()) {
-      // There is no such node. Init the node and table
-      addr_map[remote_node_id] = std::unordered_map<table_id_t, std::unordered_map<itemkey_t, offset_t>>();
-      addr_map[remote_node_id][table_id] = std::unordered_map<itemkey_t, offset_t>();
-    } else if (node_search->second.find(table_id) == node_search->second.end()) {
-      // The node exists, but the table does not exist. Init the table
-      addr_map[remote_node_id][table_id] = std::unordered_map<itemkey_t, offset_t>();
+  AddrCache(size_t num) {
+    set_num = (num + ADDR_CACHE_WAYS - 1) / ADDR_CACHE_WAYS;
+    if (set_num == 0) set_num = 1;
+    sets = new Set[set_num];
+    for (size_t i = 0; i < set_num; i++) {
+      sets[i].hand.store(0, std::memory_order_relaxed);
+      for (int w = 0; w < ADDR_CACHE_WAYS; w++) {
+        Entry& e = sets[i].entries[w];
+        e.seq.store(0, std::memory_order_relaxed);
+        e.referenced.store(0, std::memory_order_relaxed);
+        e.used = false;
+      }
     }
+  }
 
-    // The node and table both exist, then insert/update the <key,offset> pair
-    addr_map[remote_node_id][table_id][key] = remote_offset;
+  ~AddrCache() {
+    delete[] sets;
   }
-  
-  // For Debug usage
+
+  ALWAYS_INLINE
   void Insert(node_id_t remote_node_id,
               table_id_t table_id,
               itemkey_t key,
               offset_t remote_offset,
-              const std::string& desc,
-              int tx_id) {
-    auto node_search = addr_map.find(remote_node_id);
-    if (node_search == addr_map.end()) {
-      // There is no such node. Init the node and table
-      addr_map[remote_node_id] = std::unordered_map<table_id_t, std::unordered_map<itemkey_t, offset_t>>();
-      addr_cache_desc[remote_node_id] = std::unordered_map<table_id_t, std::unordered_map<itemkey_t, std::string>>();
-
-      addr_map[remote_node_id][table_id] = std::unordered_map<itemkey_t, offset_t>();
-      addr_cache_desc[remote_node_id][table_id] = std::unordered_map<itemkey_t, std::string>();
-    } else if (node_search->second.find(table_id) == node_search->second.end()) {
-      // The node exists, but the table does not exist. Init the table
-      addr_map[remote_node_id][table_id] = std::unordered_map<itemkey_t, offset_t>();
-      addr_cache_desc[remote_node_id][table_id] = std::unordered_map<itemkey_t, std::string>();
+              offset_t remote_full_value_offset = NOT_FOUND) {
+    Set& set = sets[Index(table_id, key)];
+
+    // Update the existing entry of this key, or take a victim
+    Entry* target = nullptr;
+    for (int w = 0; w < ADDR_CACHE_WAYS; w++) {
+      Entry& e = set.entries[w];
+      if (e.used && e.key == key && e.table_id == table_id && e.node_id == remote_node_id) {
+        target = &e;
+        break;
+      }
     }
 
-    // The node and table both exist, then insert/update the <key,offset> pair
-    addr_map[remote_node_id][table_id][key] = remote_offset;
-    addr_cache_desc[remote_node_id][table_id][key] = desc;
-    table_key.emplace_back(TableKeyDesc{.table_id = table_id, .key = key, .remote_offset = remote_offset, .desc = desc, .tx_id = tx_id});
+    if (target == nullptr) {
+      target = Evict(set);
+    }
+
+    if (!BeginWrite(*target)) return;
+
+    target->node_id = remote_node_id;
+    target->table_id = table_id;
+    target->key = key;
+    target->remote_offset = remote_offset;
+    target->remote_full_value_offset = remote_full_value_offset;
+    target->used = true;
+
+    EndWrite(*target);
+
+    // Concurrent misses of this key may take different victims. Each writer drops the other copies after its
+    // own write, so at most one copy is left. A copy being written is dropped by its writer
+    DropDuplicates(set, target, remote_node_id, table_id, key);
   }
 
   // We know which node to read, but we do not konw whether it is cached before
-  offset_t Search(node_id_t remote_node_id, table_id_t table_id, itemkey_t key) {
-    auto node_search = addr_map.find(remote_node_id);
-    if (node_search == addr_map.end()) return NOT_FOUND;
-    auto table_search = node_search->second.find(table_id);
-    if (table_search == node_search->second.end()) return NOT_FOUND;
-    auto offset_search = table_search->second.find(key);
-    return offset_search == table_search->second.end() ? NOT_FOUND : offset_search->second;
+  ALWAYS_INLINE
+  offset_t Search(node_id_t remote_node_id, table_id_t table_id, itemkey_t key) const {
+    offset_t remote_full_value_offset;
+    return Search(remote_node_id, table_id, key, remote_full_value_offset);
   }
 
-  std::string Desc(node_id_t remote_node_id, table_id_t table_id, itemkey_t key) {
-    auto node_search = addr_cache_desc.find(remote_node_id);
-    if (node_search == addr_cache_desc.end()) return "NOT_FOUND";
-    auto table_search = node_search->second.find(table_id);
-    if (table_search == node_search->second.end()) return "NOT_FOUND";
-    auto offset_search = table_search->second.find(key);
-    return offset_search == table_search->second.end() ? "NOT_FOUND" : offset_search->second;
-  }
+  // Also get the cached full value's offset, which is NOT_FOUND if unknown
+  ALWAYS_INLINE
+  offset_t Search(node_id_t remote_node_id, table_id_t table_id, itemkey_t key, offset_t& remote_full_value_offset) const {
+    remote_full_value_offset = NOT_FOUND;
+    Set& set = sets[Index(table_id, key)];
 
-  // If we have read this record, we do not read it from another node
-  void Search(table_id_t query_table_id, itemkey_t query_key, node_id_t& remote_node_id, offset_t& remote_offset) {
-    // look up node first
-    for (auto it = addr_map.begin(); it != addr_map.end(); it++) {
-      auto table_search = it->second.find(query_table_id);
-      if (table_search == it->second.end()) {
-        continue;
-      }
+    for (int w = 0; w < ADDR_CACHE_WAYS; w++) {
+      Entry& e = set.entries[w];
+
+      uint64_t seq = e.seq.load(std::memory_order_acquire);
+      if (seq & 1) continue;
+
+      bool used = e.used;
+      node_id_t node_id = e.node_id;
+      table_id_t cached_table_id = e.table_id;
+      itemkey_t cached_key = e.key;
+      offset_t remote_offset = e.remote_offset;
+      offset_t fv_off = e.remote_full_value_offset;
 
-      auto offset_search = table_search->second.find(query_key);
-      if (offset_search == table_search->second.end()) {
-        // No such key. Change to hash read
-        return;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (e.seq.load(std::memory_order_relaxed) != seq) continue;
+
+      if (used && cached_key == key && cached_table_id == table_id && node_id == remote_node_id) {
+        // Avoid writing the shared line if it is already referenced
+        if (!e.referenced.load(std::memory_order_relaxed)) {
+          e.referenced.store(1, std::memory_order_relaxed);
+        }
+        remote_full_value_offset = fv_off;
+        return remote_offset;
       }
+    }
+
+    return NOT_FOUND;
+  }
+
+  size_t TotalSize() const {
+    return set_num * sizeof(Set);
+  }
+
+ private:
+  struct Entry {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint8_t> referenced;  // CLOCK bit
+    bool used;
+    node_id_t node_id;
+    table_id_t table_id;
+    itemkey_t key;
+    offset_t remote_offset;             // NOT_FOUND for a negative entry
+    offset_t remote_full_value_offset;  // NOT_FOUND if unknown
+  };
+
+  struct Set {
+    std::atomic<uint32_t> hand;  // CLOCK hand
+    Entry entries[ADDR_CACHE_WAYS];
+  };
+
+  ALWAYS_INLINE
+  size_t Index(table_id_t table_id, itemkey_t key) const {
+    return MurmurHash64A(key, (unsigned int)table_id) % set_num;
+  }
 
-      // Tableid and key match. Get the cached remote node id and remote offset
-      remote_node_id = it->first;
-      remote_offset = offset_search->second;
-      return;
+  // Give an empty entry, or the first unreferenced one under the clock hand. Each entry is
+  // passed at most twice, so this terminates even if others keep referencing the set
+  ALWAYS_INLINE
+  Entry* Evict(Set& set) {
+    for (int w = 0; w < ADDR_CACHE_WAYS; w++) {
+      if (!set.entries[w].used) return &set.entries[w];
     }
+
+    for (int i = 0; i < 2 * ADDR_CACHE_WAYS; i++) {
+      Entry& e = set.entries[set.hand.fetch_add(1, std::memory_order_relaxed) % ADDR_CACHE_WAYS];
+      if (!e.referenced.load(std::memory_order_relaxed)) {
+        return &e;
+      }
+      e.referenced.store(0, std::memory_order_relaxed);
+    }
+
+    return &set.entries[set.hand.load(std::memory_order_relaxed) % ADDR_CACHE_WAYS];
   }
 
-  size_t TotalAddrSize() {
-    size_t total_size = 0;
-    for (auto it = addr_map.begin(); it != addr_map.end(); it++) {
-      total_size += sizeof(node_id_t);
-      for (auto it2 = it->second.begin(); it2 != it->second.end(); it2++) {
-        total_size += sizeof(table_id_t);
-        for (auto it3 = it2->second.begin(); it3 != it2->second.end(); it3++) {
-          total_size += (sizeof(itemkey_t) + sizeof(offset_t));
-        }
+  ALWAYS_INLINE
+  void DropDuplicates(Set& set, Entry* keep, node_id_t remote_node_id, table_id_t table_id, itemkey_t key) {
+    for (int w = 0; w < ADDR_CACHE_WAYS; w++) {
+      Entry& e = set.entries[w];
+      if (&e == keep || !e.used || e.key != key || e.table_id != table_id || e.node_id != remote_node_id) continue;
+      if (!BeginWrite(e)) continue;
+      // Recheck, since it may be overwritten before I lock it
+      if (e.used && e.key == key && e.table_id == table_id && e.node_id == remote_node_id) {
+        e.used = false;
       }
+      EndWrite(e);
     }
+  }
 
-    return total_size;
+  ALWAYS_INLINE
+  bool BeginWrite(Entry& e) {
+    uint64_t seq = e.seq.load(std::memory_order_relaxed);
+    if (seq & 1) return false;
+    if (!e.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) return false;
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
   }
 
-  std::vector<TableKeyDesc> table_key;
+  ALWAYS_INLINE
+  void EndWrite(Entry& e) {
+    e.referenced.store(0, std::memory_order_relaxed);
+    e.seq.fetch_add(1, std::memory_order_release);
+  }
 
+  Set* sets;
 
- private:
-  std::unordered_map<node_id_t, std::unordered_map<table_id_t, std::unordered_map<itemkey_t, offset_t>>> addr_map;
-  std::unordered_map<node_id_t, std::unordered_map<table_id_t, std::unordered_map<itemkey_t, std::string>>> addr_cache_desc;
-};
\ No newline at end of file
+  size_t set_num;
+};
@@ -0,0 +1,154 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "allocator/buffer_allocator.h"
+#include "base/common.h"
+#include "base/workload.h"
+#include "connection/meta_manager.h"
+#include "connection/qp_manager.h"
+#include "memstore/cvt.h"
+#include "memstore/hash_store.h"
+#include "util/hash.h"
+
+// Size of each RDMA read when copying a table. The data is staged in the shared part of the thread's RDMA buffer
+static const size_t TABLE_CACHE_LOAD_CHUNK = (size_t)2 * 1024 * 1024;
+
+static_assert(TABLE_CACHE_LOAD_CHUNK <= PER_THREAD_SHARED_ALLOC_SIZE, "Table cache staging buffer exceeds the thread's RDMA buffer");
+
+// A CN-resident replica of the tables marked in READ_ONLY_TABLE.
+// Each table is bulk-copied from its primary at startup. Since these tables are never
+// written after loading, all the coordinators in this CN read them locally without
+// network traffic and validation
+class TableCache {
+ public:
+  TableCache() {
+    for (int i = 0; i < MAX_DB_TABLE_NUM; i++) {
+      tables[i].region = nullptr;
+    }
+  }
+
+  ~TableCache() {
+    for (int i = 0; i < MAX_DB_TABLE_NUM; i++) {
+      if (tables[i].region) {
+        free(tables[i].region);
+      }
+    }
+  }
+
+  // Called by one thread before transactions run
+  void Load(MetaManager* meta_man, QPManager* qp_man, LocalBufferAllocator* rdma_buffer_alloc) {
+    constexpr int table_num = sizeof(READ_ONLY_TABLE) / sizeof(READ_ONLY_TABLE[0]);
+
+    for (table_id_t table_id = 0; table_id < table_num; table_id++) {
+      if (!READ_ONLY_TABLE[table_id]) continue;
+
+      const HashMeta& meta = meta_man->GetPrimaryHashMetaWithTableID(table_id);
+      node_id_t remote_node_id = meta_man->GetPrimaryNodeID(table_id);
+      RCQP* qp = qp_man->GetRemoteDataQPWithNodeID(remote_node_id);
+
+      // Index + initial full values, see the structure in HashStore
+      size_t vpkg_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;
+      size_t region_size = meta.bucket_num * meta.bucket_size + SLOT_NUM[table_id] * meta.bucket_num * vpkg_size;
+
+      CachedTable& table = tables[table_id];
+      table.region = (char*)malloc(region_size);
+      if (table.region == nullptr) {
+        RDMA_LOG(FATAL) << "Table cache alloc fails for table " << table_id << ", size (B): " << region_size;
+      }
+      table.base_off = meta.base_off;
+      table.size = region_size;
+      table.bucket_num = meta.bucket_num;
+      table.bucket_size = meta.bucket_size;
+      table.hash_core = meta.hash_core;
+
+      char* stage_buf = rdma_buffer_alloc->Alloc(TABLE_CACHE_LOAD_CHUNK);
+      for (size_t copied = 0; copied < region_size; copied += TABLE_CACHE_LOAD_CHUNK) {
+        size_t len = std::min(TABLE_CACHE_LOAD_CHUNK, region_size - copied);
+        auto rc = qp->post_send(IBV_WR_RDMA_READ, stage_buf, len, meta.base_off + copied, IBV_SEND_SIGNALED);
+        if (rc != SUCC) {
+          RDMA_LOG(FATAL) << "Table cache reads table " << table_id << " fails";
+        }
+        ibv_wc wc{};
+        qp->poll_till_completion(wc, no_timeout);
+        memcpy(table.region + copied, stage_buf, len);
+      }
+
+      total_size += region_size;
+
+      RDMA_LOG(INFO) << "Table cache loads table " << table_id << " from MN " << remote_node_id
+                     << ". Size: " << (double)region_size / 1024.0 / 1024.0 << " MB";
+    }
+
+    RDMA_LOG(INFO) << "Table cache memory cost: " << (double)total_size / 1024.0 / 1024.0 << " MB";
+  }
+
+  ALWAYS_INLINE
+  bool IsCached(table_id_t table_id) const {
+    return tables[table_id].region != nullptr;
+  }
+
+  // Locally fill the item with its newest version. Return false if the key does not exist
+  ALWAYS_INLINE
+  bool Read(DataSetItem* item) const {
+    const CachedTable& table = tables[item->header.table_id];
+    uint64_t bkt_idx = GetHash(item->header.key, table.bucket_num, table.hash_core);
+    char* bkt = table.region + bkt_idx * table.bucket_size;
+
+    for (int slot_idx = 0; slot_idx < SLOT_NUM[item->header.table_id]; slot_idx++) {
+      CVT* cvt = (CVT*)(bkt + slot_idx * CVTSize);
+      if (cvt->header.value_size == 0 ||
+          cvt->header.key != item->header.key ||
+          cvt->header.table_id != item->header.table_id) {
+        continue;
+      }
+
+      int read_pos = NO_POS;
+      for (int i = 0; i < MAX_VCELL_NUM; i++) {
+        if (cvt->vcell[i].valid && (read_pos == NO_POS || cvt->vcell[i].version > cvt->vcell[read_pos].version)) {
+          read_pos = i;
+        }
+      }
+
+      if (read_pos == NO_POS) {
+        return false;
+      }
+
+      item->header = cvt->header;
+      item->vcell = cvt->vcell[read_pos];
+
+      // A value package is: sa | value | ea
+      size_t value_size = TABLE_VALUE_SIZE[item->header.table_id];
+      char* vpkg = table.region + (cvt->header.remote_full_value_offset - table.base_off);
+      item->valuepkg.sa = *((anchor_t*)vpkg);
+      memcpy(item->valuepkg.value, vpkg + sizeof(anchor_t), value_size);
+      item->valuepkg.ea = *((anchor_t*)(vpkg + sizeof(anchor_t) + value_size));
+      return true;
+    }
+
+    return false;
+  }
+
+  size_t TotalSize() const {
+    return total_size;
+  }
+
+ private:
+  struct CachedTable {
+    char* region;  // Local copy of the index and the initial full values
+    offset_t base_off;
+    size_t size;
+    uint64_t bucket_num;
+    size_t bucket_size;
+    HashCore hash_core;
+  };
+
+  CachedTable tables[MAX_DB_TABLE_NUM];
+
+  size_t total_size = 0;
+};
@@ -0,0 +1,157 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+
+#include "base/common.h"
+#include "base/workload.h"
+#include "memstore/cvt.h"
+#include "util/hash.h"
+
+// A bounded CN-side cache of <vcell, value> for the tables marked in READ_MOSTLY_TABLE.
+// It is shared by all the threads in a CN. Each entry is direct-mapped by <table_id, key>
+// and guarded by a sequence number (odd = being written). Writers never wait: if an entry
+// is being written by others, the insertion is skipped.
+//
+// An entry is used in two ways:
+// 1) Watermark hit. The entry records `verified_ts`, the largest start time for which the
+//    cached version was found to be the visible one in a remote CVT. A reader whose start
+//    time is in [version, verified_ts] started before that remote read, so it is served
+//    locally without any RDMA.
+// 2) Version hit. Otherwise the reader still reads the CVT (a single READ that is issued
+//    together with the other reads), and skips the value READ if the visible vcell has the
+//    cached version.
+class VersionCache {
+ public:
+  VersionCache(size_t num) : entry_num(num) {
+    entries = new Entry[entry_num];
+    for (size_t i = 0; i < entry_num; i++) {
+      entries[i].seq.store(0, std::memory_order_relaxed);
+      entries[i].version = 0;
+    }
+  }
+
+  ~VersionCache() {
+    delete[] entries;
+  }
+
+  // Copy the cached version of item's key into item. Return the cached version and set
+  // verified_ts. Return 0 if the key is not cached
+  ALWAYS_INLINE
+  version_t Search(DataSetItem* item, node_id_t& node_id, tx_id_t& verified_ts) const {
+    Entry& e = entries[Index(item->header.table_id, item->header.key)];
+
+    uint64_t seq = e.seq.load(std::memory_order_acquire);
+    if (seq & 1) return 0;
+
+    if (e.version == 0) return 0;
+
+    // Only the value is directly copied to item. It is overwritten by the remote read if this search fails
+    Header header = e.header;
+    VCell vcell = e.vcell;
+    version_t version = e.version;
+    node_id_t cached_node_id = e.node_id;
+    tx_id_t cached_verified_ts = e.verified_ts;
+    anchor_t sa = e.sa;
+    anchor_t ea = e.ea;
+    memcpy(item->valuepkg.value, e.value, TABLE_VALUE_SIZE[item->header.table_id]);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (e.seq.load(std::memory_order_relaxed) != seq ||
+        header.key != item->header.key ||
+        header.table_id != item->header.table_id) {
+      return 0;
+    }
+
+    item->header = header;
+    item->vcell = vcell;
+    item->valuepkg.sa = sa;
+    item->valuepkg.ea = ea;
+    node_id = cached_node_id;
+    verified_ts = cached_verified_ts;
+    return version;
+  }
+
+  // Cache the value of item that is visible at start_time
+  ALWAYS_INLINE
+  void Insert(const DataSetItem* item, node_id_t node_id, tx_id_t start_time) {
+    Entry& e = entries[Index(item->header.table_id, item->header.key)];
+    if (!BeginWrite(e)) return;
+
+    if (e.version == item->vcell.version &&
+        e.header.key == item->header.key &&
+        e.header.table_id == item->header.table_id) {
+      if (start_time > e.verified_ts) e.verified_ts = start_time;
+    } else {
+      e.header = item->header;
+      e.vcell = item->vcell;
+      e.version = item->vcell.version;
+      e.verified_ts = start_time;
+      e.node_id = node_id;
+      e.sa = item->valuepkg.sa;
+      e.ea = item->valuepkg.ea;
+      memcpy(e.value, item->valuepkg.value, TABLE_VALUE_SIZE[item->header.table_id]);
+    }
+
+    EndWrite(e);
+  }
+
+  // The cached version is found visible again at start_time
+  ALWAYS_INLINE
+  void Refresh(table_id_t table_id, itemkey_t key, version_t version, tx_id_t start_time) {
+    Entry& e = entries[Index(table_id, key)];
+    if (!BeginWrite(e)) return;
+
+    if (e.version == version &&
+        e.header.key == key &&
+        e.header.table_id == table_id &&
+        start_time > e.verified_ts) {
+      e.verified_ts = start_time;
+    }
+
+    EndWrite(e);
+  }
+
+  size_t TotalSize() const {
+    return entry_num * sizeof(Entry);
+  }
+
+ private:
+  struct Entry {
+    std::atomic<uint64_t> seq;
+    Header header;
+    VCell vcell;
+    version_t version;    // 0 if empty
+    tx_id_t verified_ts;  // The cached version is visible for start times in [version, verified_ts]
+    node_id_t node_id;    // From which node the version is read. Used in validation
+    anchor_t sa;
+    anchor_t ea;
+    uint8_t value[MAX_VALUE_SIZE];
+  };
+
+  ALWAYS_INLINE
+  size_t Index(table_id_t table_id, itemkey_t key) const {
+    return MurmurHash64A(key, (unsigned int)table_id) % entry_num;
+  }
+
+  ALWAYS_INLINE
+  bool BeginWrite(Entry& e) {
+    uint64_t seq = e.seq.load(std::memory_order_relaxed);
+    if (seq & 1) return false;
+    if (!e.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) return false;
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+
+  ALWAYS_INLINE
+  void EndWrite(Entry& e) {
+    e.seq.fetch_add(1, std::memory_order_release);
+  }
+
+  Entry* entries;
+
+  size_t entry_num;
+};
@@ -12,6 +12,11 @@ MetaManager::MetaManager() {
   auto local_node = json_config.get("local_compute_node");
   local_machine_id = (node_id_t)local_node.get("machine_id").get_int64();
   iso_level = local_node.get("iso_level").get_int64();
+  partition_num = (int)local_node.get("partition_num").get_int64();
+  partitions.store(nullptr, std::memory_order_relaxed);
+  for (int i = 0; i < MAX_DB_TABLE_NUM; i++) {
+    recovering_nodes[i] = -1;
+  }
 
   auto mem_nodes = json_config.get("remote_mem_nodes");
   auto remote_ips = mem_nodes.get("remote_ips");                // Array
@@ -37,6 +42,8 @@ MetaManager::MetaManager() {
 
   RDMA_LOG(INFO) << "All hash table meta received";
 
+  BuildPartitions();
+
 #if PRINT_HASH_META
   // Check all the meta received
   std::cerr << "-------------------------------------- Primary Info ---------------------------------------\n";
@@ -91,6 +98,52 @@ MetaManager::MetaManager() {
   RDMA_LOG(INFO) << "All remote mr meta received!";
 }
 
+void MetaManager::BuildPartitions() {
+  if (partition_num <= 1) {
+    return;
+  }
+
+  PartitionMap* map = new PartitionMap();
+
+  for (auto& p_t_n : primary_table_nodes) {
+    table_id_t table_id = p_t_n.first;
+
+    // A CN computes bucket addresses with the primary's hash meta, which requires the same table layout in replicas
+    const HashMeta& primary_meta = primary_hash_metas[table_id];
+    for (auto& backup_meta : backup_hash_metas[table_id]) {
+      if (backup_meta.base_off != primary_meta.base_off || backup_meta.bucket_num != primary_meta.bucket_num) {
+        RDMA_LOG(FATAL) << "Table " << table_id << " has different layouts in replicas, which cannot be partitioned";
+      }
+    }
+
+    std::vector<node_id_t> replicas;
+    replicas.push_back(p_t_n.second);
+    replicas.insert(replicas.end(), backup_table_nodes[table_id].begin(), backup_table_nodes[table_id].end());
+
+    // The replicas that can be the primary of a partition
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < replicas.size(); i++) {
+      if (replicas[i] != recovering_nodes[table_id]) {
+        candidates.push_back(i);
+      }
+    }
+
+    map->primary_nodes[table_id].resize(partition_num);
+    map->backup_nodes[table_id].resize(partition_num);
+
+    for (int p = 0; p < partition_num; p++) {
+      size_t primary_idx = candidates[p % candidates.size()];
+      map->primary_nodes[table_id][p] = replicas[primary_idx];
+      for (size_t i = 1; i < replicas.size(); i++) {
+        map->backup_nodes[table_id][p].push_back(replicas[(primary_idx + i) % replicas.size()]);
+      }
+    }
+  }
+
+  partition_maps.emplace_back(map);
+  partitions.store(map, std::memory_order_release);
+}
+
 node_id_t MetaManager::GetMemStoreMeta(std::string& remote_ip, int remote_port) {
   // Get remote memory store metadata for remote accesses, via TCP
   /* ---------------Initialize socket---------------- */
@@ -159,10 +212,13 @@ node_id_t MetaManager::GetMemStoreMeta(std::string& remote_ip, int remote_port)
   delta_start_off = *((offset_t*)snooper);
   snooper += sizeof(delta_start_off);
 
-  per_thread_delta_size = *((size_t*)snooper);
-  snooper += sizeof(per_thread_delta_size);
+  delta_pool_size = *((size_t*)snooper);
+  snooper += sizeof(delta_pool_size);
+
+  status_start_off = *((offset_t*)snooper);
+  snooper += sizeof(status_start_off);
 
-  RDMA_LOG(DBG) << "META MAN: delta_start_off (DataRegion size, MB): " << (double)delta_start_off / 1024 / 1024 << ", per_thread_delta_size (MB): " << (double)per_thread_delta_size / 1024 / 1024;
+  RDMA_LOG(DBG) << "META MAN: delta_start_off (DataRegion size, MB): " << (double)delta_start_off / 1024 / 1024 << ", delta_pool_size (MB): " << (double)delta_pool_size / 1024 / 1024;
 
   // Get the `end of file' indicator: finish transmitting
   char* eof = snooper + sizeof(HashMeta) * (primary_meta_num + backup_meta_num);
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "base/common.h"
 #include "memstore/hash_store.h"
@@ -18,6 +20,17 @@ extern std::atomic<bool> during_backup_recovery;
 
 using namespace rdmaio;
 
+const unsigned int PARTITION_HASH_SEED = 0x9e3779b9;
+
+// Padded to a cache line, so that the first chunk does not share the contended header's line
+const size_t DELTA_POOL_HEADER_SIZE = 64;
+
+// A GC watermark slot: <minimum start time, minimum start time of the long readers, publish time>, padded
+const size_t GC_SLOT_SIZE = 32;
+
+// The retention floor of the AS OF readers: <floor << 16 | pin count, announced next floor>
+const size_t GC_FLOOR_SIZE = 16;
+
 struct RemoteNode {
   node_id_t node_id;
   std::string ip;
@@ -25,6 +38,13 @@ struct RemoteNode {
   int meta_port;
 };
 
+// Where the partitions of each table are placed. Never changed after it is published, so that the
+// readers need no lock. A new placement is published as a whole
+struct PartitionMap {
+  std::vector<node_id_t> primary_nodes[MAX_DB_TABLE_NUM];
+  std::vector<std::vector<node_id_t>> backup_nodes[MAX_DB_TABLE_NUM];
+};
+
 enum PrimaryCrashTime : int {
   kBeforeCommit = 0,
   kAtAbort,
@@ -115,6 +135,42 @@ class MetaManager {
     return &(backup_table_nodes[table_id]);
   }
 
+  /*** Partition Metadata ***/
+  // A table is hash partitioned by keys. The partitions take turns to be the primary among the replicas
+  // of the table, so that the accesses to a hot table spread over all its replicas
+  int GetPartition(const table_id_t table_id, const itemkey_t key) const {
+    if (partition_num <= 1) return 0;
+    return (int)(MurmurHash64A(key, PARTITION_HASH_SEED + (unsigned int)table_id) % partition_num);
+  }
+
+  node_id_t GetPrimaryNodeIDWithCrash(const table_id_t table_id, const itemkey_t key, PrimaryCrashTime p_crash_t = PrimaryCrashTime::kBeforeCommit) {
+    node_id_t node_id = GetPrimaryNodeIDWithCrash(table_id, p_crash_t);
+    if (partition_num <= 1 || node_id == PRIMARY_CRASH || node_id == BACKUP_CRASH) {
+      return node_id;
+    }
+    return partitions.load(std::memory_order_acquire)->primary_nodes[table_id][GetPartition(table_id, key)];
+  }
+
+  node_id_t GetPrimaryNodeID(const table_id_t table_id, const itemkey_t key) {
+    if (partition_num <= 1) {
+      return GetPrimaryNodeID(table_id);
+    }
+    return partitions.load(std::memory_order_acquire)->primary_nodes[table_id][GetPartition(table_id, key)];
+  }
+
+  const std::vector<node_id_t>* GetBackupNodeIDWithCrash(const table_id_t table_id, const itemkey_t key, bool& need_recovery) {
+    auto* backup_nodes = GetBackupNodeIDWithCrash(table_id, need_recovery);
+    if (partition_num <= 1) {
+      return backup_nodes;
+    }
+    return &(partitions.load(std::memory_order_acquire)->backup_nodes[table_id][GetPartition(table_id, key)]);
+  }
+
+  // Place the partitions according to the current primary and backups of each table, and publish the
+  // new placement. The replaced one is kept, since other threads may still iterate its backups.
+  // A replica being recovered is a backup of all partitions, and the primary of none
+  void BuildPartitions();
+
   /*** RDMA Memory Region Metadata ***/
   const MemoryAttr& GetRemoteHashMR(const node_id_t node_id) const {
     auto mrsearch = remote_hash_mrs.find(node_id);
@@ -122,14 +178,75 @@ class MetaManager {
     return mrsearch->second;
   }
 
-  const size_t GetPerThreadDeltaSize() const {
-    return per_thread_delta_size;
+  const size_t GetDeltaPoolSize() const {
+    return delta_pool_size;
   }
 
   const offset_t GetDeltaStartOffset() const {
     return delta_start_off;
   }
 
+  // The delta pool starts with an 8B header, i.e., the allocated size, which is FAAed by the CN threads.
+  // Delta offsets are the same in all memory nodes, so only the header in one memory node is used.
+  // Like the status slots, memory nodes are numbered from 0
+  node_id_t GetDeltaPoolNodeID() const {
+    return 0;
+  }
+
+  offset_t GetDeltaPoolHeaderOffset() const {
+    return delta_start_off;
+  }
+
+  // Chunks are carved from [start, start + size)
+  offset_t GetDeltaPoolChunkStart() const {
+    return delta_start_off + DELTA_POOL_HEADER_SIZE;
+  }
+
+  size_t GetDeltaPoolChunkSpace() const {
+    return delta_pool_size - DELTA_POOL_HEADER_SIZE;
+  }
+
+  // The status slots of coordinators are spread over memory nodes
+  node_id_t GetCoordStatusNodeID(uint32_t coord_id) const {
+    return (node_id_t)(coord_id % remote_nodes.size());
+  }
+
+  offset_t GetCoordStatusOffset(uint32_t coord_id) const {
+    return status_start_off + (offset_t)coord_id * sizeof(uint64_t);
+  }
+
+  // The GC watermark slots of CN threads follow the status slots. Only the slots in one memory node are used
+  node_id_t GetGCSlotNodeID() const {
+    return 0;
+  }
+
+  offset_t GetGCSlotStartOffset() const {
+    return status_start_off + (offset_t)MAX_CLIENT_NUM_PER_MN * MAX_CORO_NUM_PER_THREAD * sizeof(uint64_t);
+  }
+
+  offset_t GetGCSlotOffset(t_id_t global_tid) const {
+    return GetGCSlotStartOffset() + (offset_t)global_tid * GC_SLOT_SIZE;
+  }
+
+  // The retention floor follows the GC slots, so that one read fetches both
+  offset_t GetGCFloorOffset() const {
+    return GetGCSlotStartOffset() + (offset_t)MAX_CLIENT_NUM_PER_MN * GC_SLOT_SIZE;
+  }
+
+  // The lease epoch counter follows the retention floor in the same memory node
+  node_id_t GetLeaseEpochNodeID() const {
+    return 0;
+  }
+
+  offset_t GetLeaseEpochOffset() const {
+    return GetGCFloorOffset() + GC_FLOOR_SIZE;
+  }
+
+  // The redo log of a coordinator is in the memory node of its status slot, after the lease epoch counter
+  offset_t GetRedoLogOffset(uint32_t coord_id) const {
+    return GetLeaseEpochOffset() + sizeof(uint64_t) + (offset_t)coord_id * REDO_LOG_SIZE;
+  }
+
   void GetRemoteIP(node_id_t nid, std::string& r_ip, int& r_metaport) {
     for (int i = 0; i < remote_nodes.size(); i++) {
       if (remote_nodes[i].node_id == nid) {
@@ -164,6 +281,16 @@ class MetaManager {
 
     backup_nodes.push_back(old_p_id);
     backup_hashs.push_back(old_p_hash_meta);
+
+    // The old primary is being migrated to. It takes no partition as the primary until then
+    recovering_nodes[table_id] = old_p_id;
+    BuildPartitions();
+  }
+
+  // The migration to the old primary is done, i.e., it replies MIGRATE_OK
+  void FinishChangePrimary(const table_id_t table_id) {
+    recovering_nodes[table_id] = -1;
+    BuildPartitions();
   }
 
  private:
@@ -175,13 +302,24 @@ class MetaManager {
 
   std::unordered_map<node_id_t, MemoryAttr> remote_hash_mrs;
 
+  int partition_num;  // Number of partitions of each table. 1 is placing the whole table in its primary
+
+  std::atomic<PartitionMap*> partitions;  // The current placement. Rebuilt only by the primary recovery, which is serialized
+
+  std::vector<std::unique_ptr<PartitionMap>> partition_maps;  // All the published placements
+
+  node_id_t recovering_nodes[MAX_DB_TABLE_NUM];  // The replica of each table being migrated to. -1 if none
+
   node_id_t local_machine_id;
 
 
  public:
   offset_t delta_start_off;
 
-  size_t per_thread_delta_size;
+  size_t delta_pool_size;
+
+  offset_t status_start_off;  // Start of the coordinator status slots in each memory node
+
   // Used by QP manager and RDMA Region
   RdmaCtrlPtr global_rdma_ctrl;
 
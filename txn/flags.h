@@ -34,7 +34,8 @@
 #define MAX_REMOTE_NODE_NUM 100  
 #define MAX_TNUM_PER_CN 100
 #define MAX_CLIENT_NUM_PER_MN 50  
-#define BACKUP_NUM 2  // Backup memory node number. **NOT** 0
+#define MAX_CORO_NUM_PER_THREAD 32  // Including the polling coroutine
+#define BACKUP_NUM 2  // Default backup number of each table. Set per table in mn_config.json
 
 #define MAX_DB_TABLE_NUM 15 
 #define MAX_ATTRIBUTE_NUM_PER_TABLE 20
@@ -44,6 +45,9 @@
 #define PRINT_HASH_META 0
 #define OUTPUT_EVENT_STAT 0
 #define OUTPUT_KEY_STAT 0
+#define LEASE_LOCK 0        // Locks carry the owner and a lease, so that the locks of a crashed coordinator can be released by others
+#define LOCK_LEASE_US 10000 // Lock lease (us), counted in the lease epochs ticked in a memory node. It should cover the lock holding time
+#define REDO_LOG_SIZE 65536 // Redo log of each coordinator (bytes) in memory node, with which others roll forward its commit. Only for LEASE_LOCK
 
 /*********************** Crash test only **********************/
 #define PROBE_TP 0  // Probing throughput during execution
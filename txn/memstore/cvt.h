@@ -16,15 +16,17 @@
 
 struct Header {
   table_id_t table_id;
-  lock_t lock;
   itemkey_t key;
   offset_t remote_offset;             // remote offset of the CVT
   offset_t remote_full_value_offset;  // Remote offset of the full value
   offset_t remote_attribute_offset;   // Remote offset of the attribute bar
+  offset_t remote_overflow_offset;    // Remote offset of the newest spilled version. UN_INIT_POS if none
   size_t value_size;                  // The length of value of each object
   bool user_inserted;
+  lock_t lock;  // Placed last so that lock + vcells are contiguous in a CVT, which allows validation to read them at once
 } Aligned8;
 constexpr size_t HeaderSize = sizeof(Header);
+static_assert(offsetof(Header, lock) + sizeof(lock_t) == HeaderSize, "lock must be adjacent to the vcells");
 using HeaderPtr = std::shared_ptr<Header>;
 
 struct VCell {
@@ -41,10 +43,11 @@ struct VCell {
 constexpr size_t VCellSize = sizeof(VCell);
 using VCellPtr = std::shared_ptr<VCell>;
 
+// The value buffer is the last member so that a DataSetItem can be allocated for its own table's value size
 struct Value {
   anchor_t sa;                    // Start anchor
-  uint8_t value[MAX_VALUE_SIZE];  // A max buffer to receive remote full value
   anchor_t ea;                    // End anchor
+  uint8_t value[MAX_VALUE_SIZE];  // A max buffer to receive remote full value
   bool IsWritten() {
     return sa != ea;
   }
@@ -52,6 +55,15 @@ struct Value {
 constexpr size_t ValueSize = sizeof(Value);
 using ValuePtr = std::shared_ptr<Value>;
 
+// A version spilled out of the vcells for the long readers, followed by its full value. The spilled
+// versions of a CVT are chained from new to old in the delta region
+struct OverflowHeader {
+  version_t version;      // Commit time of this version
+  version_t end_version;  // Commit time of the version that supersedes it
+  offset_t next;          // Remote offset of the older spilled version. UN_INIT_POS if none
+} Aligned8;
+constexpr size_t OverflowHeaderSize = sizeof(OverflowHeader);
+
 // Consecutive Version Tuple
 struct CVT {
   Header header;
@@ -64,6 +76,8 @@ struct CVT {
   }
 } Aligned8;
 constexpr size_t CVTSize = sizeof(CVT);
+// Validation only reads the lock and all the vcells
+constexpr size_t ValidateReadSize = sizeof(lock_t) + VCellSize * MAX_VCELL_NUM;
 using CVTPtr = std::shared_ptr<CVT>;
 
 enum UserOP : uint8_t {
@@ -77,7 +91,6 @@ enum UserOP : uint8_t {
 struct DataSetItem {
   struct Header header;
   struct VCell vcell;  // Fetched remote target vcell will be copied here
-  struct Value valuepkg;
   char* fetched_cvt_ptr;
 
   bool is_fetched;
@@ -89,9 +102,13 @@ struct DataSetItem {
   bool is_delete_all_invalid;    // Whether no valid version can be deleted
   bool is_insert_all_invalid;    // Whether insert into an all-invalid-cvt
   int insert_slot_idx;           // Insert into which slot. Useful in write replica for calculating remote value offset
+  bool is_try_read;              // Whether a missing or invisible key is tolerated, i.e., reads in TXN::ExecuteBatch
+  bool is_not_found;             // Whether the try read finds no visible version of this key
+  version_t cached_version;      // Version of the CN-cached value copied into valuepkg. 0 if not cached
 
   bitmap_t update_bitmap;
   uint8_t* old_value_ptr;
+  bool owns_old_value;  // Whether old_value_ptr is allocated by this item, or by the txn's arena
   int current_p;  // current update position
 
   in_offset_t remote_so;
@@ -99,8 +116,22 @@ struct DataSetItem {
 
   anchor_t latest_anchor;  // store the latest anchor value for comparison
 
-  DataSetItem(table_id_t _table_id, size_t _size, itemkey_t _key, UserOP op) {
-    memset((char*)this, 0, sizeof(DataSetItem));
+  struct Value valuepkg;  // Must be the last member. Only SizeOf(table_id) bytes of the item are allocated
+
+  // Bytes of a DataSetItem of this table, i.e., without the value buffer tail beyond the table's value size
+  static size_t SizeOf(table_id_t table_id) {
+    return offsetof(DataSetItem, valuepkg) + offsetof(struct Value, value) + TABLE_VALUE_SIZE[table_id];
+  }
+
+  DataSetItem(table_id_t _table_id, size_t _size, itemkey_t _key, UserOP op)
+      : DataSetItem(_table_id, _size, _key, op, nullptr) {}
+
+  // old_value_buf holds at least TABLE_VALUE_SIZE[_table_id] bytes. If nullptr, it is allocated here
+  DataSetItem(table_id_t _table_id, size_t _size, itemkey_t _key, UserOP op, uint8_t* old_value_buf) {
+    // The value buffer is sized for the largest table. Only the part of this table is cleared
+    memset((char*)this, 0, SizeOf(_table_id));
+    fetched_cvt_ptr = nullptr;
+
     header.table_id = _table_id;
     header.key = _key;
     header.value_size = _size;
@@ -114,9 +145,13 @@ struct DataSetItem {
     is_delete_all_invalid = false;
     is_insert_all_invalid = false;
     insert_slot_idx = -1;
+    is_try_read = false;
+    is_not_found = false;
+    cached_version = 0;
 
     update_bitmap = 0;
-    old_value_ptr = new uint8_t[TABLE_VALUE_SIZE[_table_id]];
+    owns_old_value = (old_value_buf == nullptr);
+    old_value_ptr = owns_old_value ? new uint8_t[TABLE_VALUE_SIZE[_table_id]] : old_value_buf;
     current_p = 0;
 
     remote_so = 0;
@@ -126,7 +161,7 @@ struct DataSetItem {
   }
 
   ~DataSetItem() {
-    delete[] old_value_ptr;
+    if (owns_old_value) delete[] old_value_ptr;
   }
 
   void SetUpdate(int bit_pos, void* old_value, size_t len) {
@@ -147,6 +182,10 @@ struct DataSetItem {
     return user_op == UserOP::kInsert;
   }
 
+  bool IsNotFound() {
+    return is_not_found;
+  }
+
   void Debug() {
     // For debug usage
     std::cerr << "[OneObj debug] (meta) table id: " << this->header.table_id << ", value size: " << this->header.value_size << ", key: " << this->header.key << ", remote offset: " << this->header.remote_offset << ", lock: " << this->header.lock << std::endl;
@@ -161,6 +200,10 @@ struct DataSetItem {
     return header.remote_offset + offsetof(Header, remote_attribute_offset);
   }
 
+  const uint64_t GetRemoteOverflowAddr() const {
+    return header.remote_offset + offsetof(Header, remote_overflow_offset);
+  }
+
   const uint64_t GetRemoteValidAddr(int i) const {
     return header.remote_offset + sizeof(Header) + sizeof(VCell) * i + offsetof(VCell, valid);
   }
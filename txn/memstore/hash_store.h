@@ -283,6 +283,7 @@ void HashStore::LocalInsertTuple(itemkey_t key, char* value, size_t value_size)
       cvt->header.remote_offset = GetRemoteOffset(cvt);
       cvt->header.remote_full_value_offset = GetRemoteOffset(value_insert_pos);
       cvt->header.remote_attribute_offset = UN_INIT_POS;
+      cvt->header.remote_overflow_offset = UN_INIT_POS;
       cvt->header.value_size = value_size;
       cvt->header.user_inserted = false;
 
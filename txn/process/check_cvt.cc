@@ -23,6 +23,11 @@ bool TXN::CheckDirectROCVT(std::vector<DirectRead>& pending_direct_ro,
       int read_pos = FindReadPos(fetched_cvt, is_read_newest, max_version_pos, is_ea, is_all_invalid);
 
       if (is_all_invalid) {
+        if (local_item->is_try_read) {
+          local_item->is_fetched = true;
+          local_item->is_not_found = true;
+          continue;
+        }
         event_counter.RegEvent(t_id, txn_name, "CheckDirectROCVT:FindReadPos:AllInvalid");
         return false;
       }
@@ -33,6 +38,21 @@ bool TXN::CheckDirectROCVT(std::vector<DirectRead>& pending_direct_ro,
       }
 
       if (read_pos == NO_POS) {
+        if (CanReadOverflow(fetched_cvt)) {
+          // My version has been spilled. Read it from the overflow chain after this round
+          local_item->header = fetched_cvt->header;
+          overflow_reads.emplace_back(OverflowRead{.qp = res.qp,
+                                                   .item = local_item,
+                                                   .buf = nullptr,
+                                                   .remote_off = fetched_cvt->header.remote_overflow_offset});
+          continue;
+        }
+        if (local_item->is_try_read) {
+          local_item->is_fetched = true;
+          local_item->is_not_found = true;
+          continue;
+        }
+        no_read_pos_abort_cnt[t_id]++;
         event_counter.RegEvent(t_id, txn_name, "CheckDirectROCVT:FindReadPos:NoReadPos (could due to try read)");
         return false;
       }
@@ -49,6 +69,23 @@ bool TXN::CheckDirectROCVT(std::vector<DirectRead>& pending_direct_ro,
 
       local_item->vcell = fetched_cvt->vcell[read_pos];
 
+      if (fetched_cvt->header.remote_full_value_offset != res.value_off) {
+        addr_cache->Insert(res.remote_node,
+                           local_item->header.table_id,
+                           local_item->header.key,
+                           local_item->header.remote_offset,
+                           fetched_cvt->header.remote_full_value_offset);
+      }
+
+      if (res.value_buf && is_read_newest &&
+          fetched_cvt->header.remote_full_value_offset == res.value_off &&
+          UseSpecValue(local_item, res.value_buf)) {
+        if (version_cache && READ_MOSTLY_TABLE[local_item->header.table_id]) {
+          version_cache->Insert(local_item, local_item->read_which_node, start_time);
+        }
+        continue;
+      }
+
       if (!ReadValueRO(res.qp, fetched_cvt, res.item, read_pos, pending_value_read, is_read_newest)) {
         return false;
       }
@@ -70,7 +107,7 @@ bool TXN::CheckDirectROCVT(std::vector<DirectRead>& pending_direct_ro,
 bool TXN::CheckCasReadCVT(std::vector<CasRead>& pending_cas_rw,
                           std::vector<ValueRead>& pending_value_read) {
   for (auto& res : pending_cas_rw) {
-    if (*((lock_t*)res.cas_buf) != STATE_UNLOCKED) {
+    if (IsLocked(*((lock_t*)res.cas_buf), res.item)) {
       event_counter.RegEvent(t_id, txn_name, "CheckCasReadCVT:LockFail");
       return false;  // Abort() will release all the remote locks
     }
@@ -108,6 +145,7 @@ bool TXN::CheckCasReadCVT(std::vector<CasRead>& pending_cas_rw,
         }
 
         if (read_pos == NO_POS) {
+          no_read_pos_abort_cnt[t_id]++;
           event_counter.RegEvent(t_id, txn_name, "CheckCasReadCVT:Delete:FindReadPos:NoReadPos");
           return false;
         }
@@ -129,12 +167,14 @@ bool TXN::CheckCasReadCVT(std::vector<CasRead>& pending_cas_rw,
             local_item->target_write_pos = 0;
             continue;
           } else {
+            no_read_pos_abort_cnt[t_id]++;
             event_counter.RegEvent(t_id, txn_name, "CheckCasReadCVT:FindCasReadPos:NoReadPos");
             return false;
           }
         }
 
         if (write_pos == NO_POS) {
+          no_write_pos_abort_cnt[t_id]++;
           event_counter.RegEvent(t_id, txn_name, "CheckCasReadCVT:FindCasReadPos:NoWritePos");
           return false;
         }
@@ -157,6 +197,20 @@ bool TXN::CheckCasReadCVT(std::vector<CasRead>& pending_cas_rw,
         local_item->user_op = UserOP::kUpdate;
       }
 
+      if (fetched_cvt->header.remote_full_value_offset != res.value_off) {
+        addr_cache->Insert(res.primary_node_id,
+                           local_item->header.table_id,
+                           local_item->header.key,
+                           local_item->header.remote_offset,
+                           fetched_cvt->header.remote_full_value_offset);
+      }
+
+      if (res.value_buf && is_read_newest &&
+          fetched_cvt->header.remote_full_value_offset == res.value_off &&
+          UseSpecValue(local_item, res.value_buf)) {
+        continue;
+      }
+
       if (!ReadValueRW(res.qp, fetched_cvt, res.item, read_pos, pending_value_read, is_read_newest)) {
         return false;
       }
@@ -187,6 +241,10 @@ bool TXN::CheckHashReadCVT(std::vector<HashRead>& pending_hash_read,
     auto cvt_idx = FindMatch(res, read_pos, is_read_newest);
 
     if (cvt_idx == NOT_FOUND) {
+      if (res.item->is_not_found) {
+        // Tolerated missing key in a try read
+        continue;
+      }
       return false;
     }
 
@@ -194,6 +252,10 @@ bool TXN::CheckHashReadCVT(std::vector<HashRead>& pending_hash_read,
     CVT* fetched_cvt = (CVT*)(res.buf + cvt_idx * CVTSize);
 
     if (res.is_ro) {
+      if (read_pos == NO_POS) {
+        // In the overflow chain
+        continue;
+      }
       // 1. Read ro data
       if (!ReadValueRO(res.qp, fetched_cvt, res.item, read_pos, pending_value_read, is_read_newest)) {
         return false;
@@ -223,7 +285,8 @@ int TXN::FindMatch(HashRead& res,
           res.remote_node,
           fetched_cvt->header.table_id,
           fetched_cvt->header.key,
-          fetched_cvt->header.remote_offset);
+          fetched_cvt->header.remote_offset,
+          fetched_cvt->header.remote_full_value_offset);
     }
 
     if (fetched_cvt->header.key == local_item->header.key &&
@@ -251,6 +314,20 @@ int TXN::FindMatch(HashRead& res,
       }
 
       if (read_pos == NO_POS) {
+        if (res.is_ro && CanReadOverflow(fetched_cvt)) {
+          // read_pos remains NO_POS, and the value is read from the overflow chain
+          local_item->header = fetched_cvt->header;
+          overflow_reads.emplace_back(OverflowRead{.qp = res.qp,
+                                                   .item = local_item,
+                                                   .buf = nullptr,
+                                                   .remote_off = fetched_cvt->header.remote_overflow_offset});
+          return slot_idx;
+        }
+        if (local_item->is_try_read) {
+          local_item->is_not_found = true;
+          return NOT_FOUND;
+        }
+        no_read_pos_abort_cnt[t_id]++;
         if (res.item->user_op == UserOP::kDelete) {
           event_counter.RegEvent(t_id, txn_name, "HashFindMatch:Delete:FindReadPos:NoReadPos");
         } else {
@@ -278,6 +355,11 @@ int TXN::FindMatch(HashRead& res,
     }
   }
 
+  if (local_item->is_try_read) {
+    local_item->is_not_found = true;
+    return NOT_FOUND;
+  }
+
   event_counter.RegEvent(t_id, txn_name, "HashFindMatch:NoMatch (Could due to try read)");
   return NOT_FOUND;
 }
@@ -302,17 +384,17 @@ bool TXN::CheckInsertCVT(std::vector<InsertOffRead>& pending_insert_off_rw,
     // 1) the client does not use it, and 2) the client will prepare a new value
     // Hence, we only need to read + lock remote CVTs
     if (res.item->user_op == UserOP::kInsert) {
-      char* lock_buff = thread_rdma_buffer_alloc->Alloc(sizeof(lock_t));
+      char* lock_buff = coro_rdma_buffer_alloc->Alloc(sizeof(lock_t));
       *(lock_t*)lock_buff = 0xdeadbeaf;
 
-      char* cvt_buff = thread_rdma_buffer_alloc->Alloc(CVTSize);
+      char* cvt_buff = coro_rdma_buffer_alloc->Alloc(CVTSize);
 
       RecordLockKey(res.remote_node, res.item->GetRemoteLockAddr());
 
-      auto doorbell = std::make_shared<LockReadBatch>();
-      doorbell->SetLockReq(lock_buff, res.item->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-      doorbell->SetReadReq(cvt_buff, res.item->header.remote_offset, CVTSize);
-      doorbell->SendReqs(coro_sched, res.qp, coro_id);
+      LockReadBatch doorbell;
+      doorbell.SetLockReq(lock_buff, res.item->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+      doorbell.SetReadReq(cvt_buff, res.item->header.remote_offset, CVTSize);
+      doorbell.SendReqs(coro_sched, res.qp, coro_id);
 
       // CheckAddr(res.item->GetRemoteLockAddr(), 8, "CheckInsertCVT:SetLockReq");
       // CheckAddr(res.item->header.remote_offset, CVTSize, "CheckInsertCVT:SetReadReq");
@@ -345,6 +427,10 @@ int TXN::FindInsertOff(InsertOffRead& res,
 
   bool real_insert = true;  // is insert or update?
 
+  // A slot of another deleted key. It is taken if there is no empty slot, which unlinks the deleted row's delta blocks
+  offset_t tombstone_cvt_pos = NOT_FOUND;
+  int tombstone_slot = 0;
+
   for (int i = 0; i < SLOT_NUM[local_item->header.table_id]; i++) {
     // CVT* fetched_cvt = &(fetched_hash_bucket->cvts[i]);
     CVT* fetched_cvt = (CVT*)(res.buf + i * CVTSize);
@@ -354,7 +440,8 @@ int TXN::FindInsertOff(InsertOffRead& res,
           res.remote_node,
           fetched_cvt->header.table_id,
           fetched_cvt->header.key,
-          fetched_cvt->header.remote_offset);
+          fetched_cvt->header.remote_offset,
+          fetched_cvt->header.remote_full_value_offset);
     }
 
     // Here we do not need to judge whether the empty cvt is locked or not, since
@@ -400,6 +487,7 @@ int TXN::FindInsertOff(InsertOffRead& res,
       }
 
       if (read_pos == NO_POS) {
+        no_read_pos_abort_cnt[t_id]++;
         event_counter.RegEvent(t_id, txn_name, "FindInsertOff:FindReadPos:NoReadPos");
         return NOT_FOUND;
       }
@@ -416,9 +504,22 @@ int TXN::FindInsertOff(InsertOffRead& res,
       local_item->latest_anchor = fetched_cvt->vcell[max_version_pos].sa;
 
       break;
+    } else if (txn_watermark && tombstone_cvt_pos == NOT_FOUND &&
+               fetched_cvt->header.value_size > 0 && IsAllInvalid(fetched_cvt) &&
+               inserted_pos.find(std::make_pair(res.remote_node, res.bucket_off + i * CVTSize)) == inserted_pos.end()) {
+      tombstone_cvt_pos = res.bucket_off + i * CVTSize;
+      tombstone_slot = i;
     }
   }
 
+  if (real_insert && insert_cvt_pos == NOT_FOUND && tombstone_cvt_pos != NOT_FOUND) {
+    inserted_pos.insert(std::make_pair(res.remote_node, tombstone_cvt_pos));
+    insert_cvt_pos = tombstone_cvt_pos;
+    target_slot = tombstone_slot;
+    local_item->is_insert_all_invalid = true;
+    event_counter.RegEvent(t_id, txn_name, "FindInsertOff:ReuseTombstone");
+  }
+
   if (real_insert) {
     if (insert_cvt_pos == NOT_FOUND) {
       event_counter.RegEvent(t_id, txn_name, "FindInsertOff:NoEmptySlot");
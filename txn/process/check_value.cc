@@ -8,46 +8,80 @@
 // --------------- Checking cvts, values and attributes after reading them---------
 bool TXN::CheckValueRO(std::vector<ValueRead>& pending_value_read) {
   for (auto& fetched_it : pending_value_read) {
-    char* p = fetched_it.value_buf;
-
-    anchor_t fetched_value_sa = *((anchor_t*)p);
-    char* fetched_value = p + sizeof(anchor_t);
-    size_t value_size = TABLE_VALUE_SIZE[fetched_it.item->header.table_id];
-    p = p + sizeof(anchor_t) + value_size;
-    anchor_t fetched_value_ea = *((anchor_t*)p);
-
-    if (fetched_value_sa != fetched_value_ea) {
-      event_counter.RegEvent(t_id, txn_name, "CheckValueRO:ValueAnchorMismatch");
+    if (!CheckValueRO(fetched_it)) {
       return false;
     }
+  }
 
-    // For read-only txns, they do not validate, so they need to check the consistency
-    // between the anchors in vcell and vpkg
-    if (fetched_value_ea != fetched_it.item->latest_anchor) {
-      event_counter.RegEvent(t_id, txn_name, "CheckValueRO:ValueVcellAnchorMismatch");
-      return false;
-    }
+  return true;
+}
 
-    fetched_it.item->valuepkg.sa = fetched_value_sa;
-    fetched_it.item->valuepkg.ea = fetched_value_ea;
+bool TXN::CheckValueRO(ValueRead& fetched_it) {
+  char* p = fetched_it.value_buf;
 
-    switch (fetched_it.cont) {
-      case Content::kValue: {
-        // Case 1: only read values
-        memcpy((char*)&(fetched_it.item->valuepkg.value), fetched_value, value_size);
-        break;
-      }
-      case Content::kValue_Attr: {
-        // Case 2: read values and attributes
-        CopyValueAndAttr(fetched_it.item, fetched_value, fetched_it.attr_pos, fetched_it.old_attr_pos, value_size);
-        break;
-      }
-      default: {
-        RDMA_LOG(FATAL) << "Error content to check";
-      }
+  anchor_t fetched_value_sa = *((anchor_t*)p);
+  char* fetched_value = p + sizeof(anchor_t);
+  size_t value_size = TABLE_VALUE_SIZE[fetched_it.item->header.table_id];
+  p = p + sizeof(anchor_t) + value_size;
+  anchor_t fetched_value_ea = *((anchor_t*)p);
+
+  if (fetched_value_sa != fetched_value_ea) {
+    event_counter.RegEvent(t_id, txn_name, "CheckValueRO:ValueAnchorMismatch");
+    return false;
+  }
+
+  // For read-only txns, they do not validate, so they need to check the consistency
+  // between the anchors in vcell and vpkg
+  if (fetched_value_ea != fetched_it.item->latest_anchor) {
+    event_counter.RegEvent(t_id, txn_name, "CheckValueRO:ValueVcellAnchorMismatch");
+    return false;
+  }
+
+  fetched_it.item->valuepkg.sa = fetched_value_sa;
+  fetched_it.item->valuepkg.ea = fetched_value_ea;
+
+  switch (fetched_it.cont) {
+    case Content::kValue: {
+      // Case 1: only read values
+      memcpy((char*)&(fetched_it.item->valuepkg.value), fetched_value, value_size);
+      break;
+    }
+    case Content::kValue_Attr: {
+      // Case 2: read values and attributes
+      CopyValueAndAttr(fetched_it.item, fetched_value, fetched_it.attr_pos, fetched_it.old_attr_pos, value_size);
+      break;
+    }
+    default: {
+      RDMA_LOG(FATAL) << "Error content to check";
     }
   }
 
+  if (version_cache && READ_MOSTLY_TABLE[fetched_it.item->header.table_id]) {
+    version_cache->Insert(fetched_it.item, fetched_it.item->read_which_node, start_time);
+  }
+
+  return true;
+}
+
+// The full value speculatively read with the CVT is usable only if it is the newest version's,
+// i.e., its anchors match the newest vcell. Otherwise, the value is read again
+bool TXN::UseSpecValue(DataSetItem* item, char* value_buf) {
+  char* p = value_buf;
+
+  anchor_t fetched_value_sa = *((anchor_t*)p);
+  char* fetched_value = p + sizeof(anchor_t);
+  size_t value_size = TABLE_VALUE_SIZE[item->header.table_id];
+  p = p + sizeof(anchor_t) + value_size;
+  anchor_t fetched_value_ea = *((anchor_t*)p);
+
+  if (fetched_value_sa != fetched_value_ea || fetched_value_ea != item->latest_anchor) {
+    event_counter.RegEvent(t_id, txn_name, "UseSpecValue:AnchorMismatch");
+    return false;
+  }
+
+  item->valuepkg.sa = fetched_value_sa;
+  item->valuepkg.ea = fetched_value_ea;
+  memcpy((char*)&(item->valuepkg.value), fetched_value, value_size);
   return true;
 }
 
@@ -60,7 +94,7 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
     }
 
     if (fetched_it.cont == Content::kDelete_Vcell_LockCVT) {
-      if (*((lock_t*)fetched_it.lock_buf) != STATE_UNLOCKED) {
+      if (IsLocked(*((lock_t*)fetched_it.lock_buf), fetched_it.item)) {
         event_counter.RegEvent(t_id, txn_name, "CheckValueRW:kDelete_Vcell_LockCVT:CVTLocked");
         return false;
       }
@@ -75,7 +109,7 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
     if (fetched_it.cont == Content::kDelete_AllInvalid_LockCVT) {
       // During cvt-read phase, I dont find a valid version to delete
       // In this value-read phase, I check the pos again
-      if (*((lock_t*)fetched_it.lock_buf) != STATE_UNLOCKED) {
+      if (IsLocked(*((lock_t*)fetched_it.lock_buf), fetched_it.item)) {
         event_counter.RegEvent(t_id, txn_name, "CheckValueRW:kDelete_AllInvalid_LockCVT:CVTLocked");
         return false;
       }
@@ -136,7 +170,7 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
       }
       case Content::kValue_LockCVT: {
         // Case 3: lock CVT, read CVT, and read value
-        if (*((lock_t*)fetched_it.lock_buf) != STATE_UNLOCKED) {
+        if (IsLocked(*((lock_t*)fetched_it.lock_buf), fetched_it.item)) {
           event_counter.RegEvent(t_id, txn_name, "CheckValueRW:kValue_LockCVT:CVTLocked");
           return false;
         }
@@ -151,7 +185,7 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
       }
       case Content::kValue_Attr_LockCVT: {
         // Case 4: lock CVT, read CVT, read value, read attr
-        if (*((lock_t*)fetched_it.lock_buf) != STATE_UNLOCKED) {
+        if (IsLocked(*((lock_t*)fetched_it.lock_buf), fetched_it.item)) {
           event_counter.RegEvent(t_id, txn_name, "CheckValueRW:kValue_Attr_LockCVT:CVTLocked");
           return false;
         }
@@ -170,7 +204,7 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
       }
       case Content::kDelete_Value_Attr_LockCVT: {
         // Case 6: lock cvt, read cvt, read value, read one attr
-        if (*((lock_t*)fetched_it.lock_buf) != STATE_UNLOCKED) {
+        if (IsLocked(*((lock_t*)fetched_it.lock_buf), fetched_it.item)) {
           event_counter.RegEvent(t_id, txn_name, "CheckValueRW:kDelete_Value_Attr_LockCVT:CVTLocked");
           return false;
         }
@@ -183,11 +217,17 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
         break;
       }
     }
+
+    if (version_cache &&
+        fetched_it.item->user_op == UserOP::kRead &&
+        READ_MOSTLY_TABLE[fetched_it.item->header.table_id]) {
+      version_cache->Insert(fetched_it.item, fetched_it.item->read_which_node, start_time);
+    }
   }
 
   for (auto& fetched_it : pending_cvt_insert) {
     // For insertions, the coordinator does not need to read values in Execution phase
-    if (*((lock_t*)fetched_it.lock_buf) != STATE_UNLOCKED) {
+    if (IsLocked(*((lock_t*)fetched_it.lock_buf), fetched_it.item)) {
       event_counter.RegEvent(t_id, txn_name, "CheckValueRW:Insert:CVTLocked");
       return false;
     }
@@ -211,6 +251,22 @@ bool TXN::CheckValueRW(std::vector<ValueRead>& pending_value_read,
         event_counter.RegEvent(t_id, txn_name, "CheckValueRW:Insert:SlotBecomeValid");
         return false;
       }
+
+      if (txn_watermark) {
+        // My insert unlinks the delta blocks of the deleted row
+        offset_t delta_start = global_meta_man->GetDeltaStartOffset();
+        const Header& old_header = re_read_cvt->header;
+        if (old_header.remote_full_value_offset != UN_INIT_POS && old_header.remote_full_value_offset >= delta_start) {
+          unlinked_deltas.push_back(UnlinkedDelta{old_header.remote_full_value_offset,
+                                                  TABLE_VALUE_SIZE[old_header.table_id] + sizeof(anchor_t) * 2});
+        }
+        if (old_header.remote_attribute_offset != UN_INIT_POS && old_header.remote_attribute_offset >= delta_start) {
+          unlinked_deltas.push_back(UnlinkedDelta{old_header.remote_attribute_offset, ATTR_BAR_SIZE[old_header.table_id]});
+        }
+        if (old_header.remote_overflow_offset != UN_INIT_POS) {
+          unlinked_chains.push_back(UnlinkedChain{old_header.table_id, old_header.remote_overflow_offset, nullptr});
+        }
+      }
     } else {
       if (re_read_cvt->header.value_size) {
         // I and another coordinator (C0) follow the same agreement to occupy the first empty slot.
@@ -255,7 +311,7 @@ bool TXN::ObtainWritePos(CVT* re_read_cvt, DataSetItem* item) {
   int write_pos = NO_POS;
   int max_version_pos = 0;
 
-  if (global_meta_man->iso_level == ISOLATION::SR) {
+  if (iso_level == ISOLATION::SR) {
     // Below are for SR
 
     if (item->user_op == UserOP::kDelete) {
@@ -275,6 +331,7 @@ bool TXN::ObtainWritePos(CVT* re_read_cvt, DataSetItem* item) {
       }
 
       if (write_pos == NO_POS) {
+        no_write_pos_abort_cnt[t_id]++;
         event_counter.RegEvent(t_id, txn_name, "CheckValueRW:ObtainWritePos:FindReadWritePos:NoWritePosForUpdate");
         return false;
       }
@@ -296,11 +353,12 @@ bool TXN::ObtainWritePos(CVT* re_read_cvt, DataSetItem* item) {
       return false;
     }
   } else {
-    // Below are for SI
+    // Below are for SI and RC
     if (item->user_op != UserOP::kDelete) {
       write_pos = FindWritePos(re_read_cvt, max_version_pos);
 
       if (write_pos == NO_POS) {
+        no_write_pos_abort_cnt[t_id]++;
         event_counter.RegEvent(t_id, txn_name, "[SI] CheckValueRW:ObtainWritePos:FindWritePos:NoWritePos");
         return false;
       }
@@ -84,7 +84,7 @@ void TXN::CollectAttr(std::vector<AttrRead>& attr_read_list,
 
   assert(must_read_attrs_len != 0);
 
-  char* must_read_attrs_buf = thread_rdma_buffer_alloc->Alloc(must_read_attrs_len);
+  char* must_read_attrs_buf = coro_rdma_buffer_alloc->Alloc(must_read_attrs_len);
   attr_pos->local_attr_buf = must_read_attrs_buf;
 
   attr_read_list.emplace_back(
@@ -134,7 +134,7 @@ void TXN::SearchOldVCells(int attr_idx,
       }
 
       size_t attr_sz = ATTR_SIZE[table_id][attr_idx];
-      char* attr_buf = thread_rdma_buffer_alloc->Alloc(attr_sz);
+      char* attr_buf = coro_rdma_buffer_alloc->Alloc(attr_sz);
 
       // Used to send RDMA read to fetch one attribute
       attr_read_list.emplace_back(
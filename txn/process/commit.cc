@@ -5,7 +5,46 @@
 
 extern std::atomic<bool> cannot_lock_new_primary;
 
-void TXN::CommitAll() {
+// Make sure the current delta chunk of this thread holds the new attribute bars and value packages of
+// CommitAll. Otherwise, grab a chunk from the delta pool. Since CommitAll does not yield, the space
+// cannot be taken by the other coroutines after the check
+void TXN::EnsureDeltaSpace(coro_yield_t& yield) {
+  size_t need = 0;
+  for (auto& set_it : read_write_set) {
+    if (set_it->user_op == UserOP::kUpdate && set_it->header.remote_attribute_offset == UN_INIT_POS) {
+      need += ATTR_BAR_SIZE[set_it->header.table_id];
+    } else if (set_it->user_op == UserOP::kInsert) {
+      need += TABLE_VALUE_SIZE[set_it->header.table_id] + sizeof(anchor_t) * 2;
+    }
+    if (NeedSpill(set_it.get())) {
+      need += OverflowHeaderSize + TABLE_VALUE_SIZE[set_it->header.table_id];
+    }
+  }
+
+  while (need > 0 && !thread_delta_offset_alloc->CanAlloc(need)) {
+    size_t chunk_size = thread_delta_offset_alloc->NextChunkSize(need);
+    RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetDeltaPoolNodeID());
+    char* faa_buf = coro_rdma_buffer_alloc->Alloc(sizeof(uint64_t));
+    if (!coro_sched->RDMAFAA(coro_id, qp, faa_buf, global_meta_man->GetDeltaPoolHeaderOffset(), chunk_size)) {
+      RDMA_LOG(FATAL) << "Thread " << t_id << " , Coroutine " << coro_id << " fails to grab a delta chunk";
+    }
+    coro_sched->Yield(yield, coro_id);
+
+    uint64_t allocated = *((uint64_t*)faa_buf);
+    if (allocated + chunk_size > global_meta_man->GetDeltaPoolChunkSpace()) {
+      RDMA_LOG(FATAL) << "Delta pool is exhausted. Allocated: " << (double)allocated / 1024 / 1024
+                      << " MB. Enlarge delta_pool_size_MB in mn_config.json";
+    }
+
+    // Other coroutines of this thread may have grabbed a chunk meanwhile. Mine is fresher, and the rest of theirs is dropped
+    thread_delta_offset_alloc->AddChunk(global_meta_man->GetDeltaPoolChunkStart() + allocated, chunk_size);
+    event_counter.RegEvent(t_id, txn_name, "EnsureDeltaSpace:GrabChunk");
+  }
+}
+
+void TXN::PrepareCommit() {
+  commit_writes.clear();
+
   for (auto& set_it : read_write_set) {
 #if OUTPUT_KEY_STAT
     key_counter.RegKey(t_id, KeyType::kKeyCommit, txn_name, set_it->header.table_id, set_it->header.key);
@@ -14,7 +53,7 @@ void TXN::CommitAll() {
     assert(set_it->target_write_pos != UN_INIT_POS);
 
     // Read-write data can only be read from primary
-    node_id_t p_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(set_it->header.table_id, PrimaryCrashTime::kDuringCommit);
+    node_id_t p_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(set_it->header.table_id, set_it->header.key, PrimaryCrashTime::kDuringCommit);
 
 #if HAVE_PRIMARY_CRASH
     if (p_node_id == PRIMARY_CRASH) {
@@ -24,7 +63,7 @@ void TXN::CommitAll() {
       RecoverPrimary(set_it->header.table_id, PrimaryCrashTime::kDuringCommit);
       event_counter.RegEvent(t_id, txn_name, "CommitAll:RecoverPrimary:Commit");
       // Re-get
-      p_node_id = global_meta_man->GetPrimaryNodeID(set_it->header.table_id);
+      p_node_id = global_meta_man->GetPrimaryNodeID(set_it->header.table_id, set_it->header.key);
     }
 #endif
 
@@ -45,19 +84,31 @@ void TXN::CommitAll() {
       addr_cache->Insert(p_node_id,
                          set_it->header.table_id,
                          set_it->header.key,
-                         set_it->header.remote_offset);
+                         set_it->header.remote_offset,
+                         set_it->header.remote_full_value_offset);
     }
 
-    RCQP* primary_qp = thread_qp_man->GetRemoteDataQPWithNodeID(p_node_id);
+    // Build the written data once for all the replicas
+    commit_writes.emplace_back(CommitWrite{set_it.get(), p_node_id, new_attr_bar, CommitPayload{}});
+    PreparePayload(set_it.get(), set_it->target_write_pos, set_it->user_op, new_attr_bar, commit_writes.back().payload);
+  }
+}
+
+void TXN::CommitAll() {
+  for (auto& write : commit_writes) {
+    DataSetItem* item = write.item;
+
+    RCQP* primary_qp = thread_qp_man->GetRemoteDataQPWithNodeID(write.primary_node_id);
     WriteReplica(primary_qp,
-                 set_it.get(),
-                 set_it->target_write_pos,
-                 set_it->user_op,
-                 new_attr_bar);
+                 item,
+                 item->target_write_pos,
+                 item->user_op,
+                 write.new_attr_bar,
+                 write.payload);
 
     // Commit backup
     bool need_recovery = false;
-    auto* backup_node_ids = global_meta_man->GetBackupNodeIDWithCrash(set_it->header.table_id, need_recovery);
+    auto* backup_node_ids = global_meta_man->GetBackupNodeIDWithCrash(item->header.table_id, item->header.key, need_recovery);
 
     if (!backup_node_ids) {
       // There are no backups in memory pool
@@ -66,7 +117,7 @@ void TXN::CommitAll() {
 
 #if HAVE_BACKUP_CRASH
     if (need_recovery) {
-      RecoverBackup(set_it->header.table_id, backup_node_ids->at(0));
+      RecoverBackup(item->header.table_id, backup_node_ids->at(0));
       event_counter.RegEvent(t_id, txn_name, "CommitAll:RecoverBackup:Commit");
     }
 #endif
@@ -75,10 +126,11 @@ void TXN::CommitAll() {
       RCQP* backup_qp = thread_qp_man->GetRemoteDataQPWithNodeID(backup_node_ids->at(i));
 
       WriteReplica(backup_qp,
-                   set_it.get(),
-                   set_it->target_write_pos,
-                   set_it->user_op,
-                   new_attr_bar);
+                   item,
+                   item->target_write_pos,
+                   item->user_op,
+                   write.new_attr_bar,
+                   write.payload);
     }
   }
 
@@ -158,30 +210,173 @@ static inline in_offset_t GetStartOff(const DataSetItem* item, bool& has_victim)
 }
 #endif
 
+void TXN::PreparePayload(DataSetItem* item,
+                         int write_pos,
+                         uint8_t user_op,
+                         bool new_attr_bar,
+                         CommitPayload& payload) {
+  // All the replicas receive the same data, so the buffers are built once and shared by their doorbells.
+  // These buffers are not modified after building, and they are not reused until the allocator wraps around,
+  // which is long after the last replica's requests complete
+  auto target_table_id = item->header.table_id;
+  auto vpkg_size = TABLE_VALUE_SIZE[target_table_id] + sizeof(anchor_t) * 2;
+
+  payload.unlock_buf = coro_rdma_buffer_alloc->Alloc(sizeof(lock_t));
+  *(lock_t*)payload.unlock_buf = 0;
+
+  switch (user_op) {
+    case UserOP::kDelete: {
+      if (item->is_delete_all_invalid) {
+        break;
+      }
+
+      payload.valid_buf = coro_rdma_buffer_alloc->Alloc(sizeof(valid_t));
+      *(valid_t*)payload.valid_buf = 0;
+
+      if (item->is_delete_no_read_value) {
+        break;
+      }
+
+      // Recover full value to an old version
+      uint8_t new_anchor;
+      if (item->is_delete_newest) {
+        // 1) Delete the newest version. anchor reduces by 1
+        if (item->valuepkg.sa > 0) {
+          new_anchor = item->valuepkg.sa - 1;
+        } else {
+          new_anchor = (item->header.remote_attribute_offset == UN_INIT_POS) ? 0 : 255;
+        }
+      } else {
+        // 2) Delete middle versions. anchor remains
+        new_anchor = item->valuepkg.sa;
+      }
+
+      payload.valuepkg_buf = coro_rdma_buffer_alloc->Alloc(vpkg_size);
+      char* p = payload.valuepkg_buf;
+      *((anchor_t*)p) = new_anchor;
+      p += sizeof(anchor_t);
+      // The modified attributes of the deleted version are already copied into valuepkg.value.
+      memcpy(p, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[target_table_id]);
+      p += TABLE_VALUE_SIZE[target_table_id];
+      *((anchor_t*)p) = new_anchor;
+      break;
+    }
+    case UserOP::kUpdate: {
+      // Spill the version I supersede before the header is copied into the victim cvt
+      if (gc_watermark) {
+        PrepareOverflow(item, payload);
+      }
+
+      // Prepare full value
+      uint8_t new_anchor = item->valuepkg.sa + 1;  // automatical wrap-around in 0-255
+
+      payload.valuepkg_buf = coro_rdma_buffer_alloc->Alloc(vpkg_size);
+      char* p = payload.valuepkg_buf;
+      *((anchor_t*)p) = new_anchor;
+      p += sizeof(anchor_t);
+      memcpy(p, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[target_table_id]);
+      p += TABLE_VALUE_SIZE[target_table_id];
+      *((anchor_t*)p) = new_anchor;
+
+      // New vcell
+      payload.vcell_buf = coro_rdma_buffer_alloc->Alloc(VCellSize);
+      VCell* new_vcell = (VCell*)payload.vcell_buf;
+
+      new_vcell->sa = new_anchor;
+      new_vcell->valid = 1;
+      new_vcell->version = commit_time;
+      payload.has_victim = false;
+      new_vcell->attri_so = GetStartOff(item, payload.has_victim);
+      new_vcell->attri_bitmap = item->update_bitmap;  // which attributes are modified
+      new_vcell->ea = new_anchor;
+
+      payload.delta_buf = coro_rdma_buffer_alloc->Alloc(item->current_p);  // I modify these attributes
+      memcpy(payload.delta_buf, item->old_value_ptr, item->current_p);
+
+      if (new_attr_bar) {
+        payload.attr_addr_buf = coro_rdma_buffer_alloc->Alloc(sizeof(offset_t));
+        *(offset_t*)payload.attr_addr_buf = item->header.remote_attribute_offset;
+      }
+
+      if (payload.has_victim) {
+        // The entire cvt is overwritten to invalidate the victim vcells
+        CVT* fetched_cvt = (CVT*)(item->fetched_cvt_ptr);
+        fetched_cvt->header.lock = lock_word;
+        fetched_cvt->header.remote_attribute_offset = item->header.remote_attribute_offset;
+        fetched_cvt->header.remote_overflow_offset = item->header.remote_overflow_offset;
+        fetched_cvt->vcell[write_pos] = *new_vcell;
+      }
+      break;
+    }
+    case UserOP::kInsert: {
+      // Prepare header
+      payload.header_buf = coro_rdma_buffer_alloc->Alloc(HeaderSize);
+      Header* new_header = (Header*)payload.header_buf;
+      new_header->table_id = target_table_id;
+      new_header->lock = STATE_UNLOCKED;
+      new_header->key = item->header.key;
+      // This offset is set in FindInsertOff
+      new_header->remote_offset = item->header.remote_offset;
+      // Allocate an offset in remote delta region to insert a full value
+      new_header->remote_full_value_offset = item->header.remote_full_value_offset;
+      new_header->remote_attribute_offset = UN_INIT_POS;
+      new_header->remote_overflow_offset = UN_INIT_POS;  // The spilled versions of a deleted row are dropped
+      new_header->value_size = item->header.value_size;
+      new_header->user_inserted = true;
+
+      // Prepare vcell
+      payload.vcell_buf = coro_rdma_buffer_alloc->Alloc(VCellSize);
+      VCell* new_vcell = (VCell*)payload.vcell_buf;
+
+      uint8_t new_anchor = 0;
+
+      new_vcell->sa = new_anchor;
+      new_vcell->valid = 1;
+      new_vcell->version = commit_time;
+      new_vcell->attri_so = 0;
+      new_vcell->attri_bitmap = 0;  // which attributes are modified
+      new_vcell->ea = new_anchor;
+
+      // Prepare full value
+      payload.valuepkg_buf = coro_rdma_buffer_alloc->Alloc(vpkg_size);
+      char* p = payload.valuepkg_buf;
+      *((anchor_t*)p) = new_anchor;
+      p += sizeof(anchor_t);
+      memcpy(p, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[target_table_id]);
+      p += TABLE_VALUE_SIZE[target_table_id];
+      *((anchor_t*)p) = new_anchor;
+      break;
+    }
+    default: {
+      RDMA_LOG(FATAL) << "Invalid write type!";
+    }
+  }
+}
+
 void TXN::WriteReplica(RCQP* qp,
                        const DataSetItem* item,
                        int write_pos,
                        uint8_t user_op,
-                       bool new_attr_bar) {
-  // We cannot use a shared data buf for all the written data, although it seems good
-  // to save buffers thanks to the sequential data sending. But it is totally wrong. The reason
-  // is that `ibv_post_send' does not guarantee that the RDMA NIC will actually send the data packets
-  // when `ibv_post_send' returns. In fact, the RDMA device sends the packets later in an **asynchronous** way.
-  // As a result, using a shared data buf will render a bug: The latter cvt will be written to the previous target machine, instead of the latter target machine.
+                       bool new_attr_bar,
+                       const CommitPayload& payload) {
+  // The payload buffers are shared by all the replicas. This is safe since their contents are the same
+  // for every target and are never changed after PreparePayload. Note that we still cannot reuse one buffer
+  // for *different* data, because `ibv_post_send' does not guarantee that the RDMA NIC will actually send
+  // the data packets when `ibv_post_send' returns. The RDMA device sends the packets later in an **asynchronous** way.
   // Here is the description of `ibv_post_send':
   // ibv_post_send() posts a linked list of Work Requests (WRs) to the Send Queue of a Queue Pair (QP). ibv_post_send() go over all of the entries in the linked list, one by one, check that it is valid, generate a HW-specific Send Request out of it and add it to the tail of the QP's Send Queue without performing any context switch. The RDMA device will handle it (later) in **asynchronous** way. If there is a failure in one of the WRs because the Send Queue is full or one of the attributes in the WR is bad, it stops immediately and return the pointer to that WR.
 
   switch (user_op) {
     case UserOP::kDelete: {
-      HandleDelete(qp, item, write_pos);
+      HandleDelete(qp, item, write_pos, payload);
       break;
     }
     case UserOP::kUpdate: {
-      HandleUpdate(qp, item, write_pos, new_attr_bar);
+      HandleUpdate(qp, item, write_pos, new_attr_bar, payload);
       break;
     }
     case UserOP::kInsert: {
-      HandleInsert(qp, item, write_pos);
+      HandleInsert(qp, item, write_pos, payload);
       break;
     }
     default: {
@@ -192,31 +387,19 @@ void TXN::WriteReplica(RCQP* qp,
   return;
 }
 
-void TXN::HandleDelete(RCQP* qp, const DataSetItem* item, int write_pos) {
-  char* unlock_buf = thread_rdma_buffer_alloc->Alloc(sizeof(lock_t));
-  *(lock_t*)unlock_buf = 0;
-
+void TXN::HandleDelete(RCQP* qp, const DataSetItem* item, int write_pos, const CommitPayload& payload) {
   if (item->is_delete_all_invalid) {
-    coro_sched->RDMAWrite(coro_id, qp, unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
+    SendCommitWrite(qp, payload.unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
 
     // CheckAddr(item->GetRemoteLockAddr(), sizeof(lock_t), "HandleDelete:1:UnlockReq");
     return;
   }
 
-  // New full value space
-  auto target_table_id = item->header.table_id;
-  auto vpkg_size = TABLE_VALUE_SIZE[target_table_id] + sizeof(anchor_t) * 2;
-  char* valuepkg_buf = thread_rdma_buffer_alloc->Alloc(vpkg_size);
-  char* p = valuepkg_buf;
-
-  char* valid_buf = thread_rdma_buffer_alloc->Alloc(sizeof(valid_t));
-  *(valid_t*)valid_buf = 0;
-
   if (item->is_delete_no_read_value) {
-    std::shared_ptr<DeleteNoFVBatch> doorbell = std::make_shared<DeleteNoFVBatch>();
-    doorbell->SetInvalidReq(valid_buf, item->GetRemoteValidAddr(write_pos), sizeof(valid_t));
-    doorbell->UnlockReq(unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
-    doorbell->SendReqs(coro_sched, qp, coro_id);
+    DeleteNoFVBatch doorbell;
+    doorbell.SetInvalidReq(payload.valid_buf, item->GetRemoteValidAddr(write_pos), sizeof(valid_t));
+    doorbell.UnlockReq(payload.unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
+    SendCommitReqs(doorbell, qp);
 
     // CheckAddr(item->GetRemoteValidAddr(write_pos), sizeof(valid_t), "HandleDelete:1:SetInvalidReq");
     // CheckAddr(item->GetRemoteLockAddr(), sizeof(lock_t), "HandleDelete:1:UnlockReq");
@@ -224,33 +407,13 @@ void TXN::HandleDelete(RCQP* qp, const DataSetItem* item, int write_pos) {
     return;
   }
 
-  // Recover full value to an old version.
-
-  uint8_t new_anchor;
-  if (item->is_delete_newest) {
-    // 1) Delete the newest version. anchor reduces by 1
-    if (item->valuepkg.sa > 0) {
-      new_anchor = item->valuepkg.sa - 1;
-    } else {
-      new_anchor = (item->header.remote_attribute_offset == UN_INIT_POS) ? 0 : 255;
-    }
-  } else {
-    // 2) Delete middle versions. anchor remains
-    new_anchor = item->valuepkg.sa;
-  }
-
-  *((anchor_t*)p) = new_anchor;
-  p += sizeof(anchor_t);
-  // The modified attributes of the deleted version are already copied into valuepkg.value.
-  memcpy(p, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[target_table_id]);
-  p += TABLE_VALUE_SIZE[target_table_id];
-  *((anchor_t*)p) = new_anchor;
+  auto vpkg_size = TABLE_VALUE_SIZE[item->header.table_id] + sizeof(anchor_t) * 2;
 
-  std::shared_ptr<DeleteBatch> doorbell = std::make_shared<DeleteBatch>();
-  doorbell->SetInvalidReq(valid_buf, item->GetRemoteValidAddr(write_pos), sizeof(valid_t));
-  doorbell->SetValueReq(valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
-  doorbell->UnlockReq(unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
-  doorbell->SendReqs(coro_sched, qp, coro_id);
+  DeleteBatch doorbell;
+  doorbell.SetInvalidReq(payload.valid_buf, item->GetRemoteValidAddr(write_pos), sizeof(valid_t));
+  doorbell.SetValueReq(payload.valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
+  doorbell.UnlockReq(payload.unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
+  SendCommitReqs(doorbell, qp);
 
   // CheckAddr(item->GetRemoteValidAddr(write_pos), sizeof(valid_t), "HandleDelete:2:SetInvalidReq");
   // CheckAddr(item->header.remote_full_value_offset, vpkg_size, "HandleDelete:2:SetValueReq");
@@ -260,52 +423,29 @@ void TXN::HandleDelete(RCQP* qp, const DataSetItem* item, int write_pos) {
 void TXN::HandleUpdate(RCQP* qp,
                        const DataSetItem* item,
                        int write_pos,
-                       bool new_attr_bar) {
-  // New full value space
-  auto target_table_id = item->header.table_id;
-  auto vpkg_size = TABLE_VALUE_SIZE[target_table_id] + sizeof(anchor_t) * 2;
-  char* valuepkg_buf = thread_rdma_buffer_alloc->Alloc(vpkg_size);
-  char* p = valuepkg_buf;
-
-  // Prepare full value
-  uint8_t new_anchor = item->valuepkg.sa + 1;  // automatical wrap-around in 0-255
-
-  *((anchor_t*)p) = new_anchor;
-  p += sizeof(anchor_t);
-  memcpy(p, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[target_table_id]);
-  p += TABLE_VALUE_SIZE[target_table_id];
-  *((anchor_t*)p) = new_anchor;
-
-  // New vcell
-  char* vcell_buf = thread_rdma_buffer_alloc->Alloc(VCellSize);
-  VCell* new_vcell = (VCell*)vcell_buf;
-
-  new_vcell->sa = new_anchor;
-  new_vcell->valid = 1;
-  new_vcell->version = commit_time;
-  bool has_victim = false;
-  new_vcell->attri_so = GetStartOff(item, has_victim);
-  new_vcell->attri_bitmap = item->update_bitmap;  // which attributes are modified
-  new_vcell->ea = new_anchor;
-
-  char* unlock_buf = thread_rdma_buffer_alloc->Alloc(sizeof(lock_t));
-  *(lock_t*)unlock_buf = 0;
-
-  char* delta_buf = thread_rdma_buffer_alloc->Alloc(item->current_p);  // I modify these attributes
-  memcpy(delta_buf, item->old_value_ptr, item->current_p);
+                       bool new_attr_bar,
+                       const CommitPayload& payload) {
+  auto vpkg_size = TABLE_VALUE_SIZE[item->header.table_id] + sizeof(anchor_t) * 2;
+  VCell* new_vcell = (VCell*)payload.vcell_buf;
+
+  if (payload.overflow_head_buf) {
+    // Posted before the doorbell in the same QP, so the spilled version lands before the unlock
+    size_t record_size = OverflowHeaderSize + TABLE_VALUE_SIZE[item->header.table_id];
+    if (payload.overflow_buf) {
+      SendCommitWrite(qp, payload.overflow_buf, item->header.remote_overflow_offset, record_size);
+    }
+    SendCommitWrite(qp, payload.overflow_head_buf, item->GetRemoteOverflowAddr(), sizeof(offset_t));
+  }
 
   if (new_attr_bar) {
-    if (!has_victim) {
-      char* attr_addr_buf = thread_rdma_buffer_alloc->Alloc(sizeof(offset_t));
-      *(offset_t*)attr_addr_buf = item->header.remote_attribute_offset;
-
-      auto doorbell = std::make_shared<UpdateBatchAttrAddr>();
-      doorbell->SetValueReq(valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
-      doorbell->SetDeltaReq(delta_buf, item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p);
-      doorbell->SetAttrAddrReq(attr_addr_buf, item->GetRemoteAttrAddr(), sizeof(offset_t));
-      doorbell->SetVCellReq(vcell_buf, item->GetRemoteVCellAddr(write_pos), VCellSize);
-      doorbell->UnlockReq(unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+    if (!payload.has_victim) {
+      UpdateBatchAttrAddr doorbell;
+      doorbell.SetValueReq(payload.valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
+      doorbell.SetDeltaReq(payload.delta_buf, item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p);
+      doorbell.SetAttrAddrReq(payload.attr_addr_buf, item->GetRemoteAttrAddr(), sizeof(offset_t));
+      doorbell.SetVCellReq(payload.vcell_buf, item->GetRemoteVCellAddr(write_pos), VCellSize);
+      doorbell.UnlockReq(payload.unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
+      SendCommitReqs(doorbell, qp);
 
       // CheckAddr(item->header.remote_full_value_offset, vpkg_size, "HandleUpdate:1:SetValueReq");
       // CheckAddr(item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p, "HandleUpdate:1:SetDeltaReq");
@@ -313,32 +453,24 @@ void TXN::HandleUpdate(RCQP* qp,
       // CheckAddr(item->GetRemoteAttrAddr(), sizeof(offset_t), "HandleUpdate:1:SetAttrAddrReq");
       // CheckAddr(item->GetRemoteLockAddr(), sizeof(lock_t), "HandleUpdate:1:UnlockReq");
     } else {
-      CVT* fetched_cvt = (CVT*)(item->fetched_cvt_ptr);
-      fetched_cvt->header.lock = tx_id;
-      fetched_cvt->header.remote_attribute_offset = item->header.remote_attribute_offset;
-      fetched_cvt->vcell[write_pos] = *new_vcell;
-
-      auto doorbell = std::make_shared<UpdateBatch>();
-      doorbell->SetValueReq(valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
-      doorbell->SetDeltaReq(delta_buf, item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p);
-      doorbell->SetVCellOrCVTReq(item->fetched_cvt_ptr, item->header.remote_offset, CVTSize);
-      doorbell->UnlockReq(unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      UpdateBatch doorbell;
+      doorbell.SetValueReq(payload.valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
+      doorbell.SetDeltaReq(payload.delta_buf, item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p);
+      doorbell.SetVCellOrCVTReq(item->fetched_cvt_ptr, item->header.remote_offset, CVTSize);
+      doorbell.UnlockReq(payload.unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
+      SendCommitReqs(doorbell, qp);
     }
   } else {
-    auto doorbell = std::make_shared<UpdateBatch>();
-    doorbell->SetValueReq(valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
-    doorbell->SetDeltaReq(delta_buf, item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p);
-    if (!has_victim) {
-      doorbell->SetVCellOrCVTReq(vcell_buf, item->GetRemoteVCellAddr(write_pos), VCellSize);
+    UpdateBatch doorbell;
+    doorbell.SetValueReq(payload.valuepkg_buf, item->header.remote_full_value_offset, vpkg_size);
+    doorbell.SetDeltaReq(payload.delta_buf, item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p);
+    if (!payload.has_victim) {
+      doorbell.SetVCellOrCVTReq(payload.vcell_buf, item->GetRemoteVCellAddr(write_pos), VCellSize);
     } else {
-      CVT* fetched_cvt = (CVT*)(item->fetched_cvt_ptr);
-      fetched_cvt->header.lock = tx_id;
-      fetched_cvt->vcell[write_pos] = *new_vcell;
-      doorbell->SetVCellOrCVTReq(item->fetched_cvt_ptr, item->header.remote_offset, CVTSize);
+      doorbell.SetVCellOrCVTReq(item->fetched_cvt_ptr, item->header.remote_offset, CVTSize);
     }
-    doorbell->UnlockReq(unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
-    doorbell->SendReqs(coro_sched, qp, coro_id);
+    doorbell.UnlockReq(payload.unlock_buf, item->GetRemoteLockAddr(), sizeof(lock_t));
+    SendCommitReqs(doorbell, qp);
 
     // CheckAddr(item->header.remote_full_value_offset, vpkg_size, "HandleUpdate:2:SetValueReq");
     // CheckAddr(item->header.remote_attribute_offset + new_vcell->attri_so, item->current_p, "HandleUpdate:2:SetDeltaReq");
@@ -349,52 +481,16 @@ void TXN::HandleUpdate(RCQP* qp,
 
 void TXN::HandleInsert(RCQP* qp,
                        const DataSetItem* item,
-                       int write_pos) {
-  // New full value space
-  auto target_table_id = item->header.table_id;
-  auto vpkg_size = TABLE_VALUE_SIZE[target_table_id] + sizeof(anchor_t) * 2;
-  char* valuepkg_buf = thread_rdma_buffer_alloc->Alloc(vpkg_size);
-  char* p = valuepkg_buf;
-
-  // Prepare header
-  char* header_buf = thread_rdma_buffer_alloc->Alloc(HeaderSize);
-  Header* new_header = (Header*)header_buf;
-  new_header->table_id = target_table_id;
-  new_header->lock = STATE_UNLOCKED;
-  new_header->key = item->header.key;
-  // This offset is set in FindInsertOff
-  new_header->remote_offset = item->header.remote_offset;
-  // Allocate an offset in remote delta region to insert a full value
-  new_header->remote_full_value_offset = item->header.remote_full_value_offset;
-  new_header->remote_attribute_offset = UN_INIT_POS;
-  new_header->value_size = item->header.value_size;
-  new_header->user_inserted = true;
-
-  // Prepare vcell
-  char* vcell_buf = thread_rdma_buffer_alloc->Alloc(VCellSize);
-  VCell* new_vcell = (VCell*)vcell_buf;
-
-  uint8_t new_anchor = 0;
-
-  new_vcell->sa = new_anchor;
-  new_vcell->valid = 1;
-  new_vcell->version = commit_time;
-  new_vcell->attri_so = 0;
-  new_vcell->attri_bitmap = 0;  // which attributes are modified
-  new_vcell->ea = new_anchor;
-
-  // Prepare full value
-  *((anchor_t*)p) = new_anchor;
-  p += sizeof(anchor_t);
-  memcpy(p, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[target_table_id]);
-  p += TABLE_VALUE_SIZE[target_table_id];
-  *((anchor_t*)p) = new_anchor;
-
-  std::shared_ptr<InsertBatch> doorbell = std::make_shared<InsertBatch>();
-  doorbell->SetValueReq(valuepkg_buf, new_header->remote_full_value_offset, vpkg_size);
-  doorbell->SetVCellReq(vcell_buf, item->GetRemoteVCellAddr(write_pos), VCellSize);
-  doorbell->SetHeaderReq(header_buf, new_header->remote_offset, HeaderSize);
-  doorbell->SendReqs(coro_sched, qp, coro_id);
+                       int write_pos,
+                       const CommitPayload& payload) {
+  auto vpkg_size = TABLE_VALUE_SIZE[item->header.table_id] + sizeof(anchor_t) * 2;
+  Header* new_header = (Header*)payload.header_buf;
+
+  InsertBatch doorbell;
+  doorbell.SetValueReq(payload.valuepkg_buf, new_header->remote_full_value_offset, vpkg_size);
+  doorbell.SetVCellReq(payload.vcell_buf, item->GetRemoteVCellAddr(write_pos), VCellSize);
+  doorbell.SetHeaderReq(payload.header_buf, new_header->remote_offset, HeaderSize);
+  SendCommitReqs(doorbell, qp);
 
   // CheckAddr(new_header->remote_full_value_offset, vpkg_size, "HandleInsert:SetValueReq");
   // CheckAddr(item->GetRemoteVCellAddr(write_pos), VCellSize, "HandleInsert:SetVCellReq");
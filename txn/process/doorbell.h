@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include "base/common.h"
+#include "process/lease.h"
 #include "process/structs.h"
 #include "rlib/rdma_ctrl.hpp"
 #include "scheduler/corotine_scheduler.h"
@@ -12,6 +17,117 @@ using namespace rdmaio;
 
 static const int MAX_DOORBELL_LEN = 124;
 
+// At most these requests are staged for one qp in group commit. Keep them within the send queue
+static const int MAX_GROUP_COMMIT_WR = 256;
+
+// Record the writes of a commit doorbell in the redo log. The remote addresses are still offsets
+ALWAYS_INLINE
+void LogWriteReqs(RedoLogBuilder* redo, const ibv_send_wr* sr, const ibv_sge* sge, int num) {
+  for (int i = 0; i < num; i++) {
+    if (sr[i].opcode == IBV_WR_RDMA_WRITE) {
+      redo->AddWrite(sr[i].wr.rdma.remote_addr, (const char*)sge[i].addr, sge[i].length);
+    }
+  }
+}
+
+// Group commit. The commit requests of the coroutines in one thread are staged, and then
+// posted as one doorbell per qp. Only the last request of each doorbell is signaled, and its
+// completion wakes up all the participating coroutines.
+// The staged requests are posted when `group_size' coroutines join, or when all the coroutines
+// wait (i.e., the end of a scheduling round). A larger group saves more doorbells and completions
+// at the cost of commit latency
+class CommitStage {
+ public:
+  CommitStage(CoroutineScheduler* sched, int size) : coro_sched(sched), group_size(size) {}
+
+  // Copy the linked requests. The remote addresses and keys are already set
+  void AddReqs(RCQP* qp, coro_id_t coro_id, ibv_send_wr* sr, ibv_sge* sge, int num) {
+    auto search = chains.find(qp);
+    if (search != chains.end() && search->second.sr.size() + num > MAX_GROUP_COMMIT_WR) {
+      Flush();
+    }
+
+    if (std::find(members.begin(), members.end(), coro_id) == members.end()) {
+      // The coroutine waits until its requests are posted and completed
+      members.push_back(coro_id);
+      coro_sched->HoldCoroutine(coro_id);
+    }
+
+    StagedChain& chain = chains[qp];
+    for (int i = 0; i < num; i++) {
+      chain.sr.push_back(sr[i]);
+      chain.sge.push_back(sge[i]);
+    }
+  }
+
+  void AddWriteReq(RCQP* qp, coro_id_t coro_id, char* local_addr, uint64_t remote_off, size_t size) {
+    struct ibv_send_wr sr {};
+    struct ibv_sge sge {};
+    sr.opcode = IBV_WR_RDMA_WRITE;
+    sr.num_sge = 1;
+    sr.wr.rdma.remote_addr = remote_off + qp->remote_mr_.buf;
+    sr.wr.rdma.rkey = qp->remote_mr_.key;
+    if (size <= MAX_DOORBELL_LEN) {
+      sr.send_flags = IBV_SEND_INLINE;
+    }
+    sge.addr = (uint64_t)local_addr;
+    sge.length = size;
+    sge.lkey = qp->local_mr_.key;
+    AddReqs(qp, coro_id, &sr, &sge, 1);
+  }
+
+  // The coroutine has staged all its commit requests
+  void Join(coro_yield_t& yield, coro_id_t coro_id) {
+    if (members.size() >= group_size) {
+      Flush();
+    }
+    coro_sched->Yield(yield, coro_id);
+  }
+
+  void Flush() {
+    if (members.empty()) return;
+
+    uint64_t group_id = coro_sched->NewGroup(members);
+
+    for (auto& it : chains) {
+      auto& sr = it.second.sr;
+      auto& sge = it.second.sge;
+      for (size_t i = 0; i < sr.size(); i++) {
+        sr[i].sg_list = &sge[i];
+        sr[i].send_flags &= ~IBV_SEND_SIGNALED;
+        sr[i].next = sr.data() + i + 1;
+      }
+      sr.back().send_flags |= IBV_SEND_SIGNALED;
+      sr.back().next = NULL;
+
+      coro_sched->RDMAGroupBatch(group_id, it.first, &(sr[0]), &bad_sr, sr.size() - 1);
+    }
+
+    chains.clear();
+    members.clear();
+  }
+
+  bool IsEmpty() const {
+    return members.empty();
+  }
+
+ private:
+  struct StagedChain {
+    std::vector<ibv_send_wr> sr;
+    std::vector<ibv_sge> sge;
+  };
+
+  CoroutineScheduler* coro_sched;
+
+  size_t group_size;
+
+  std::unordered_map<RCQP*, StagedChain> chains;
+
+  std::vector<coro_id_t> members;
+
+  struct ibv_send_wr* bad_sr;
+};
+
 // Several RDMA requests are sent to the QP in a doorbelled (or batched) way.
 // These requests are executed within one round trip
 // Target: improve performance
@@ -75,6 +191,55 @@ class LockReadBatch {
   struct ibv_send_wr* bad_sr;
 };
 
+// Read the CVT and the full value at its cached offset in one round trip
+class ReadCVTValueBatch {
+ public:
+  ReadCVTValueBatch() {
+    sr[0].num_sge = 1;
+    sr[0].sg_list = &sge[0];
+    sr[0].send_flags = 0;
+    sr[0].next = &sr[1];
+
+    sr[1].num_sge = 1;
+    sr[1].sg_list = &sge[1];
+    sr[1].send_flags = IBV_SEND_SIGNALED;
+    sr[1].next = NULL;
+  }
+
+  void SetReadCVTReq(char* local_addr, uint64_t remote_off, size_t size) {
+    sr[0].opcode = IBV_WR_RDMA_READ;
+    sr[0].wr.rdma.remote_addr = remote_off;
+    sge[0].addr = (uint64_t)local_addr;
+    sge[0].length = size;
+  }
+
+  void SetReadValueReq(char* local_addr, uint64_t remote_off, size_t size) {
+    sr[1].opcode = IBV_WR_RDMA_READ;
+    sr[1].wr.rdma.remote_addr = remote_off;
+    sge[1].addr = (uint64_t)local_addr;
+    sge[1].length = size;
+  }
+
+  void SendReqs(CoroutineScheduler* coro_sched, RCQP* qp, coro_id_t coro_id) {
+    sr[0].wr.rdma.remote_addr += qp->remote_mr_.buf;
+    sr[0].wr.rdma.rkey = qp->remote_mr_.key;
+    sge[0].lkey = qp->local_mr_.key;
+
+    sr[1].wr.rdma.remote_addr += qp->remote_mr_.buf;
+    sr[1].wr.rdma.rkey = qp->remote_mr_.key;
+    sge[1].lkey = qp->local_mr_.key;
+
+    coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, 1);
+  }
+
+ private:
+  struct ibv_send_wr sr[2];
+
+  struct ibv_sge sge[2];
+
+  struct ibv_send_wr* bad_sr;
+};
+
 class LockReadTwoBatch {
  public:
   LockReadTwoBatch() {
@@ -541,6 +706,22 @@ class DeleteNoFVBatch {
     coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, 1);
   }
 
+  // Stage the requests for group commit
+  void SendReqs(CommitStage* commit_stage, RCQP* qp, coro_id_t coro_id) {
+    for (int i = 0; i < 2; i++) {
+      sr[i].wr.rdma.remote_addr += qp->remote_mr_.buf;
+      sr[i].wr.rdma.rkey = qp->remote_mr_.key;
+      sge[i].lkey = qp->local_mr_.key;
+    }
+
+    commit_stage->AddReqs(qp, coro_id, &(sr[0]), &(sge[0]), 2);
+  }
+
+  // Record the writes in the redo log instead of sending them
+  void LogReqs(RedoLogBuilder* redo) const {
+    LogWriteReqs(redo, sr, sge, 2);
+  }
+
  private:
   struct ibv_send_wr sr[2];
 
@@ -605,6 +786,22 @@ class DeleteBatch {
     coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, 2);
   }
 
+  // Stage the requests for group commit
+  void SendReqs(CommitStage* commit_stage, RCQP* qp, coro_id_t coro_id) {
+    for (int i = 0; i < 3; i++) {
+      sr[i].wr.rdma.remote_addr += qp->remote_mr_.buf;
+      sr[i].wr.rdma.rkey = qp->remote_mr_.key;
+      sge[i].lkey = qp->local_mr_.key;
+    }
+
+    commit_stage->AddReqs(qp, coro_id, &(sr[0]), &(sge[0]), 3);
+  }
+
+  // Record the writes in the redo log instead of sending them
+  void LogReqs(RedoLogBuilder* redo) const {
+    LogWriteReqs(redo, sr, sge, 3);
+  }
+
  private:
   struct ibv_send_wr sr[3];
 
@@ -687,6 +884,22 @@ class UpdateBatch {
     coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, 3);
   }
 
+  // Stage the requests for group commit
+  void SendReqs(CommitStage* commit_stage, RCQP* qp, coro_id_t coro_id) {
+    for (int i = 0; i < 4; i++) {
+      sr[i].wr.rdma.remote_addr += qp->remote_mr_.buf;
+      sr[i].wr.rdma.rkey = qp->remote_mr_.key;
+      sge[i].lkey = qp->local_mr_.key;
+    }
+
+    commit_stage->AddReqs(qp, coro_id, &(sr[0]), &(sge[0]), 4);
+  }
+
+  // Record the writes in the redo log instead of sending them
+  void LogReqs(RedoLogBuilder* redo) const {
+    LogWriteReqs(redo, sr, sge, 4);
+  }
+
  private:
   struct ibv_send_wr sr[4];
 
@@ -780,6 +993,22 @@ class UpdateBatchAttrAddr {
     coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, 4);
   }
 
+  // Stage the requests for group commit
+  void SendReqs(CommitStage* commit_stage, RCQP* qp, coro_id_t coro_id) {
+    for (int i = 0; i < 5; i++) {
+      sr[i].wr.rdma.remote_addr += qp->remote_mr_.buf;
+      sr[i].wr.rdma.rkey = qp->remote_mr_.key;
+      sge[i].lkey = qp->local_mr_.key;
+    }
+
+    commit_stage->AddReqs(qp, coro_id, &(sr[0]), &(sge[0]), 5);
+  }
+
+  // Record the writes in the redo log instead of sending them
+  void LogReqs(RedoLogBuilder* redo) const {
+    LogWriteReqs(redo, sr, sge, 5);
+  }
+
  private:
   struct ibv_send_wr sr[5];
 
@@ -847,6 +1076,22 @@ class InsertBatch {
     coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, 2);
   }
 
+  // Stage the requests for group commit
+  void SendReqs(CommitStage* commit_stage, RCQP* qp, coro_id_t coro_id) {
+    for (int i = 0; i < 3; i++) {
+      sr[i].wr.rdma.remote_addr += qp->remote_mr_.buf;
+      sr[i].wr.rdma.rkey = qp->remote_mr_.key;
+      sge[i].lkey = qp->local_mr_.key;
+    }
+
+    commit_stage->AddReqs(qp, coro_id, &(sr[0]), &(sge[0]), 3);
+  }
+
+  // Record the writes in the redo log instead of sending them
+  void LogReqs(RedoLogBuilder* redo) const {
+    LogWriteReqs(redo, sr, sge, 3);
+  }
+
  private:
   struct ibv_send_wr sr[3];
 
@@ -854,3 +1099,60 @@ class InsertBatch {
 
   struct ibv_send_wr* bad_sr;
 };
+
+// Reading the lock and vcells of multiple read-only CVTs on the same MN in one doorbell.
+// Only the last request is signaled
+static const int MAX_VALIDATE_BATCH_NUM = 64;
+
+class ValidateBatch {
+ public:
+  ValidateBatch() : req_num(0) {
+    for (int i = 0; i < MAX_VALIDATE_BATCH_NUM; i++) {
+      sr[i].num_sge = 1;
+      sr[i].sg_list = &sge[i];
+      sr[i].send_flags = 0;
+      sr[i].opcode = IBV_WR_RDMA_READ;
+    }
+  }
+
+  void AddReadReq(char* local_addr, uint64_t remote_off, size_t size) {
+    // Read cannot set send_flags IBV_SEND_INLINE
+    sr[req_num].wr.rdma.remote_addr = remote_off;
+    sge[req_num].addr = (uint64_t)local_addr;
+    sge[req_num].length = size;
+    req_num++;
+  }
+
+  bool IsFull() const {
+    return req_num == MAX_VALIDATE_BATCH_NUM;
+  }
+
+  bool IsEmpty() const {
+    return req_num == 0;
+  }
+
+  // Send doorbelled requests to the queue pair, and reset the batch for reuse
+  void SendReqs(CoroutineScheduler* coro_sched, RCQP* qp, coro_id_t coro_id) {
+    for (int i = 0; i < req_num; i++) {
+      sr[i].wr.rdma.remote_addr += qp->remote_mr_.buf;
+      sr[i].wr.rdma.rkey = qp->remote_mr_.key;
+      sge[i].lkey = qp->local_mr_.key;
+      sr[i].send_flags = 0;
+      sr[i].next = &sr[i + 1];
+    }
+    sr[req_num - 1].send_flags = IBV_SEND_SIGNALED;
+    sr[req_num - 1].next = NULL;
+
+    coro_sched->RDMABatch(coro_id, qp, &(sr[0]), &bad_sr, req_num - 1);
+    req_num = 0;
+  }
+
+ private:
+  int req_num;
+
+  struct ibv_send_wr sr[MAX_VALIDATE_BATCH_NUM];
+
+  struct ibv_sge sge[MAX_VALIDATE_BATCH_NUM];
+
+  struct ibv_send_wr* bad_sr;
+};
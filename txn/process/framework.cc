@@ -5,12 +5,69 @@
 
 #include <bitset>
 
+bool TXN::BeginAsOf(coro_yield_t& yield, tx_id_t as_of_ts, const char* name) {
+  // The snapshot is published as my start time, which holds back the GC watermark while I run
+  Begin(as_of_ts, TXN_TYPE::kROTxn, name, ISOLATION::SI);
+  is_as_of = true;
+
+  if (as_of_ts > tx_id_generator.load()) {
+    // The txns that commit at or before as_of_ts may be yet to come
+    event_counter.RegEvent(t_id, txn_name, "BeginAsOf:FutureTimestamp");
+    return false;
+  }
+
+  if (!gc_watermark) {
+    return true;
+  }
+
+  // My pin stops the retention floor from moving, and the writers reuse no version visible at it
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetGCSlotNodeID());
+  if (!coro_sched->RDMAFAA(coro_id, qp, gc_pin_buf, global_meta_man->GetGCFloorOffset(), 1)) {
+    return false;
+  }
+  coro_sched->Yield(yield, coro_id);
+  as_of_pinned = true;
+
+  tx_id_t floor = GCWatermark::FloorTs(*(uint64_t*)gc_pin_buf);
+  if (floor == GCWatermark::UNKNOWN || as_of_ts < floor) {
+    event_counter.RegEvent(t_id, txn_name, "BeginAsOf:BelowFloor");
+    Unpublish();
+    return false;
+  }
+  return true;
+}
+
+tx_id_t TXN::OldestReadableTime(table_id_t table_id) const {
+  if (table_cache && table_cache->IsCached(table_id)) {
+    // A read-only table keeps the loaded version
+    return 1;
+  }
+
+  // The other tables share the retention floor. The floor stays at or below the announced next floor for
+  // GC_FLOOR_GRACE_MS after my last refresh, see txn.h
+  tx_id_t next_floor = gc_watermark ? gc_watermark->GetNextFloor() : GCWatermark::UNKNOWN;
+  if (next_floor == GCWatermark::UNKNOWN) {
+    return tx_id_generator.load();
+  }
+  return next_floor;
+}
+
 bool TXN::Execute(coro_yield_t& yield, bool fail_abort) {
   // Start executing transaction
   if (read_write_set.empty() && read_only_set.empty()) {
     return true;
   }
 
+  if (is_as_of && !read_write_set.empty()) {
+    event_counter.RegEvent(t_id, txn_name, "Execute:AsOf:WriteInPast");
+    goto ABORT;
+  }
+
+  if (iso_level == ISOLATION::RC && !is_as_of) {
+    // Each statement sees the versions committed before it starts
+    start_time = tx_id_generator.load();
+  }
+
   // Run our system
   if (read_write_set.empty()) {
     if (!ExeRO(yield)) {
@@ -31,28 +88,142 @@ bool TXN::Execute(coro_yield_t& yield, bool fail_abort) {
   return true;
 
 ABORT:
+#if LEASE_LOCK
+  ReleaseExpiredLocks(yield);
+#endif
   if (fail_abort) Abort();
   return false;
 }
 
+bool TXN::ExecuteBatch(coro_yield_t& yield, std::vector<DataSetItemPtr>& batch, bool fail_abort) {
+  // Deduplicate keys. Only the first item of each key is read. The keys are sorted in the reused buffer
+  // instead of hashed, since a batch is small
+  batch_keys.clear();
+  batch_dups.clear();
+  for (size_t i = 0; i < batch.size(); i++) {
+    assert(batch[i]->user_op == UserOP::kRead);
+    batch_keys.emplace_back(BatchKey{.table_id = batch[i]->header.table_id, .key = batch[i]->header.key, .index = i});
+  }
+  std::sort(batch_keys.begin(), batch_keys.end());
+
+  DataSetItem* read_item = nullptr;  // The first item of the current key
+  for (size_t i = 0; i < batch_keys.size(); i++) {
+    DataSetItem* item = batch[batch_keys[i].index].get();
+    if (i > 0 && batch_keys[i].SameKey(batch_keys[i - 1])) {
+      batch_dups.emplace_back(item, read_item);
+      continue;
+    }
+    item->is_try_read = true;
+    read_item = item;
+  }
+
+  // Keep the batch order in the read only set
+  for (auto& item : batch) {
+    if (item->is_try_read) AddToReadOnlySet(item);
+  }
+
+  // All the cvts or buckets are read in one phase
+  if (!Execute(yield, fail_abort)) {
+    return false;
+  }
+
+  // The not found items should not be validated
+  read_only_set.erase(std::remove_if(read_only_set.begin(),
+                                     read_only_set.end(),
+                                     [](const DataSetItemPtr& item) { return item->is_not_found; }),
+                      read_only_set.end());
+
+  for (auto& dup : batch_dups) {
+    DataSetItem* from = dup.second;
+    DataSetItem* to = dup.first;
+    to->header = from->header;
+    to->vcell = from->vcell;
+    to->valuepkg.sa = from->valuepkg.sa;
+    to->valuepkg.ea = from->valuepkg.ea;
+    memcpy(to->valuepkg.value, from->valuepkg.value, TABLE_VALUE_SIZE[from->header.table_id]);
+    to->fetched_cvt_ptr = from->fetched_cvt_ptr;
+    to->is_fetched = from->is_fetched;
+    to->read_which_node = from->read_which_node;
+    to->latest_anchor = from->latest_anchor;
+    to->is_try_read = true;
+    to->is_not_found = from->is_not_found;
+  }
+
+  return true;
+}
+
 bool TXN::Commit(coro_yield_t& yield) {
+  if (txn_watermark) {
+    // The execution has waited for all my requests, including the writes of my last commit
+    RetireUnlinkedDeltas();
+    RetireUnlinkedChains(yield);
+  }
+
+  if (gc_watermark) {
+    RefreshGCWatermark();
+  }
+
   // In MVCC, read-only txn directly commits
   if (read_write_set.empty()) {
+    Unpublish();
     return true;
   }
 
   // After obtaining all locks, I get the commit timestamp
   commit_time = ++tx_id_generator;
 
+#if LEASE_LOCK
+  // The commit status is set together with validation
+  if (status_active) {
+    IssueCommitStatus();
+  }
+#endif
+
   if (!Validate(yield)) {
     goto ABORT;
   }
 
+#if LEASE_LOCK
+  coro_sched->Yield(yield, coro_id);
+  if (status_active && !CheckCommitStatus()) {
+    goto ABORT;
+  }
+#endif
+
+  EnsureDeltaSpace(yield);
+
+#if LEASE_LOCK
+  // Checked before the payloads take the delta space
+  if (status_active && !CanLogRedo()) {
+    goto ABORT;
+  }
+#endif
+
+  PrepareCommit();
+
+#if LEASE_LOCK
+  if (status_active) {
+    LogRedo(yield);
+  }
+#endif
+
   CommitAll();
 
+  if (commit_stage) {
+    // Wait until the staged writes are posted together with other coroutines' and completed
+    commit_stage->Join(yield, coro_id);
+  }
+
+  committed_unlinked_deltas.insert(committed_unlinked_deltas.end(), unlinked_deltas.begin(), unlinked_deltas.end());
+  committed_unlinked_chains.insert(committed_unlinked_chains.end(), unlinked_chains.begin(), unlinked_chains.end());
+
+  Unpublish();
   return true;
 
 ABORT:
+#if LEASE_LOCK
+  ReleaseExpiredLocks(yield);
+#endif
   Abort();
   return false;
 }
@@ -60,8 +231,9 @@ ABORT:
 // Two reads. First reading the correct version's address, then reading the data itself
 bool TXN::ExeRO(coro_yield_t& yield) {
   // You can read from primary or backup
-  std::vector<DirectRead> pending_direct_ro;
-  std::vector<HashRead> pending_hash_read;
+  pending.Clear();
+  auto& pending_direct_ro = pending.direct_ro;
+  auto& pending_hash_read = pending.hash_read;
 
   // Issue reads
   if (!IssueReadROCVT(pending_direct_ro, pending_hash_read)) {
@@ -71,7 +243,7 @@ bool TXN::ExeRO(coro_yield_t& yield) {
   // Yield to other coroutines when waiting for network replies
   coro_sched->Yield(yield, coro_id);
 
-  std::vector<ValueRead> pending_value_read;
+  auto& pending_value_read = pending.value_read;
 
   // Receive cvts and issue requests to obtain the raw data
   if (!CheckDirectROCVT(pending_direct_ro, pending_value_read)) {
@@ -89,24 +261,34 @@ bool TXN::ExeRO(coro_yield_t& yield) {
     }
   }
 
+  if (!overflow_reads.empty() && !ReadOverflow(yield)) {
+    return false;
+  }
+
   return true;
 }
 
 bool TXN::ExeRW(coro_yield_t& yield) {
-  std::vector<DirectRead> pending_direct_ro;
-  std::vector<CasRead> pending_cas_rw;
-  std::vector<HashRead> pending_hash_read;
+  pending.Clear();
+  auto& pending_direct_ro = pending.direct_ro;
+  auto& pending_cas_rw = pending.cas_rw;
+  auto& pending_hash_read = pending.hash_read;
 
   // About insert
   // Case 1) Local cached addr -> 1.1) SUCC. It's actually an update. 1.2) FAIL. Address stale and abort
   // Case 2) Local uncached addr -> HashRead and then find pos to insert
-  std::vector<InsertOffRead> pending_insert_off_rw;
+  auto& pending_insert_off_rw = pending.insert_off_rw;
 
   // RW transactions may also have RO data
   if (!IssueReadROCVT(pending_direct_ro, pending_hash_read)) {
     return false;
   }
 
+#if LEASE_LOCK
+  bool is_status_issued = !status_active;
+  IssueActiveStatus();
+#endif
+
   if (!IssueReadLockCVT(pending_cas_rw, pending_hash_read, pending_insert_off_rw)) {
     return false;
   }
@@ -114,9 +296,15 @@ bool TXN::ExeRW(coro_yield_t& yield) {
   // Yield to other coroutines when waiting for network replies
   coro_sched->Yield(yield, coro_id);
 
+#if LEASE_LOCK
+  if (is_status_issued && !CheckActiveStatus()) {
+    return false;
+  }
+#endif
+
   // RDMA_LOG(DBG) << "coro: " << coro_id << " tx_id: " << tx_id << " check read rorw";
-  std::vector<ValueRead> pending_value_read;
-  std::vector<LockReadCVT> pending_cvt_insert;
+  auto& pending_value_read = pending.value_read;
+  auto& pending_cvt_insert = pending.cvt_insert;
 
   if (!CheckDirectROCVT(pending_direct_ro, pending_value_read)) {
     return false;
@@ -145,11 +333,12 @@ bool TXN::ExeRW(coro_yield_t& yield) {
 }
 
 bool TXN::Validate(coro_yield_t& yield) {
-  if (read_only_set.empty()) {
+  if (read_only_set.empty() || iso_level != ISOLATION::SR) {
     return true;
   }
 
-  std::vector<ValidateRead> pending_validate;
+  pending.Clear();
+  auto& pending_validate = pending.validate;
   IssueValidate(pending_validate);
 
   // Yield to other coroutines when waiting for network replies
@@ -162,10 +351,21 @@ bool TXN::Validate(coro_yield_t& yield) {
 void TXN::Abort() {
   // When failures occur, transactions need to be aborted.
   // In general, the transaction will not abort during committing replicas if no hardware failure occurs
-  char* unlock_buf = thread_rdma_buffer_alloc->Alloc(sizeof(lock_t));
-  *((lock_t*)unlock_buf) = 0;
+  // The unlock requests are unsignaled, so they use a buffer that is never reused
+  char* unlock_buf = abort_unlock_buf;
+
+#if LEASE_LOCK
+  if (status_active && status_word == MakeStatus(txn_seq, CoordStatus::kCommitted)) {
+    // Validation fails after my commit status is set. Nothing has been written, so I am aborted
+    status_word = MakeStatus(txn_seq, CoordStatus::kAborted);
+    RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(coord_id));
+    qp->post_cas(status_buf, global_meta_man->GetCoordStatusOffset(coord_id),
+                 MakeStatus(txn_seq, CoordStatus::kCommitted), status_word, 0);
+  }
+#endif
+
   for (auto& index : locked_rw_set) {
-    node_id_t primary_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(read_write_set[index]->header.table_id, PrimaryCrashTime::kAtAbort);
+    node_id_t primary_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(read_write_set[index]->header.table_id, read_write_set[index]->header.key, PrimaryCrashTime::kAtAbort);
 #if HAVE_PRIMARY_CRASH
     if (primary_node_id == PRIMARY_CRASH) {
       // This primary is not recovered yet. I skip it
@@ -179,9 +379,16 @@ void TXN::Abort() {
     }
 #endif
     RCQP* primary_qp = thread_qp_man->GetRemoteDataQPWithNodeID(primary_node_id);
+#if LEASE_LOCK
+    // My expired locks may have been released and then acquired by others
+    auto rc = primary_qp->post_cas(unlock_buf, read_write_set[index]->GetRemoteLockAddr(), lock_word, STATE_UNLOCKED, 0);
+#else
     auto rc = primary_qp->post_send(IBV_WR_RDMA_WRITE, unlock_buf, sizeof(lock_t), read_write_set[index]->GetRemoteLockAddr(), 0);
+#endif
     if (rc != SUCC) {
       RDMA_LOG(FATAL) << "Thread " << t_id << " , Coroutine " << coro_id << " unlock fails during abortion";
     }
   }
+
+  Unpublish();
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include "process/txn.h"
+
+// --------------- Single-key auto-commit operations -----------------
+KVStatus TXN::Get(coro_yield_t& yield, table_id_t table_id, itemkey_t key, void* value) {
+  // Reading the current snapshot needs no new timestamp
+  Begin(tx_id_generator.load(), TXN_TYPE::kROTxn, "KV:Get", ISOLATION::SI);
+
+  auto item = NewItem(table_id, TABLE_VALUE_SIZE[table_id], key, UserOP::kRead);
+  item->is_try_read = true;
+  AddToReadOnlySet(item);
+
+  if (!Execute(yield)) {
+    return KVStatus::kAborted;
+  }
+
+  // A read-only txn commits locally
+  Commit(yield);
+
+  if (item->IsNotFound()) {
+    event_counter.RegEvent(t_id, txn_name, "Get:NotFound");
+    return KVStatus::kNotFound;
+  }
+  memcpy(value, item->Value(), TABLE_VALUE_SIZE[table_id]);
+  return KVStatus::kOK;
+}
+
+KVStatus TXN::Put(coro_yield_t& yield, table_id_t table_id, itemkey_t key, const void* value) {
+  Begin(tx_id_generator.load(), TXN_TYPE::kRWTxn, "KV:Put", ISOLATION::SI);
+
+  // An insert of an existing key turns into an update of it
+  auto item = NewItem(table_id, TABLE_VALUE_SIZE[table_id], key, UserOP::kInsert);
+  AddToReadWriteSet(item);
+
+  if (!Execute(yield)) {
+    return KVStatus::kAborted;
+  }
+
+  if (!item->IsRealInsert()) {
+    // The old values of the changed attributes are the undo attributes of the new version
+    const uint8_t* new_value = (const uint8_t*)value;
+    uint8_t* old_value = item->Value();
+    size_t offset_in_struct = 0;
+    for (int attr_idx = 1; attr_idx <= ATTRIBUTE_NUM[table_id]; attr_idx++) {
+      size_t attr_size = ATTR_SIZE[table_id][attr_idx];
+      if (memcmp(old_value + offset_in_struct, new_value + offset_in_struct, attr_size) != 0) {
+        item->SetUpdate(attr_idx - 1, old_value + offset_in_struct, attr_size);
+      }
+      offset_in_struct += attr_size;
+    }
+
+    if (item->update_bitmap == 0) {
+      // Only release the lock
+      Abort();
+      event_counter.RegEvent(t_id, txn_name, "Put:Unchanged");
+      return KVStatus::kOK;
+    }
+
+    if (item->current_p > (int)ATTR_BAR_SIZE[table_id]) {
+      Abort();
+      event_counter.RegEvent(t_id, txn_name, "Put:TooLarge");
+      return KVStatus::kTooLarge;
+    }
+  }
+
+  memcpy(item->Value(), value, TABLE_VALUE_SIZE[table_id]);
+
+  return Commit(yield) ? KVStatus::kOK : KVStatus::kAborted;
+}
+
+KVStatus TXN::Delete(coro_yield_t& yield, table_id_t table_id, itemkey_t key) {
+  Begin(tx_id_generator.load(), TXN_TYPE::kRWTxn, "KV:Delete", ISOLATION::SI);
+
+  auto item = NewItem(table_id, TABLE_VALUE_SIZE[table_id], key, UserOP::kDelete);
+  AddToReadWriteSet(item);
+
+  if (!Execute(yield)) {
+    return KVStatus::kAborted;
+  }
+
+  if (item->is_delete_all_invalid) {
+    // Nothing to delete. Only release the lock
+    Abort();
+    event_counter.RegEvent(t_id, txn_name, "Delete:NotFound");
+    return KVStatus::kNotFound;
+  }
+
+  return Commit(yield) ? KVStatus::kOK : KVStatus::kAborted;
+}
+
+KVStatus TXN::Insert(coro_yield_t& yield, table_id_t table_id, itemkey_t key, const void* value) {
+  Begin(tx_id_generator.load(), TXN_TYPE::kRWTxn, "KV:Insert", ISOLATION::SI);
+
+  auto item = NewItem(table_id, TABLE_VALUE_SIZE[table_id], key, UserOP::kInsert);
+  AddToReadWriteSet(item);
+
+  if (!Execute(yield)) {
+    return KVStatus::kAborted;
+  }
+
+  if (!item->IsRealInsert()) {
+    Abort();
+    event_counter.RegEvent(t_id, txn_name, "Insert:Exists");
+    return KVStatus::kExists;
+  }
+
+  memcpy(item->Value(), value, TABLE_VALUE_SIZE[table_id]);
+
+  return Commit(yield) ? KVStatus::kOK : KVStatus::kAborted;
+}
@@ -0,0 +1,250 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include "process/txn.h"
+
+// The ACTIVE status is piggybacked with the first locks of a txn. Its CAS fails only if
+// my slot was aborted by others. Then I abort and learn the current value of my slot
+void TXN::IssueActiveStatus() {
+  if (status_active) {
+    return;
+  }
+  status_active = true;
+
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(coord_id));
+  if (!coro_sched->RDMACAS(coro_id, qp, status_buf, global_meta_man->GetCoordStatusOffset(coord_id),
+                           status_word, MakeStatus(txn_seq, CoordStatus::kActive))) {
+    RDMA_LOG(FATAL) << "Thread " << t_id << " , Coroutine " << coro_id << " fails to set active status";
+  }
+}
+
+bool TXN::CheckActiveStatus() {
+  status_t old_status = *((status_t*)status_buf);
+  if (old_status != status_word) {
+    status_word = old_status;
+    event_counter.RegEvent(t_id, txn_name, "CheckActiveStatus:StatusChangedByOthers");
+    return false;
+  }
+  status_word = MakeStatus(txn_seq, CoordStatus::kActive);
+  return true;
+}
+
+void TXN::IssueCommitStatus() {
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(coord_id));
+  if (!coro_sched->RDMACAS(coro_id, qp, status_buf, global_meta_man->GetCoordStatusOffset(coord_id),
+                           MakeStatus(txn_seq, CoordStatus::kActive), MakeStatus(txn_seq, CoordStatus::kCommitted))) {
+    RDMA_LOG(FATAL) << "Thread " << t_id << " , Coroutine " << coro_id << " fails to set commit status";
+  }
+}
+
+bool TXN::CheckCommitStatus() {
+  status_t old_status = *((status_t*)status_buf);
+  if (old_status != MakeStatus(txn_seq, CoordStatus::kActive)) {
+    // My lease has expired and others have aborted me
+    status_word = old_status;
+    event_counter.RegEvent(t_id, txn_name, "CheckCommitStatus:AbortedByOthers");
+    return false;
+  }
+  status_word = MakeStatus(txn_seq, CoordStatus::kCommitted);
+  return true;
+}
+
+bool TXN::CanLogRedo() {
+  if (!IsLeaseEnough(lock_word, lease_clock->Epoch())) {
+    event_counter.RegEvent(t_id, txn_name, "CanLogRedo:LeaseNotEnough");
+    return false;
+  }
+
+  size_t log_bound = sizeof(RedoHeader) + sizeof(uint64_t);
+  for (auto& item : read_write_set) {
+    log_bound += RedoLogBuilder::ItemBound(item->header.table_id);
+  }
+  if (log_bound > REDO_LOG_SIZE) {
+    event_counter.RegEvent(t_id, txn_name, "CanLogRedo:LogFull");
+    return false;
+  }
+  return true;
+}
+
+// The writes are recorded by building the doorbells of the primary without posting them. They are the same
+// for all the replicas
+void TXN::LogRedo(coro_yield_t& yield) {
+  char* log_buf = coro_rdma_buffer_alloc->Alloc(REDO_LOG_SIZE);
+  RedoLogBuilder redo(log_buf, REDO_LOG_SIZE);
+  redo.Reset();
+
+  redo_capture = &redo;
+  for (auto& write : commit_writes) {
+    DataSetItem* item = write.item;
+    redo.AddItem(item->header.table_id, item->header.key, item->GetRemoteLockAddr());
+    WriteReplica(nullptr, item, item->target_write_pos, item->user_op, write.new_attr_bar, write.payload);
+  }
+  redo_capture = nullptr;
+
+  size_t log_size = redo.Seal(txn_seq, lock_word);
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(coord_id));
+  coro_sched->RDMAWrite(coro_id, qp, log_buf, global_meta_man->GetRedoLogOffset(coord_id), log_size);
+  coro_sched->Yield(yield, coro_id);
+}
+
+void TXN::ReleaseExpiredLocks(coro_yield_t& yield) {
+  if (expired_locks.empty()) {
+    return;
+  }
+
+  // 1. Read the status slots of the lock owners
+  std::vector<char*> owner_status_bufs;
+  for (auto& expired : expired_locks) {
+    coord_id_t owner = LockOwner(expired.lock);
+    RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(owner));
+    char* buf = coro_rdma_buffer_alloc->Alloc(sizeof(status_t));
+    coro_sched->RDMARead(coro_id, qp, buf, global_meta_man->GetCoordStatusOffset(owner), sizeof(status_t));
+    owner_status_bufs.push_back(buf);
+  }
+
+  coro_sched->Yield(yield, coro_id);
+
+  // 2. Abort the owners that have not committed. If the owner's ACTIVE status has not arrived,
+  // its slot still holds an older seq, and it is aborted as well. Take over the committed owners
+  std::vector<status_t> expected(expired_locks.size());
+  std::vector<bool> releasable(expired_locks.size(), false);
+  std::vector<bool> roll_forward(expired_locks.size(), false);
+
+  for (size_t i = 0; i < expired_locks.size(); i++) {
+    coord_id_t owner = LockOwner(expired_locks[i].lock);
+    uint16_t seq = LockSeq(expired_locks[i].lock);
+    status_t owner_status = *((status_t*)owner_status_bufs[i]);
+
+    if (StatusSeq(owner_status) == seq && StatusState(owner_status) == CoordStatus::kAborted) {
+      releasable[i] = true;
+      continue;
+    }
+
+    RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(owner));
+
+    if (StatusSeq(owner_status) == seq && StatusState(owner_status) == CoordStatus::kCommitted) {
+      // Only one of the CNs that find the owner expired replays its redo log
+      expected[i] = owner_status;
+      roll_forward[i] = true;
+      coro_sched->RDMACAS(coro_id, qp, owner_status_bufs[i], global_meta_man->GetCoordStatusOffset(owner),
+                          owner_status, MakeStatus(seq, CoordStatus::kRollForward));
+      continue;
+    }
+
+    bool is_active = (StatusSeq(owner_status) == seq && StatusState(owner_status) == CoordStatus::kActive);
+    if (!is_active && !SeqBefore(StatusSeq(owner_status), seq)) {
+      // The owner is being rolled forward by others. Or the owner has moved on to later txns and the
+      // lock is being released by itself
+      event_counter.RegEvent(t_id, txn_name, "ReleaseExpiredLocks:OwnerNotAbortable");
+      continue;
+    }
+
+    expected[i] = owner_status;
+    releasable[i] = true;
+    coro_sched->RDMACAS(coro_id, qp, owner_status_bufs[i], global_meta_man->GetCoordStatusOffset(owner),
+                        owner_status, MakeStatus(seq, CoordStatus::kAborted));
+  }
+
+  coro_sched->Yield(yield, coro_id);
+
+  // 3. Finish the commits of the owners I take over. An owner whose redo log is incomplete is aborted
+  for (size_t i = 0; i < expired_locks.size(); i++) {
+    if (!roll_forward[i] || *((status_t*)owner_status_bufs[i]) != expected[i]) {
+      continue;
+    }
+    uint16_t seq = LockSeq(expired_locks[i].lock);
+    if (!RollForward(yield, LockOwner(expired_locks[i].lock), seq)) {
+      releasable[i] = true;
+    }
+  }
+
+  // 4. Release the locks of the aborted owners
+  for (size_t i = 0; i < expired_locks.size(); i++) {
+    if (!releasable[i]) {
+      continue;
+    }
+
+    status_t owner_status = *((status_t*)owner_status_bufs[i]);
+    uint16_t seq = LockSeq(expired_locks[i].lock);
+    if (owner_status != expected[i] && owner_status != MakeStatus(seq, CoordStatus::kAborted)) {
+      // The owner has committed or been aborted for another seq in the meantime
+      continue;
+    }
+
+    RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(expired_locks[i].node_id);
+    char* cas_buf = coro_rdma_buffer_alloc->Alloc(sizeof(lock_t));
+    coro_sched->RDMACAS(coro_id, qp, cas_buf, expired_locks[i].lock_off, expired_locks[i].lock, STATE_UNLOCKED);
+    event_counter.RegEvent(t_id, txn_name, "ReleaseExpiredLocks:Release");
+  }
+
+  coro_sched->Yield(yield, coro_id);
+
+  expired_locks.clear();
+}
+
+bool TXN::RollForward(coro_yield_t& yield, coord_id_t owner, uint16_t seq) {
+  RCQP* status_qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetCoordStatusNodeID(owner));
+  char* log_buf = coro_rdma_buffer_alloc->Alloc(REDO_LOG_SIZE);
+  coro_sched->RDMARead(coro_id, status_qp, log_buf, global_meta_man->GetRedoLogOffset(owner), REDO_LOG_SIZE);
+  coro_sched->Yield(yield, coro_id);
+
+  if (!RedoLogBuilder::IsComplete(log_buf, REDO_LOG_SIZE, seq)) {
+    // The owner waits for its complete log before any commit write, so it has written nothing
+    char* cas_buf = coro_rdma_buffer_alloc->Alloc(sizeof(status_t));
+    coro_sched->RDMACAS(coro_id, status_qp, cas_buf, global_meta_man->GetCoordStatusOffset(owner),
+                        MakeStatus(seq, CoordStatus::kRollForward), MakeStatus(seq, CoordStatus::kAborted));
+    coro_sched->Yield(yield, coro_id);
+    event_counter.RegEvent(t_id, txn_name, "RollForward:LogIncomplete");
+    return false;
+  }
+
+  // 1. The owner may have written and unlocked some items, which may be locked by others since
+  const RedoHeader* header = (const RedoHeader*)log_buf;
+  std::vector<const RedoItem*> items;
+  std::vector<char*> lock_bufs;
+  const char* p = log_buf + sizeof(RedoHeader);
+  for (uint32_t i = 0; i < header->item_num; i++) {
+    const RedoItem* item = (const RedoItem*)p;
+    p += sizeof(RedoItem);
+    for (uint64_t e = 0; e < item->entry_num; e++) {
+      p += sizeof(RedoEntry) + RedoLogBuilder::Align8(((const RedoEntry*)p)->size);
+    }
+
+    RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetPrimaryNodeID(item->table_id, item->key));
+    char* lock_buf = coro_rdma_buffer_alloc->Alloc(sizeof(lock_t));
+    coro_sched->RDMARead(coro_id, qp, lock_buf, item->lock_off, sizeof(lock_t));
+    items.push_back(item);
+    lock_bufs.push_back(lock_buf);
+  }
+
+  coro_sched->Yield(yield, coro_id);
+
+  // 2. Replay the writes in order, so that the primary is unlocked by the last one as in the owner's commit
+  for (size_t i = 0; i < items.size(); i++) {
+    if (*(lock_t*)lock_bufs[i] != header->lock) {
+      continue;
+    }
+
+    const RedoItem* item = items[i];
+    std::vector<node_id_t> node_ids{global_meta_man->GetPrimaryNodeID(item->table_id, item->key)};
+    bool need_recovery = false;
+    auto* backup_node_ids = global_meta_man->GetBackupNodeIDWithCrash(item->table_id, item->key, need_recovery);
+    if (backup_node_ids) {
+      node_ids.insert(node_ids.end(), backup_node_ids->begin(), backup_node_ids->end());
+    }
+
+    for (node_id_t node_id : node_ids) {
+      RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(node_id);
+      const char* e = (const char*)item + sizeof(RedoItem);
+      for (uint64_t j = 0; j < item->entry_num; j++) {
+        const RedoEntry* entry = (const RedoEntry*)e;
+        coro_sched->RDMAWrite(coro_id, qp, (char*)e + sizeof(RedoEntry), entry->remote_off, entry->size);
+        e += sizeof(RedoEntry) + RedoLogBuilder::Align8(entry->size);
+      }
+    }
+    event_counter.RegEvent(t_id, txn_name, "RollForward:Replay");
+  }
+
+  coro_sched->Yield(yield, coro_id);
+  return true;
+}
@@ -0,0 +1,222 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+#include "base/common.h"
+#include "process/structs.h"
+
+// A coordinator, i.e., a coroutine, is globally identified by its thread and coroutine ids
+using coord_id_t = uint32_t;
+
+static_assert(MAX_CLIENT_NUM_PER_MN * MAX_CORO_NUM_PER_THREAD <= 0xFFFF, "coord id must fit in the lock word");
+
+ALWAYS_INLINE
+coord_id_t GetCoordID(t_id_t global_tid, coro_id_t coro_id) {
+  return (coord_id_t)global_tid * MAX_CORO_NUM_PER_THREAD + (coord_id_t)coro_id;
+}
+
+// Each coordinator has one 8B status slot in memory node. It is: txn seq (16 bits) | state (3 bits)
+// The owner moves its slot from ACTIVE to COMMITTED together with validation, and back to ABORTED if the
+// validation fails. Others move it from ACTIVE to ABORTED before releasing the owner's expired locks, or from
+// COMMITTED to ROLL_FORWARD before finishing the owner's commit with its redo log. All use CAS, so exactly one
+// side wins
+enum CoordStatus : uint64_t {
+  kIdle = 0,
+  kActive,
+  kCommitted,
+  kAborted,
+  kRollForward
+};
+
+using status_t = uint64_t;
+
+ALWAYS_INLINE
+status_t MakeStatus(uint16_t seq, CoordStatus state) {
+  return ((status_t)seq << 3) | state;
+}
+
+ALWAYS_INLINE
+uint16_t StatusSeq(status_t status) {
+  return (uint16_t)(status >> 3);
+}
+
+ALWAYS_INLINE
+CoordStatus StatusState(status_t status) {
+  return (CoordStatus)(status & 0x7);
+}
+
+// Whether txn seq a is issued before b. Seqs wrap around
+ALWAYS_INLINE
+bool SeqBefore(uint16_t a, uint16_t b) {
+  return (int16_t)(a - b) < 0;
+}
+
+// The lease epoch is a counter in a memory node, which one CN thread increases every LEASE_EPOCH_US. A lease
+// is a number of epochs, so the CNs compare no clocks. They only read the counter, whose tick rate is set by
+// the ticker's clock. If the ticker stops, no lease expires
+static const uint32_t LEASE_EPOCH_NUM = 4;
+
+static const uint64_t LEASE_EPOCH_US = LOCK_LEASE_US / LEASE_EPOCH_NUM;
+
+// A lock word is: owner coord id (16 bits) | owner's txn seq (16 bits) | owner's lease epoch (32 bits)
+ALWAYS_INLINE
+lock_t MakeLockWord(coord_id_t coord_id, uint16_t seq, uint32_t epoch) {
+  return ((lock_t)(coord_id & 0xFFFF) << 48) | ((lock_t)seq << 32) | epoch;
+}
+
+ALWAYS_INLINE
+coord_id_t LockOwner(lock_t lock) {
+  return (coord_id_t)(lock >> 48);
+}
+
+ALWAYS_INLINE
+uint16_t LockSeq(lock_t lock) {
+  return (uint16_t)(lock >> 32);
+}
+
+// Only paces the refreshes of the lease epoch in a thread
+ALWAYS_INLINE
+uint64_t SteadyUs() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+// The epoch views of the owner and me each lag the counter by up to one epoch, hence one more epoch than
+// the lease. A lock taken before the owner's first read of the counter never expires
+ALWAYS_INLINE
+bool IsLeaseExpired(lock_t lock, uint32_t epoch) {
+  uint32_t lock_epoch = (uint32_t)lock;
+  return lock_epoch != 0 && (int32_t)(epoch - lock_epoch) > (int32_t)LEASE_EPOCH_NUM;
+}
+
+// The owner writes its commit only if at least two epochs are left before others may see its lease expired
+ALWAYS_INLINE
+bool IsLeaseEnough(lock_t lock, uint32_t epoch) {
+  uint32_t lock_epoch = (uint32_t)lock;
+  return lock_epoch == 0 || (int32_t)(epoch - lock_epoch) < (int32_t)LEASE_EPOCH_NUM - 1;
+}
+
+// The thread local view of the lease epoch. The thread 0 of the cluster ticks the counter, and the other
+// threads read it every half epoch. Coroutines of a thread run one at a time, so no atomics are needed
+class LeaseClock {
+ public:
+  explicit LeaseClock(bool is_ticker) : ticker(is_ticker), epoch(0), last_refresh_us(0), refreshing(false) {}
+
+  ALWAYS_INLINE
+  bool StartRefresh(uint64_t now_us) {
+    uint64_t interval_us = ticker ? LEASE_EPOCH_US : LEASE_EPOCH_US / 2;
+    if (refreshing || now_us - last_refresh_us < interval_us) return false;
+    refreshing = true;
+    last_refresh_us = now_us;
+    return true;
+  }
+
+  // The ticker learns the counter before its increment
+  ALWAYS_INLINE
+  void FinishRefresh(uint64_t counter) {
+    epoch = (uint32_t)(ticker ? counter + 1 : counter);
+    refreshing = false;
+  }
+
+  ALWAYS_INLINE
+  uint32_t Epoch() const {
+    return epoch;
+  }
+
+  ALWAYS_INLINE
+  bool IsTicker() const {
+    return ticker;
+  }
+
+ private:
+  bool ticker;
+
+  uint32_t epoch;
+
+  uint64_t last_refresh_us;  // Only paces my refreshes
+
+  bool refreshing;
+};
+
+// Builds the redo log of a commit. It is: RedoHeader | (RedoItem | (RedoEntry | data, 8B aligned)*)* | seq.
+// The seq is written at both ends, so a log torn by a crash is not taken as complete
+class RedoLogBuilder {
+ public:
+  RedoLogBuilder(char* log_buf, size_t log_cap) : buf(log_buf), cap(log_cap), size(0), cur_item(nullptr) {}
+
+  ALWAYS_INLINE
+  void Reset() {
+    size = sizeof(RedoHeader);
+    cur_item = nullptr;
+    ((RedoHeader*)buf)->item_num = 0;
+  }
+
+  ALWAYS_INLINE
+  void AddItem(table_id_t table_id, itemkey_t key, offset_t lock_off) {
+    cur_item = (RedoItem*)(buf + size);
+    cur_item->table_id = table_id;
+    cur_item->key = key;
+    cur_item->lock_off = lock_off;
+    cur_item->entry_num = 0;
+    size += sizeof(RedoItem);
+    ((RedoHeader*)buf)->item_num++;
+  }
+
+  // The remote offset is the same in all the replicas
+  ALWAYS_INLINE
+  void AddWrite(offset_t remote_off, const char* data, size_t data_size) {
+    assert(size + sizeof(RedoEntry) + Align8(data_size) + sizeof(uint64_t) <= cap);
+    RedoEntry* entry = (RedoEntry*)(buf + size);
+    entry->remote_off = remote_off;
+    entry->size = data_size;
+    memcpy(buf + size + sizeof(RedoEntry), data, data_size);
+    size += sizeof(RedoEntry) + Align8(data_size);
+    cur_item->entry_num++;
+  }
+
+  // Return the log size
+  ALWAYS_INLINE
+  size_t Seal(uint16_t seq, lock_t lock) {
+    RedoHeader* header = (RedoHeader*)buf;
+    header->seq = seq;
+    header->lock = lock;
+    header->size = size + sizeof(uint64_t);
+    *(uint64_t*)(buf + size) = seq;
+    return header->size;
+  }
+
+  // The upper bound of the log size of a written item, with which the log space is checked before commit
+  static size_t ItemBound(table_id_t table_id) {
+    size_t vpkg_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;
+    // At most 5 requests per item: spilled version, overflow head, value or delta, vcell or cvt or header, unlock
+    return sizeof(RedoItem) + 6 * sizeof(RedoEntry) + Align8(OverflowHeaderSize + TABLE_VALUE_SIZE[table_id]) +
+           Align8(vpkg_size) + Align8(TABLE_VALUE_SIZE[table_id]) + Align8(CVTSize) + 3 * sizeof(uint64_t);
+  }
+
+  static bool IsComplete(const char* log_buf, size_t log_cap, uint16_t seq) {
+    const RedoHeader* header = (const RedoHeader*)log_buf;
+    if (header->seq != seq || header->size < sizeof(RedoHeader) + sizeof(uint64_t) || header->size > log_cap) {
+      return false;
+    }
+    return *(const uint64_t*)(log_buf + header->size - sizeof(uint64_t)) == seq;
+  }
+
+  ALWAYS_INLINE
+  static size_t Align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+  }
+
+ private:
+  char* buf;
+
+  size_t cap;
+
+  size_t size;
+
+  RedoItem* cur_item;
+};
@@ -26,6 +26,7 @@ struct LockedKeyEntry {
 // For each coordinator, i.e., coroutine
 struct LockedKeyTable {
   tx_id_t tx_id;
+  lock_t lock;  // The lock word used by this coordinator's current txn
   int num_entry;
   LockedKeyEntry entries[MAX_LOCKED_KEY_NUM];
 };
@@ -0,0 +1,185 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include "process/txn.h"
+
+// --------------- Overflow chains of the versions spilled for long readers -----------------
+void TXN::BeginLongRead(coro_yield_t& yield, const char* name, int iso) {
+  Begin(tx_id_generator.load(), TXN_TYPE::kROTxn, name, iso);
+
+  if (!gc_watermark) {
+    event_counter.RegEvent(t_id, txn_name, "BeginLongRead:NoGCWatermark");
+    return;
+  }
+
+  is_long_reader = true;
+  gc_watermark->PublishLong(coro_id, tx_id, WallClockUs());
+
+  // The writers that have not seen me do not spill. Each round reads my GC slot, so that the other
+  // coroutines, which publish me in their refreshes, run meanwhile
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetGCSlotNodeID());
+  while (!gc_watermark->IsLongRegistered(coro_id, WallClockUs())) {
+    char* slot_buf = coro_rdma_buffer_alloc->Alloc(GC_SLOT_SIZE);
+    coro_sched->RDMARead(coro_id, qp, slot_buf, global_meta_man->GetGCSlotOffset(t_id), GC_SLOT_SIZE);
+    coro_sched->Yield(yield, coro_id);
+    RefreshGCWatermark();
+  }
+
+  // Every version superseded after my snapshot is spilled
+  start_time = tx_id_generator.load();
+}
+
+bool TXN::ReadOverflow(coro_yield_t& yield) {
+  while (!overflow_reads.empty()) {
+    for (auto& res : overflow_reads) {
+      size_t record_size = OverflowHeaderSize + TABLE_VALUE_SIZE[res.item->header.table_id];
+      res.buf = coro_rdma_buffer_alloc->Alloc(record_size);
+      coro_sched->RDMARead(coro_id, res.qp, res.buf, res.remote_off, record_size);
+    }
+
+    coro_sched->Yield(yield, coro_id);
+
+    // The chain is from new to old. The first version not after my start time is the visible one
+    size_t next_hop_num = 0;
+    for (auto& res : overflow_reads) {
+      OverflowHeader* spilled = (OverflowHeader*)res.buf;
+      DataSetItem* local_item = res.item;
+
+      if (spilled->version > start_time) {
+        if (spilled->next == UN_INIT_POS) {
+          no_read_pos_abort_cnt[t_id]++;
+          event_counter.RegEvent(t_id, txn_name, "ReadOverflow:NoReadPos");
+          return false;
+        }
+        res.remote_off = spilled->next;
+        overflow_reads[next_hop_num++] = res;
+        continue;
+      }
+
+      if (start_time >= spilled->end_version) {
+        // The version I see is superseded before it could be spilled, e.g., before the writer knows me
+        no_read_pos_abort_cnt[t_id]++;
+        event_counter.RegEvent(t_id, txn_name, "ReadOverflow:VersionNotSpilled");
+        return false;
+      }
+
+      memcpy((char*)&(local_item->valuepkg.value), res.buf + OverflowHeaderSize, TABLE_VALUE_SIZE[local_item->header.table_id]);
+      local_item->vcell.valid = STATE_VALID;
+      local_item->vcell.version = spilled->version;
+      local_item->is_fetched = true;
+      event_counter.RegEvent(t_id, txn_name, "ReadOverflow:Hit");
+    }
+    overflow_reads.resize(next_hop_num);
+  }
+
+  return true;
+}
+
+bool TXN::NeedSpill(const DataSetItem* item) const {
+  if (!gc_watermark || item->user_op != UserOP::kUpdate) {
+    return false;
+  }
+
+  // No long reader sees a version superseded by me if they all start after me
+  tx_id_t long_watermark = gc_watermark->GetLong();
+  if (long_watermark == GCWatermark::UNKNOWN || long_watermark >= commit_time) {
+    return false;
+  }
+
+  // Only the image of the newest version is at hand, i.e., my read version with my updates undone
+  const CVT* fetched_cvt = (const CVT*)(item->fetched_cvt_ptr);
+  for (int i = 0; i < MAX_VCELL_NUM; i++) {
+    if (fetched_cvt->vcell[i].valid && fetched_cvt->vcell[i].version > item->vcell.version) {
+      event_counter.RegEvent(t_id, txn_name, "NeedSpill:NotNewest");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void TXN::PrepareOverflow(DataSetItem* item, CommitPayload& payload) {
+  if (gc_watermark->GetLong() == TxnWatermark::IDLE) {
+    if (item->header.remote_overflow_offset != UN_INIT_POS) {
+      // No long reader runs, so the spilled versions are readable by no one
+      if (txn_watermark) {
+        unlinked_chains.push_back(UnlinkedChain{item->header.table_id, item->header.remote_overflow_offset, nullptr});
+      }
+      item->header.remote_overflow_offset = UN_INIT_POS;
+      payload.overflow_head_buf = coro_rdma_buffer_alloc->Alloc(sizeof(offset_t));
+      *(offset_t*)payload.overflow_head_buf = UN_INIT_POS;
+      event_counter.RegEvent(t_id, txn_name, "PrepareOverflow:UnlinkChain");
+    }
+    return;
+  }
+
+  if (!NeedSpill(item)) {
+    return;
+  }
+
+  table_id_t table_id = item->header.table_id;
+  size_t record_size = OverflowHeaderSize + TABLE_VALUE_SIZE[table_id];
+
+  // The space is ensured in EnsureDeltaSpace, unless the long watermark changes while it yields
+  if (!thread_delta_offset_alloc->CanAlloc(record_size)) {
+    event_counter.RegEvent(t_id, txn_name, "PrepareOverflow:NoSpace");
+    return;
+  }
+
+  payload.overflow_buf = coro_rdma_buffer_alloc->Alloc(record_size);
+  OverflowHeader* spilled = (OverflowHeader*)payload.overflow_buf;
+  spilled->version = item->vcell.version;
+  spilled->end_version = commit_time;
+  spilled->next = item->header.remote_overflow_offset;
+
+  // Undo my updates. Their old values are packed in the order of attributes, as in the attribute bar
+  char* image = payload.overflow_buf + OverflowHeaderSize;
+  memcpy(image, (char*)&(item->valuepkg.value), TABLE_VALUE_SIZE[table_id]);
+
+  const uint8_t* old_value = item->old_value_ptr;
+  offset_t offset_in_struct = 0;
+  uint64_t mask = 0x1;
+  for (int attr_idx = 1; attr_idx <= ATTRIBUTE_NUM[table_id]; attr_idx++, mask <<= 1) {
+    offset_in_struct += ATTR_SIZE[table_id][attr_idx - 1];
+    if (item->update_bitmap & mask) {
+      memcpy(image + offset_in_struct, old_value, ATTR_SIZE[table_id][attr_idx]);
+      old_value += ATTR_SIZE[table_id][attr_idx];
+    }
+  }
+
+  item->header.remote_overflow_offset = thread_delta_offset_alloc->NextDeltaOffset(record_size);
+  payload.overflow_head_buf = coro_rdma_buffer_alloc->Alloc(sizeof(offset_t));
+  *(offset_t*)payload.overflow_head_buf = item->header.remote_overflow_offset;
+  event_counter.RegEvent(t_id, txn_name, "PrepareOverflow:Spill");
+}
+
+// Like RetireUnlinkedDeltas, the unlinking writes have completed if I have no pending request. No one
+// writes an unlinked chain, so its records are read hop by hop and retired with the same timestamp
+void TXN::RetireUnlinkedChains(coro_yield_t& yield) {
+  if (committed_unlinked_chains.empty() || coro_sched->PendingCount(coro_id) != 0) {
+    return;
+  }
+  tx_id_t unlink_ts = tx_id_generator.load();
+
+  while (!committed_unlinked_chains.empty()) {
+    for (auto& chain : committed_unlinked_chains) {
+      RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetPrimaryNodeID(chain.table_id));
+      chain.buf = coro_rdma_buffer_alloc->Alloc(OverflowHeaderSize);
+      coro_sched->RDMARead(coro_id, qp, chain.buf, chain.head, OverflowHeaderSize);
+    }
+
+    coro_sched->Yield(yield, coro_id);
+
+    size_t next_hop_num = 0;
+    for (auto& chain : committed_unlinked_chains) {
+      thread_delta_offset_alloc->Retire(chain.head, OverflowHeaderSize + TABLE_VALUE_SIZE[chain.table_id], unlink_ts);
+      offset_t next = ((OverflowHeader*)chain.buf)->next;
+      if (next != UN_INIT_POS) {
+        chain.head = next;
+        committed_unlinked_chains[next_hop_num++] = chain;
+      }
+    }
+    committed_unlinked_chains.resize(next_hop_num);
+    event_counter.RegEvent(t_id, txn_name, "RetireUnlinkedChains:Hop");
+  }
+}
@@ -0,0 +1,137 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/common.h"
+#include "rlib/logging.hpp"
+#include "scheduler/coroutine.h"
+#include "util/fast_random.h"
+
+using namespace rdmaio;
+
+class TXN;
+
+using proc_id_t = uint32_t;
+
+// Inputs of a procedure. Each workload takes what it needs
+struct ProcArgs {
+  void* client;        // The workload object, e.g., TATP*
+  uint64_t* seed;      // The inputs are drawn from it
+  FastRandom* random;  // For the workloads that draw the inputs from a generator, e.g., TPCC
+  itemkey_t key;       // For the single-key workloads, e.g., MICRO
+  tx_id_t tx_id;
+  const char* payload;  // Arguments encoded by the caller, e.g., a local process. nullptr if the inputs are drawn
+  size_t payload_size;
+};
+
+using ProcHandler = bool (*)(TXN* txn, ProcArgs& args, coro_yield_t& yield);
+
+// Retry with a new txn id until commit
+const int RETRY_UNTIL_COMMIT = -1;
+
+struct Procedure {
+  proc_id_t id;  // Also the slot of its statistics, e.g., the try and commit times
+  std::string name;
+  ProcHandler handler;
+  int weight;     // Percentage in the mix of the workload
+  int max_retry;  // Retries after aborts. 0 is reporting the abort
+};
+
+struct ProcWorkload {
+  void* client;
+  std::vector<Procedure> procs;  // Indexed by the procedure id
+};
+
+// The procedures of a workload, looked up by the workload name. Only the benchmark being run registers
+// itself, since the tables of the others are not loaded. It registers before the threads run, and the
+// registry is read-only afterwards
+class ProcRegistry {
+ public:
+  void AddWorkload(const std::string& workload, void* client) {
+    workloads[workload].client = client;
+  }
+
+  // The ids of a workload are registered in order, so that dispatching is an array lookup
+  void Register(const std::string& workload, proc_id_t id, const std::string& name, ProcHandler handler, int weight, int max_retry = 0) {
+    auto search = workloads.find(workload);
+    if (search == workloads.end()) {
+      RDMA_LOG(FATAL) << "Procedure " << name << " registers to an unknown workload " << workload;
+    }
+    std::vector<Procedure>& procs = search->second.procs;
+    if (id != procs.size()) {
+      RDMA_LOG(FATAL) << "Procedure " << name << " of " << workload << " has id " << id << ", expected " << procs.size();
+    }
+    procs.push_back(Procedure{.id = id, .name = name, .handler = handler, .weight = weight, .max_retry = max_retry});
+  }
+
+  // nullptr if the workload is not registered
+  const ProcWorkload* GetWorkload(const std::string& workload) const {
+    auto search = workloads.find(workload);
+    return (search == workloads.end()) ? nullptr : &(search->second);
+  }
+
+  // Create workload generation array for benchmarking. A random number in [0, 100) picks a procedure by the weights
+  proc_id_t* CreateWorkgenArray(const std::string& workload) const {
+    const ProcWorkload* w = GetWorkload(workload);
+    proc_id_t* workgen_arr = new proc_id_t[100];
+
+    int i = 0, j = 0;
+    for (const auto& proc : w->procs) {
+      j += proc.weight;
+      for (; i < j && i < 100; i++) workgen_arr[i] = proc.id;
+    }
+
+    if (j != 100) {
+      RDMA_LOG(FATAL) << "The weights of " << workload << " sum to " << j << ", expected 100";
+    }
+    return workgen_arr;
+  }
+
+ private:
+  std::unordered_map<std::string, ProcWorkload> workloads;
+};
+
+// The argument at the head of the payload. Return false if there is none
+template <typename T>
+bool DecodeProcArg(const ProcArgs& args, T& arg) {
+  if (!args.payload || args.payload_size < sizeof(T)) {
+    return false;
+  }
+  memcpy(&arg, args.payload, sizeof(T));
+  return true;
+}
+
+// Adapters of the txn functions with the common signatures of the workloads. A payload overrides the drawn
+// inputs: the seeded and random txns take a uint64_t seed, and the keyed ones take an itemkey_t.
+// A retry decodes the same arguments
+template <typename Client, bool (*Tx)(Client*, uint64_t*, coro_yield_t&, tx_id_t, TXN*)>
+bool SeededProc(TXN* txn, ProcArgs& args, coro_yield_t& yield) {
+  uint64_t seed;
+  if (DecodeProcArg(args, seed)) {
+    return Tx((Client*)args.client, &seed, yield, args.tx_id, txn);
+  }
+  return Tx((Client*)args.client, args.seed, yield, args.tx_id, txn);
+}
+
+template <typename Client, bool (*Tx)(Client*, FastRandom*, coro_yield_t&, tx_id_t, TXN*)>
+bool RandomProc(TXN* txn, ProcArgs& args, coro_yield_t& yield) {
+  uint64_t seed;
+  if (DecodeProcArg(args, seed)) {
+    FastRandom random(seed);
+    return Tx((Client*)args.client, &random, yield, args.tx_id, txn);
+  }
+  return Tx((Client*)args.client, args.random, yield, args.tx_id, txn);
+}
+
+template <bool (*Tx)(coro_yield_t&, tx_id_t, TXN*, itemkey_t)>
+bool KeyedProc(TXN* txn, ProcArgs& args, coro_yield_t& yield) {
+  itemkey_t key = args.key;
+  DecodeProcArg(args, key);
+  return Tx(yield, args.tx_id, txn, key);
+}
@@ -8,7 +8,22 @@ bool TXN::IssueReadROCVT(std::vector<DirectRead>& pending_direct_ro,
                          std::vector<HashRead>& pending_hash_read) {
   for (int i = 0; i < read_only_set.size(); i++) {
     if (read_only_set[i]->is_fetched) continue;
-    node_id_t remote_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(read_only_set[i]->header.table_id);
+
+    if (table_cache && table_cache->IsCached(read_only_set[i]->header.table_id)) {
+      // Read-only tables are locally read
+      read_only_set[i]->is_fetched = true;
+      if (!table_cache->Read(read_only_set[i].get())) {
+        if (read_only_set[i]->is_try_read) {
+          read_only_set[i]->is_not_found = true;
+          continue;
+        }
+        event_counter.RegEvent(t_id, txn_name, "IssueReadROCVT:TableCache:NotFound");
+        return false;
+      }
+      continue;
+    }
+
+    node_id_t remote_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(read_only_set[i]->header.table_id, read_only_set[i]->header.key);
 
 #if HAVE_PRIMARY_CRASH
     if (remote_node_id == PRIMARY_CRASH) {
@@ -26,21 +41,58 @@ bool TXN::IssueReadROCVT(std::vector<DirectRead>& pending_direct_ro,
     }
 #endif
 
+    if (version_cache && READ_MOSTLY_TABLE[read_only_set[i]->header.table_id]) {
+      node_id_t cached_node_id = 0;
+      tx_id_t verified_ts = 0;
+      read_only_set[i]->cached_version = version_cache->Search(read_only_set[i].get(), cached_node_id, verified_ts);
+      if (read_only_set[i]->cached_version != 0 &&
+          cached_node_id == remote_node_id &&
+          read_only_set[i]->cached_version <= start_time &&
+          start_time <= verified_ts) {
+        // The cached version is provably the one visible to me. No need to read remote
+        read_only_set[i]->is_fetched = true;
+        read_only_set[i]->read_which_node = remote_node_id;
+        event_counter.RegEvent(t_id, txn_name, "IssueReadROCVT:VersionCache:LocalHit");
+        continue;
+      }
+    }
+
     read_only_set[i]->read_which_node = remote_node_id;
     RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(remote_node_id);
-    auto offset = addr_cache->Search(remote_node_id, read_only_set[i]->header.table_id, read_only_set[i]->header.key);
+    offset_t fv_off;
+    auto offset = addr_cache->Search(remote_node_id, read_only_set[i]->header.table_id, read_only_set[i]->header.key, fv_off);
+#if OUTPUT_EVENT_STAT
+    event_counter.RegEvent(t_id, txn_name, offset != NOT_FOUND ? "IssueReadROCVT:AddrCache:Hit" : "IssueReadROCVT:AddrCache:Miss");
+#endif
     if (offset != NOT_FOUND) {
       // Find the addr in local addr cache
       read_only_set[i]->header.remote_offset = offset;
-      char* cvt_buf = thread_rdma_buffer_alloc->Alloc(CVTSize);
+      char* cvt_buf = coro_rdma_buffer_alloc->Alloc(CVTSize);
+      char* value_buf = nullptr;
+
+      if (fv_off != NOT_FOUND && read_only_set[i]->cached_version == 0) {
+        // Speculatively read the full value together with the CVT. It is used if the CVT shows that
+        // the newest version is visible, and the full value is still at the cached offset
+        size_t fv_size = TABLE_VALUE_SIZE[read_only_set[i]->header.table_id] + sizeof(anchor_t) * 2;
+        value_buf = coro_rdma_buffer_alloc->Alloc(fv_size);
+        ReadCVTValueBatch doorbell;
+        doorbell.SetReadCVTReq(cvt_buf, offset, CVTSize);
+        doorbell.SetReadValueReq(value_buf, fv_off, fv_size);
+        doorbell.SendReqs(coro_sched, qp, coro_id);
+      } else {
+        // A version cache hit also reads the whole CVT, since the visible vcell is chosen among all of them
+        coro_sched->RDMARead(coro_id, qp, cvt_buf, offset, CVTSize);
+      }
+      // CheckAddr(offset, CVTSize, "IssueReadROCVT:cached_read");
+
       pending_direct_ro.emplace_back(DirectRead{
           .qp = qp,
           .item = read_only_set[i].get(),
           .buf = cvt_buf,
           .remote_node = remote_node_id,
-          .is_ro = true});
-      coro_sched->RDMARead(coro_id, qp, cvt_buf, offset, CVTSize);
-      // CheckAddr(offset, CVTSize, "IssueReadROCVT:cached_read");
+          .is_ro = true,
+          .value_buf = value_buf,
+          .value_off = fv_off});
     } else {
       // Local cache does not have
       HashMeta meta = global_meta_man->GetPrimaryHashMetaWithTableID(read_only_set[i]->header.table_id);
@@ -48,7 +100,7 @@ bool TXN::IssueReadROCVT(std::vector<DirectRead>& pending_direct_ro,
       offset_t bucket_off = bkt_idx * meta.bucket_size + meta.base_off;
 
       size_t bkt_size = SLOT_NUM[read_only_set[i]->header.table_id] * CVTSize;
-      char* local_hash_bucket = thread_rdma_buffer_alloc->Alloc(bkt_size);
+      char* local_hash_bucket = coro_rdma_buffer_alloc->Alloc(bkt_size);
 
       pending_hash_read.emplace_back(HashRead{
           .qp = qp,
@@ -72,7 +124,7 @@ bool TXN::IssueReadLockCVT(std::vector<CasRead>& pending_cas_rw,
   for (int i = 0; i < read_write_set.size(); i++) {
     if (read_write_set[i]->is_fetched) continue;
 
-    auto remote_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(read_write_set[i]->header.table_id);
+    auto remote_node_id = global_meta_man->GetPrimaryNodeIDWithCrash(read_write_set[i]->header.table_id, read_write_set[i]->header.key);
 #if HAVE_PRIMARY_CRASH
     if (remote_node_id == PRIMARY_CRASH) {
       // RDMA_LOG(INFO) << "Thread " << t_id << " primary fails at rlockcvt. table_id = " << read_write_set[i]->header.table_id << " txn id: " << tx_id;
@@ -91,25 +143,45 @@ bool TXN::IssueReadLockCVT(std::vector<CasRead>& pending_cas_rw,
 
     read_write_set[i]->read_which_node = remote_node_id;
     RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(remote_node_id);
-    auto offset = addr_cache->Search(remote_node_id, read_write_set[i]->header.table_id, read_write_set[i]->header.key);
+    offset_t fv_off;
+    auto offset = addr_cache->Search(remote_node_id, read_write_set[i]->header.table_id, read_write_set[i]->header.key, fv_off);
+#if OUTPUT_EVENT_STAT
+    event_counter.RegEvent(t_id, txn_name, offset != NOT_FOUND ? "IssueReadLockCVT:AddrCache:Hit" : "IssueReadLockCVT:AddrCache:Miss");
+#endif
     // Addr cached in local
     if (offset != NOT_FOUND) {
       read_write_set[i]->header.remote_offset = offset;
       // After getting address, use doorbell CAS + READ
-      char* cas_buf = thread_rdma_buffer_alloc->Alloc(sizeof(lock_t));
-      char* cvt_buf = thread_rdma_buffer_alloc->Alloc(CVTSize);
+      char* cas_buf = coro_rdma_buffer_alloc->Alloc(sizeof(lock_t));
+      char* cvt_buf = coro_rdma_buffer_alloc->Alloc(CVTSize);
+      char* value_buf = nullptr;
+
+      RecordLockKey(remote_node_id, read_write_set[i]->GetRemoteLockAddr());
+      if (fv_off != NOT_FOUND && (read_write_set[i]->user_op == UserOP::kUpdate || read_write_set[i]->user_op == UserOP::kInsert)) {
+        // Updates mostly read the newest full value. Speculatively read it with the CVT. So do the inserts
+        // of a cached key, which are updates of it
+        size_t fv_size = TABLE_VALUE_SIZE[read_write_set[i]->header.table_id] + sizeof(anchor_t) * 2;
+        value_buf = coro_rdma_buffer_alloc->Alloc(fv_size);
+        LockReadTwoBatch doorbell;
+        doorbell.SetLockReq(cas_buf, read_write_set[i]->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+        doorbell.SetReadCVTReq(cvt_buf, offset, CVTSize);
+        doorbell.SetReadValueReq(value_buf, fv_off, fv_size);
+        doorbell.SendReqs(coro_sched, qp, coro_id);
+      } else {
+        LockReadBatch doorbell;
+        doorbell.SetLockReq(cas_buf, read_write_set[i]->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+        doorbell.SetReadReq(cvt_buf, offset, CVTSize);
+        doorbell.SendReqs(coro_sched, qp, coro_id);
+      }
+
       pending_cas_rw.emplace_back(CasRead{
           .qp = qp,
           .item = read_write_set[i].get(),
           .cas_buf = cas_buf,
           .cvt_buf = cvt_buf,
-          .primary_node_id = remote_node_id});
-
-      RecordLockKey(remote_node_id, read_write_set[i]->GetRemoteLockAddr());
-      std::shared_ptr<LockReadBatch> doorbell = std::make_shared<LockReadBatch>();
-      doorbell->SetLockReq(cas_buf, read_write_set[i]->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-      doorbell->SetReadReq(cvt_buf, offset, CVTSize);
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+          .primary_node_id = remote_node_id,
+          .value_buf = value_buf,
+          .value_off = fv_off});
 
       // CheckAddr(read_write_set[i]->GetRemoteLockAddr(), 8, "IssueReadLockCVT:SetLockReq");
       // CheckAddr(offset, CVTSize, "IssueReadLockCVT:SetReadReq");
@@ -122,7 +194,7 @@ bool TXN::IssueReadLockCVT(std::vector<CasRead>& pending_cas_rw,
       offset_t bucket_off = bkt_idx * meta.bucket_size + meta.base_off;
 
       size_t bkt_size = SLOT_NUM[read_write_set[i]->header.table_id] * CVTSize;
-      char* local_hash_bucket = thread_rdma_buffer_alloc->Alloc(bkt_size);
+      char* local_hash_bucket = coro_rdma_buffer_alloc->Alloc(bkt_size);
 
       if (read_write_set[i]->user_op == UserOP::kInsert) {
         pending_insert_off_rw.emplace_back(InsertOffRead{
@@ -13,10 +13,18 @@ bool TXN::ReadValueRO(RCQP* qp,
                       std::vector<ValueRead>& pending_value_read,
                       bool is_read_newest) {
   table_id_t table_id = item_ptr->header.table_id;
+
+  if (item_ptr->cached_version != 0 && item_ptr->cached_version == item_ptr->vcell.version) {
+    // The visible version is cached in this CN, and its value is already in valuepkg
+    version_cache->Refresh(table_id, item_ptr->header.key, item_ptr->cached_version, start_time);
+    event_counter.RegEvent(t_id, txn_name, "ReadValueRO:VersionCache:Hit");
+    return true;
+  }
+
   offset_t val_off = item_ptr->header.remote_full_value_offset;
 
   size_t fv_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;  // full value size
-  char* fv_buff = thread_rdma_buffer_alloc->Alloc(fv_size);
+  char* fv_buff = coro_rdma_buffer_alloc->Alloc(fv_size);
 
   if (is_read_newest) {
     // event_counter.RegEvent(t_id, txn_name, "ReadValueRO:ReadNewest");
@@ -51,15 +59,15 @@ bool TXN::ReadValueRO(RCQP* qp,
 
     std::vector<AttrRead> attr_read_list;
 
-    AttrPos* attr_pos = new AttrPos();
-    std::vector<OldAttrPos>* old_attr_pos = new std::vector<OldAttrPos>;
+    AttrPos* attr_pos = NewAttrPos();
+    std::vector<OldAttrPos>* old_attr_pos = NewOldAttrPos();
 
     CollectAttr(attr_read_list, attr_pos, old_attr_pos, table_id, fetched_cvt, next_pos, item_ptr);
 
-    auto doorbell = std::make_shared<ReadValueAttrBatch>(attr_read_list.size());
-    doorbell->SetReadValueReq(fv_buff, val_off, fv_size);
-    doorbell->SetReadAttrReq(attr_read_list);
-    doorbell->SendReqs(coro_sched, qp, coro_id);
+    ReadValueAttrBatch doorbell(attr_read_list.size());
+    doorbell.SetReadValueReq(fv_buff, val_off, fv_size);
+    doorbell.SetReadAttrReq(attr_read_list);
+    doorbell.SendReqs(coro_sched, qp, coro_id);
 
     // CheckAddr(val_off, fv_size, "ReadValueRO:ReadOld:SetReadValueReq");
     // for (int i = 0; i < attr_read_list.size(); i++) {
@@ -92,7 +100,7 @@ bool TXN::ReadValueRW(RCQP* qp,
   offset_t val_off = item_ptr->header.remote_full_value_offset;
 
   size_t fv_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;  // full value size
-  char* fv_buff = thread_rdma_buffer_alloc->Alloc(fv_size);
+  char* fv_buff = coro_rdma_buffer_alloc->Alloc(fv_size);
 
   if (is_read_newest) {
     if (item_ptr->user_op == kUpdate) {
@@ -112,7 +120,7 @@ bool TXN::ReadValueRW(RCQP* qp,
               .cont = Content::kValue});
     } else if (item_ptr->user_op == kDelete) {
       // Read value and the newest vcell's undos
-      AttrPos* attr_pos = new AttrPos();
+      AttrPos* attr_pos = NewAttrPos();
 
       auto attr_len = CollectDeleteNewestAttr(attr_pos, fetched_cvt->vcell[read_pos].attri_bitmap, table_id);
 
@@ -134,16 +142,16 @@ bool TXN::ReadValueRW(RCQP* qp,
 
       // event_counter.RegEvent(t_id, txn_name, "ReadValueRW:ReadNewest:Delete:ReadFVAttr");
 
-      char* must_read_attrs_buf = thread_rdma_buffer_alloc->Alloc(attr_len);
+      char* must_read_attrs_buf = coro_rdma_buffer_alloc->Alloc(attr_len);
       attr_pos->local_attr_buf = must_read_attrs_buf;
 
-      auto doorbell = std::make_shared<DeleteRead>();
-      doorbell->SetReadValueReq(fv_buff, val_off, fv_size);
-      doorbell->SetReadAttrReq(must_read_attrs_buf,
+      DeleteRead doorbell;
+      doorbell.SetReadValueReq(fv_buff, val_off, fv_size);
+      doorbell.SetReadAttrReq(must_read_attrs_buf,
                                fetched_cvt->vcell[read_pos].attri_so + fetched_cvt->header.remote_attribute_offset,
                                attr_len);
 
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(val_off, fv_size, "ReadValueRW:ReadNew:Delete:SetReadValueReq");
       // CheckAddr(fetched_cvt->vcell[read_pos].attri_so + fetched_cvt->header.remote_attribute_offset, attr_len, "ReadValueRW:ReadNew:Delete:SetReadAttrReq");
@@ -180,15 +188,15 @@ bool TXN::ReadValueRW(RCQP* qp,
 
       std::vector<AttrRead> attr_read_list;
 
-      AttrPos* attr_pos = new AttrPos();
-      std::vector<OldAttrPos>* old_attr_pos = new std::vector<OldAttrPos>;
+      AttrPos* attr_pos = NewAttrPos();
+      std::vector<OldAttrPos>* old_attr_pos = NewOldAttrPos();
 
       CollectAttr(attr_read_list, attr_pos, old_attr_pos, table_id, fetched_cvt, next_pos, item_ptr);
 
-      auto doorbell = std::make_shared<ReadValueAttrBatch>(attr_read_list.size());
-      doorbell->SetReadValueReq(fv_buff, val_off, fv_size);
-      doorbell->SetReadAttrReq(attr_read_list);
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      ReadValueAttrBatch doorbell(attr_read_list.size());
+      doorbell.SetReadValueReq(fv_buff, val_off, fv_size);
+      doorbell.SetReadAttrReq(attr_read_list);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(val_off, fv_size, "ReadValueRW:ReadOld:Update:SetReadValueReq");
       // for (int i = 0; i < attr_read_list.size(); i++) {
@@ -209,7 +217,7 @@ bool TXN::ReadValueRW(RCQP* qp,
       // event_counter.RegEvent(t_id, txn_name, "ReadValueRW:NotReadNewest:Delete");
       item_ptr->is_delete_newest = false;
 
-      AttrPos* attr_pos = new AttrPos();
+      AttrPos* attr_pos = NewAttrPos();
 
       // We should read read_pos's modifications (these modifications are not modified by newer versions) to recover remote full value
       auto attr_len = CollectDeleteMiddleAttr(attr_pos, fetched_cvt, read_pos, table_id);
@@ -230,16 +238,16 @@ bool TXN::ReadValueRW(RCQP* qp,
         return true;
       }
 
-      char* must_read_attrs_buf = thread_rdma_buffer_alloc->Alloc(attr_len);
+      char* must_read_attrs_buf = coro_rdma_buffer_alloc->Alloc(attr_len);
       attr_pos->local_attr_buf = must_read_attrs_buf;
 
-      auto doorbell = std::make_shared<DeleteRead>();
-      doorbell->SetReadValueReq(fv_buff, val_off, fv_size);
-      doorbell->SetReadAttrReq(must_read_attrs_buf,
+      DeleteRead doorbell;
+      doorbell.SetReadValueReq(fv_buff, val_off, fv_size);
+      doorbell.SetReadAttrReq(must_read_attrs_buf,
                                fetched_cvt->vcell[read_pos].attri_so + fetched_cvt->header.remote_attribute_offset,
                                attr_len);
 
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(val_off, fv_size, "ReadValueRW:ReadOld:Delete:SetReadValueReq");
       // CheckAddr(fetched_cvt->vcell[read_pos].attri_so + fetched_cvt->header.remote_attribute_offset, attr_len, "ReadValueRW:ReadOld:Delete:SetReadAttrReq");
@@ -269,13 +277,13 @@ bool TXN::LockReadValueRW(RCQP* qp,
                           bool is_read_newest) {
   table_id_t table_id = item_ptr->header.table_id;
 
-  char* lock_buff = thread_rdma_buffer_alloc->Alloc(sizeof(lock_t));
+  char* lock_buff = coro_rdma_buffer_alloc->Alloc(sizeof(lock_t));
   *(lock_t*)lock_buff = 0xdeadbeaf;
 
-  char* cvt_buff = thread_rdma_buffer_alloc->Alloc(CVTSize);
+  char* cvt_buff = coro_rdma_buffer_alloc->Alloc(CVTSize);
 
   size_t fv_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;
-  char* fv_buff = thread_rdma_buffer_alloc->Alloc(fv_size);
+  char* fv_buff = coro_rdma_buffer_alloc->Alloc(fv_size);
 
   RecordLockKey(remote_node, item_ptr->GetRemoteLockAddr());
 
@@ -284,11 +292,11 @@ bool TXN::LockReadValueRW(RCQP* qp,
       // event_counter.RegEvent(t_id, txn_name, "LockReadValueRW:ReadNewest:Update");
       // 1) Lock cvt, re-read cvt, read full value
 
-      auto doorbell = std::make_shared<LockReadTwoBatch>();
-      doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-      doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-      doorbell->SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      LockReadTwoBatch doorbell;
+      doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+      doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+      doorbell.SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadNewFV:Update:SetLockReq");
       // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadNewFV:Update:SetReadCVTReq");
@@ -307,10 +315,10 @@ bool TXN::LockReadValueRW(RCQP* qp,
       // 1) Lock cvt, re-read cvt, read full value, read attr
 
       if (item_ptr->is_delete_all_invalid) {
-        auto doorbell = std::make_shared<DeleteLock>();
-        doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-        doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-        doorbell->SendReqs(coro_sched, qp, coro_id);
+        DeleteLock doorbell;
+        doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+        doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+        doorbell.SendReqs(coro_sched, qp, coro_id);
 
         // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadNew:Delete:SetLockReq:NoReadValue");
         // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadNew:Delete:SetReadCVTReq:NoReadValue");
@@ -330,17 +338,17 @@ bool TXN::LockReadValueRW(RCQP* qp,
         return true;
       }
 
-      AttrPos* attr_pos = new AttrPos();
+      AttrPos* attr_pos = NewAttrPos();
 
       auto attr_len = CollectDeleteNewestAttr(attr_pos, fetched_cvt->vcell[read_pos].attri_bitmap, table_id);
 
       if (attr_len == 0) {
         // event_counter.RegEvent(t_id, txn_name, "LockReadValueRW:ReadNewest:Delete:OnlyOneNewestValue");
         // Delete the init loaded fv
-        auto doorbell = std::make_shared<DeleteLock>();
-        doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-        doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-        doorbell->SendReqs(coro_sched, qp, coro_id);
+        DeleteLock doorbell;
+        doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+        doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+        doorbell.SendReqs(coro_sched, qp, coro_id);
 
         // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadNew:Delete:SetLockReq:NoReadValue");
         // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadNew:Delete:SetReadCVTReq:NoReadValue");
@@ -362,17 +370,17 @@ bool TXN::LockReadValueRW(RCQP* qp,
 
       // event_counter.RegEvent(t_id, txn_name, "LockReadValueRW:ReadNewest:Delete:ReadFVAttr");
 
-      char* must_read_attrs_buf = thread_rdma_buffer_alloc->Alloc(attr_len);
+      char* must_read_attrs_buf = coro_rdma_buffer_alloc->Alloc(attr_len);
       attr_pos->local_attr_buf = must_read_attrs_buf;
 
-      auto doorbell = std::make_shared<DeleteLockRead>();
-      doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-      doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-      doorbell->SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
-      doorbell->SetReadAttrReq(must_read_attrs_buf,
+      DeleteLockRead doorbell;
+      doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+      doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+      doorbell.SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
+      doorbell.SetReadAttrReq(must_read_attrs_buf,
                                fetched_cvt->vcell[read_pos].attri_so + fetched_cvt->header.remote_attribute_offset,
                                attr_len);
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadNew:Delete:SetLockReq:ReadValue");
       // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadNew:Delete:SetReadCVTReq:ReadValue");
@@ -411,17 +419,17 @@ bool TXN::LockReadValueRW(RCQP* qp,
 
       std::vector<AttrRead> attr_read_list;
 
-      AttrPos* attr_pos = new AttrPos();
-      std::vector<OldAttrPos>* old_attr_pos = new std::vector<OldAttrPos>;
+      AttrPos* attr_pos = NewAttrPos();
+      std::vector<OldAttrPos>* old_attr_pos = NewOldAttrPos();
 
       CollectAttr(attr_read_list, attr_pos, old_attr_pos, table_id, fetched_cvt, next_pos, item_ptr);
 
-      auto doorbell = std::make_shared<LockReadThreeBatch>(attr_read_list.size());
-      doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-      doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-      doorbell->SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
-      doorbell->SetReadAttrReq(attr_read_list);
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      LockReadThreeBatch doorbell(attr_read_list.size());
+      doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+      doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+      doorbell.SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
+      doorbell.SetReadAttrReq(attr_read_list);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadOldFV:Update:SetLockReq");
       // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadOldFV:Update:SetReadCVTReq");
@@ -445,7 +453,7 @@ bool TXN::LockReadValueRW(RCQP* qp,
       // event_counter.RegEvent(t_id, txn_name, "LockReadValueRW:NotReadNewest:Delete");
       item_ptr->is_delete_newest = false;
 
-      AttrPos* attr_pos = new AttrPos();
+      AttrPos* attr_pos = NewAttrPos();
 
       // We should read read_pos's modifications, and these modifications are not modified by newer versions.
       auto attr_len = CollectDeleteMiddleAttr(attr_pos, fetched_cvt, read_pos, table_id);
@@ -453,10 +461,10 @@ bool TXN::LockReadValueRW(RCQP* qp,
       if (attr_len == 0) {
         // event_counter.RegEvent(t_id, txn_name, "LockReadValueRW:ReadNewest:Delete:Vcell_LockedCVT");
         // Delete the init loaded fv
-        auto doorbell = std::make_shared<DeleteLock>();
-        doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-        doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-        doorbell->SendReqs(coro_sched, qp, coro_id);
+        DeleteLock doorbell;
+        doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+        doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+        doorbell.SendReqs(coro_sched, qp, coro_id);
 
         // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadOld:Delete:SetLockReq:NoReadValue");
         // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadOld:Delete:SetReadCVTReq:NoReadValue");
@@ -476,17 +484,17 @@ bool TXN::LockReadValueRW(RCQP* qp,
         return true;
       }
 
-      char* must_read_attrs_buf = thread_rdma_buffer_alloc->Alloc(attr_len);
+      char* must_read_attrs_buf = coro_rdma_buffer_alloc->Alloc(attr_len);
       attr_pos->local_attr_buf = must_read_attrs_buf;
 
-      auto doorbell = std::make_shared<DeleteLockRead>();
-      doorbell->SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, tx_id);
-      doorbell->SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
-      doorbell->SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
-      doorbell->SetReadAttrReq(must_read_attrs_buf,
+      DeleteLockRead doorbell;
+      doorbell.SetLockReq(lock_buff, item_ptr->GetRemoteLockAddr(), STATE_UNLOCKED, lock_word);
+      doorbell.SetReadCVTReq(cvt_buff, item_ptr->header.remote_offset, CVTSize);  // Re-read the cvt
+      doorbell.SetReadValueReq(fv_buff, item_ptr->header.remote_full_value_offset, fv_size);
+      doorbell.SetReadAttrReq(must_read_attrs_buf,
                                fetched_cvt->vcell[read_pos].attri_so + fetched_cvt->header.remote_attribute_offset,
                                attr_len);
-      doorbell->SendReqs(coro_sched, qp, coro_id);
+      doorbell.SendReqs(coro_sched, qp, coro_id);
 
       // CheckAddr(item_ptr->GetRemoteLockAddr(), 8, "LockReadValueRW:ReadOld:Delete:SetLockReq:ReadValue");
       // CheckAddr(item_ptr->header.remote_offset, CVTSize, "LockReadValueRW:ReadOld:Delete:SetReadCVTReq:ReadValue");
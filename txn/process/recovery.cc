@@ -28,6 +28,9 @@ void TXN::RecoverPrimary(table_id_t table_id, PrimaryCrashTime p_crash_time) {
 
     SendMsgToReplica(new_p_id, orig_p_id, table_id, 1);
 
+    // The old primary is up to date. It takes its turns to be the primary of the partitions again
+    global_meta_man->FinishChangePrimary(table_id);
+
     primary_fail = false;
 
     recover_primary_mux.unlock();
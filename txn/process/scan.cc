@@ -0,0 +1,186 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#include "process/txn.h"
+
+// --------------- Snapshot scan of a table -----------------
+bool TXN::Scan(coro_yield_t& yield, table_id_t table_id, int part_id, int part_num, const ScanHandler& handler) {
+  if (!read_only_set.empty() || !read_write_set.empty()) {
+    event_counter.RegEvent(t_id, txn_name, "Scan:NotAlone");
+    return false;
+  }
+
+  const HashMeta& meta = global_meta_man->GetPrimaryHashMetaWithTableID(table_id);
+  uint64_t bkt_begin = meta.bucket_num * part_id / part_num;
+  uint64_t bkt_end = meta.bucket_num * (part_id + 1) / part_num;
+
+  // All the replicas have the same layout. The partitions take turns to read them, which spreads the scan
+  // bandwidth over the memory nodes
+  node_id_t node_id = global_meta_man->GetPrimaryNodeID(table_id);
+  bool need_recovery = false;
+  const std::vector<node_id_t>* backup_nodes = global_meta_man->GetBackupNodeIDWithCrash(table_id, need_recovery);
+  int replica_idx = part_id % (int)(backup_nodes->size() + 1);
+  if (replica_idx > 0) {
+    node_id = (*backup_nodes)[replica_idx - 1];
+  }
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(node_id);
+
+  // The buckets of a batch and the values of their rows take at most a quarter of my RDMA buffer.
+  // An old version additionally reads its undo attributes, which are not larger than the value
+  size_t fv_size = TABLE_VALUE_SIZE[table_id] + sizeof(anchor_t) * 2;
+  size_t bkt_footprint = meta.bucket_size + SLOT_NUM[table_id] * fv_size * 2;
+  uint64_t batch_bkt_num = std::max((uint64_t)1, (uint64_t)(coro_rdma_buffer_alloc->Capacity() / 4 / bkt_footprint));
+
+  for (uint64_t bkt_pos = bkt_begin; bkt_pos < bkt_end; bkt_pos += batch_bkt_num) {
+    uint64_t bkt_num = std::min(batch_bkt_num, bkt_end - bkt_pos);
+
+    // The rows of the last batch are delivered, so its items and buffers are recycled as in a new txn
+    coro_rdma_buffer_alloc->BeginTxn();
+    item_arena.Reset();
+    attr_pos_used = 0;
+    old_attr_pos_used = 0;
+
+    size_t read_size = bkt_num * meta.bucket_size;
+    offset_t remote_off = meta.base_off + bkt_pos * meta.bucket_size;
+    char* bkt_buf = coro_rdma_buffer_alloc->Alloc(read_size);
+    for (size_t done = 0; done < read_size; done += SCAN_READ_SIZE) {
+      coro_sched->RDMARead(coro_id, qp, bkt_buf + done, remote_off + done, std::min(SCAN_READ_SIZE, read_size - done));
+    }
+
+    coro_sched->Yield(yield, coro_id);
+
+    std::vector<CVT*> fetched_cvts;
+    for (size_t i = 0; i < bkt_num * SLOT_NUM[table_id]; i++) {
+      fetched_cvts.push_back((CVT*)(bkt_buf + i * CVTSize));
+    }
+
+    int round = 0;
+    while (!fetched_cvts.empty()) {
+      if (++round > SCAN_MAX_ROUND) {
+        event_counter.RegEvent(t_id, txn_name, "Scan:TooManyRounds");
+        return false;
+      }
+
+      std::vector<DataSetItem*> rows;
+      std::vector<ValueRead> pending_value_read;
+      std::vector<offset_t> reread_offs;  // The CVTs that are written while I read them
+
+      for (auto* fetched_cvt : fetched_cvts) {
+        if (!ReadScanRow(qp, node_id, table_id, fetched_cvt, rows, pending_value_read, reread_offs)) {
+          return false;
+        }
+      }
+
+      if (!pending_value_read.empty()) {
+        coro_sched->Yield(yield, coro_id);
+        for (auto& fetched_it : pending_value_read) {
+          // Only this row is re-read, not the whole batch
+          if (!CheckValueRO(fetched_it)) {
+            fetched_it.item->is_fetched = false;
+            reread_offs.push_back(fetched_it.item->header.remote_offset);
+          }
+        }
+      }
+
+      if (!overflow_reads.empty() && !ReadOverflow(yield)) {
+        return false;
+      }
+
+      for (auto* row : rows) {
+        if (row->is_fetched && !handler(row)) {
+          return true;
+        }
+      }
+
+      fetched_cvts.clear();
+      for (auto off : reread_offs) {
+        char* cvt_buf = coro_rdma_buffer_alloc->Alloc(CVTSize);
+        coro_sched->RDMARead(coro_id, qp, cvt_buf, off, CVTSize);
+        fetched_cvts.push_back((CVT*)cvt_buf);
+      }
+
+      if (!reread_offs.empty()) {
+        event_counter.RegEvent(t_id, txn_name, "Scan:RereadCVT");
+        coro_sched->Yield(yield, coro_id);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool TXN::ReadScanRow(RCQP* qp,
+                      node_id_t node_id,
+                      table_id_t table_id,
+                      CVT* fetched_cvt,
+                      std::vector<DataSetItem*>& rows,
+                      std::vector<ValueRead>& pending_value_read,
+                      std::vector<offset_t>& reread_offs) {
+  if (fetched_cvt->header.value_size == 0 || fetched_cvt->header.table_id != table_id) {
+    // Empty slot
+    return true;
+  }
+
+  bool is_read_newest = true;
+  int max_version_pos = 0;
+  bool is_ea = false;
+  bool is_all_invalid = true;
+
+  int read_pos = FindReadPos(fetched_cvt, is_read_newest, max_version_pos, is_ea, is_all_invalid);
+
+  if (is_all_invalid) {
+    // Deleted
+    return true;
+  }
+
+  if (read_pos == NO_POS && !CanReadOverflow(fetched_cvt)) {
+    // The writers reuse the invalid vcells before evicting any valid version. So with an invalid vcell left,
+    // all the versions of this row are in place, and the oldest one is after my start time
+    for (int i = 0; i < MAX_VCELL_NUM; i++) {
+      if (!fetched_cvt->vcell[i].valid) {
+        event_counter.RegEvent(t_id, txn_name, "Scan:FindReadPos:InsertedAfterStart");
+        return true;
+      }
+    }
+    // Otherwise the visible version may be reused, and my snapshot misses it
+    no_read_pos_abort_cnt[t_id]++;
+    event_counter.RegEvent(t_id, txn_name, "Scan:FindReadPos:NoReadPos");
+    return false;
+  }
+
+  if (read_pos != NO_POS && fetched_cvt->vcell[read_pos].IsWritten()) {
+    event_counter.RegEvent(t_id, txn_name, "Scan:VcellIsWritten");
+    reread_offs.push_back(fetched_cvt->header.remote_offset);
+    return true;
+  }
+
+  // The items live in the arena until the next batch. No destructor is needed, since the old value buffer is not owned
+  uint8_t* old_value_buf = (uint8_t*)item_arena.Alloc(TABLE_VALUE_SIZE[table_id]);
+  DataSetItem* row = new (item_arena.Alloc(DataSetItem::SizeOf(table_id)))
+      DataSetItem(table_id, fetched_cvt->header.value_size, fetched_cvt->header.key, UserOP::kRead, old_value_buf);
+
+  row->header = fetched_cvt->header;
+  row->fetched_cvt_ptr = (char*)fetched_cvt;
+  row->read_which_node = node_id;
+
+  if (read_pos == NO_POS) {
+    rows.push_back(row);
+    overflow_reads.emplace_back(OverflowRead{.qp = qp,
+                                             .item = row,
+                                             .buf = nullptr,
+                                             .remote_off = fetched_cvt->header.remote_overflow_offset});
+    return true;
+  }
+
+  row->vcell = fetched_cvt->vcell[read_pos];
+  row->latest_anchor = fetched_cvt->vcell[max_version_pos].sa;
+
+  if (!ReadValueRO(qp, fetched_cvt, row, read_pos, pending_value_read, is_read_newest)) {
+    reread_offs.push_back(fetched_cvt->header.remote_offset);
+    return true;
+  }
+
+  row->is_fetched = true;
+  rows.push_back(row);
+  return true;
+}
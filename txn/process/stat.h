@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -42,9 +43,9 @@ static bool comparator2(const std::pair<T_K, uint64_t>& p1, const std::pair<T_K,
 
 class EventCount {
  public:
-  void RegEvent(int t, const std::string& txn_name, const std::string& event_name) {
+  void RegEvent(int t, const char* txn_name, const char* event_name) {
 #if OUTPUT_EVENT_STAT
-    if (txn_name == "no") {
+    if (strcmp(txn_name, "no") == 0) {
       auto& map = event_cnt[t];
       auto res = map.find(event_name);
       if (res == map.end()) {
@@ -116,7 +117,7 @@ class EventCount {
 
 class KeyCount {
  public:
-  void RegKey(int t, KeyType type, const std::string& txn_name, table_id_t tab, itemkey_t k) {
+  void RegKey(int t, KeyType type, const char* txn_name, table_id_t tab, itemkey_t k) {
     auto& map = (type == kKeyRead) ? read_key_cnt[t] : ((type == kKeyWrite) ? write_key_cnt[t] : (type == kKeyCommit ? commit_key_cnt[t] : read_key_cnt[t]));
     T_K t_k;
     t_k.table_id = tab;
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "memstore/hash_store.h"
 #include "rlib/rdma_ctrl.hpp"
 
@@ -14,8 +16,12 @@ enum TXN_SYS : int {
 enum ISOLATION : int {
   SI = 1,  // snapshot isolation
   SR = 2,  // serializability
+  RC = 3,  // read committed. Each Execute() reads the newest committed versions, and no validation
 };
 
+// Passed to TXN::Begin to use the global iso_level in cn_config.json
+static const int GLOBAL_ISO_LEVEL = 0;
+
 enum VersionStructure : int {
   N2O = 1,  // New to old chain
   O2N = 2,  // Old to new chain
@@ -40,6 +46,8 @@ struct DirectRead {
   char* buf;
   node_id_t remote_node;
   bool is_ro;  // is read-only or read-write
+  char* value_buf;  // The full value speculatively read with the CVT. nullptr if not read
+  offset_t value_off;  // From which offset the full value is speculatively read
 };
 
 struct HashRead {
@@ -117,6 +125,8 @@ struct CasRead {
   char* cas_buf;
   char* cvt_buf;
   node_id_t primary_node_id;
+  char* value_buf;  // The full value speculatively read with the CVT. nullptr if not read
+  offset_t value_off;  // From which offset the full value is speculatively read
 };
 
 struct InsertOffRead {
@@ -128,11 +138,81 @@ struct InsertOffRead {
   offset_t bucket_off;
 };
 
+// The written data of an item in commit. They are built once and shared by all the replicas
+struct CommitPayload {
+  char* valuepkg_buf;
+  char* vcell_buf;
+  char* delta_buf;
+  char* header_buf;     // For insert
+  char* attr_addr_buf;  // For update that allocates a new attribute bar
+  char* valid_buf;      // For delete
+  char* unlock_buf;
+  bool has_victim;  // For update. Whether the entire cvt is written to invalidate victim vcells
+  char* overflow_buf;       // For update. The spilled version. nullptr if not spilled
+  char* overflow_head_buf;  // For update. The new head of the overflow chain. nullptr if unchanged
+};
+
+// A written item whose payload is built, to be written to all the replicas
+struct CommitWrite {
+  DataSetItem* item;
+  node_id_t primary_node_id;
+  bool new_attr_bar;
+  CommitPayload payload;
+};
+
+// Walking the overflow chain of a CVT that has no visible version
+struct OverflowRead {
+  RCQP* qp;
+  DataSetItem* item;
+  char* buf;
+  offset_t remote_off;  // The spilled version to read
+};
+
+// Receives a row of TXN::Scan. The row is valid only in the call. Returning false stops the scan
+using ScanHandler = std::function<bool(const DataSetItem* row)>;
+
+// Result of the single-key operations, e.g., TXN::Get
+enum class KVStatus : int {
+  kOK = 0,
+  kNotFound,  // No visible version of the key
+  kExists,    // Insert finds the key
+  kTooLarge,  // The changed attributes of Put do not fit in the attribute bar
+  kAborted,   // Conflicts, e.g., the key is locked. Retry with a new call
+};
+
+// Buckets of a scan batch are read in pieces of this size, which are in flight together
+const size_t SCAN_READ_SIZE = (size_t)64 * 1024;
+
+// The CVTs changed while being scanned are re-read. A batch fails after this many rounds
+const int SCAN_MAX_ROUND = 16;
+
 struct ValidateRead {
   DataSetItem* item;
   char* cvt_buf;
 };
 
+// The reads in flight in one execution or validation. Kept by the TXN so that the vectors keep their
+// capacity across txns
+struct PendingReads {
+  std::vector<DirectRead> direct_ro;
+  std::vector<CasRead> cas_rw;
+  std::vector<HashRead> hash_read;
+  std::vector<InsertOffRead> insert_off_rw;
+  std::vector<ValueRead> value_read;
+  std::vector<LockReadCVT> cvt_insert;
+  std::vector<ValidateRead> validate;
+
+  void Clear() {
+    direct_ro.clear();
+    cas_rw.clear();
+    hash_read.clear();
+    insert_off_rw.clear();
+    value_read.clear();
+    cvt_insert.clear();
+    validate.clear();
+  }
+};
+
 struct Lock {
   RCQP* qp;
   DataSetItem* item;
@@ -144,6 +224,65 @@ struct Unlock {
   char* cas_buf;
 };
 
+// A lock whose lease has expired. It is released after checking its owner's status
+struct ExpiredLock {
+  node_id_t node_id;
+  offset_t lock_off;
+  lock_t lock;
+};
+
+// A block in the delta region that is unlinked by my insert. It is retired after the insert is written
+struct UnlinkedDelta {
+  offset_t offset;
+  size_t size;
+};
+
+// The redo log of a coordinator's last commit, which others replay if it crashes after its commit point
+struct RedoHeader {
+  uint64_t seq;  // The txn seq of the commit
+  lock_t lock;   // The lock word of the commit. Only the items still locked by it are replayed
+  uint32_t item_num;
+  uint32_t size;
+};
+
+// A written item, followed by its writes in the order they are posted to each replica
+struct RedoItem {
+  table_id_t table_id;
+  itemkey_t key;
+  offset_t lock_off;
+  uint64_t entry_num;
+};
+
+struct RedoEntry {
+  offset_t remote_off;
+  uint64_t size;  // Followed by the written data, padded to 8B
+};
+
+// An overflow chain that is unlinked by my update or insert. Only the head is known, so the chain is
+// walked when it is retired
+struct UnlinkedChain {
+  table_id_t table_id;
+  offset_t head;
+  char* buf;
+};
+
+// A key of TXN::ExecuteBatch. Sorted to find the duplicate keys, and the index keeps the batch order
+struct BatchKey {
+  table_id_t table_id;
+  itemkey_t key;
+  size_t index;
+
+  bool SameKey(const BatchKey& other) const {
+    return table_id == other.table_id && key == other.key;
+  }
+
+  bool operator<(const BatchKey& other) const {
+    if (table_id != other.table_id) return table_id < other.table_id;
+    if (key != other.key) return key < other.key;
+    return index < other.index;
+  }
+};
+
 struct Version {
   RCQP* qp;
   DataSetItem* item;
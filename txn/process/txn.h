@@ -7,26 +7,34 @@
 #include <chrono>
 #include <cstdio>
 #include <iostream>
+#include <limits>
 #include <list>
+#include <memory>
 #include <queue>
 #include <random>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "allocator/buffer_allocator.h"
+#include "allocator/item_arena.h"
 #include "base/common.h"
 #include "base/workload.h"
 #include "cache/addr_cache.h"
+#include "cache/table_cache.h"
+#include "cache/version_cache.h"
 #include "connection/meta_manager.h"
 #include "connection/qp_manager.h"
 #include "memstore/hash_store.h"
 #include "process/doorbell.h"
+#include "process/lease.h"
 #include "process/oplog.h"
 #include "process/stat.h"
 #include "process/structs.h"
+#include "process/watermark.h"
 #include "util/debug.h"
 #include "util/hash.h"
 #include "util/json_config.h"
@@ -39,11 +47,21 @@ extern KeyCount key_counter;
 extern uint64_t access_old_version_cnt[MAX_TNUM_PER_CN];
 extern uint64_t access_new_version_cnt[MAX_TNUM_PER_CN];
 
+// Aborts due to no readable version and no writable vcell, and the reuse decisions of the oldest vcells
+extern uint64_t no_read_pos_abort_cnt[MAX_TNUM_PER_CN];
+extern uint64_t no_write_pos_abort_cnt[MAX_TNUM_PER_CN];
+extern uint64_t vcell_reclaim_cnt[MAX_TNUM_PER_CN];
+extern uint64_t vcell_in_use_cnt[MAX_TNUM_PER_CN];
+
 /* One-sided RDMA-enabled distributed transaction processing */
 class TXN {
  public:
   /************ Interfaces for applications ************/
-  void Begin(tx_id_t txid, TXN_TYPE txn_t, const std::string& name = "default");
+  // iso: one of ISOLATION for this transaction
+  void Begin(tx_id_t txid, TXN_TYPE txn_t, const char* name = "default", int iso = GLOBAL_ISO_LEVEL);
+
+  // Create an item in this coroutine's arena. It is valid until the next Begin
+  DataSetItemPtr NewItem(table_id_t table_id, size_t size, itemkey_t key, UserOP op);
 
   void AddToReadOnlySet(DataSetItemPtr item);
 
@@ -51,8 +69,56 @@ class TXN {
 
   bool Execute(coro_yield_t& yield, bool fail_abort = true);
 
+  // Try reading a batch of read-only keys in one phase, e.g., for scan-like transactions.
+  // Duplicate keys are read once. A missing or invisible key does not fail the transaction,
+  // instead, it is marked in DataSetItem::IsNotFound() and removed from the read-only set
+  bool ExecuteBatch(coro_yield_t& yield, std::vector<DataSetItemPtr>& batch, bool fail_abort = true);
+
   bool Commit(coro_yield_t& yield);
 
+  // Begin a read-only txn that may run long, e.g., an analytics scan. Instead of keeping it in the GC watermark,
+  // the writers spill the versions it needs into the overflow chains, and it reads a chain when a CVT has no
+  // visible version. It waits until its registration reaches all CNs, and then takes its snapshot.
+  // Without the GC watermark, it is an ordinary read-only txn
+  void BeginLongRead(coro_yield_t& yield, const char* name = "long_read", int iso = GLOBAL_ISO_LEVEL);
+
+  // Begin a read-only txn that reads the snapshot at a past timestamp, e.g., for audits. No new timestamp is
+  // taken, and the snapshot stays the same in all the Executes. With the GC watermark, I pin the cluster-wide
+  // retention floor until the txn ends, and no writer reuses a version visible at or after the floor meanwhile.
+  // Return false if as_of_ts is in the future, or older than the floor, which is then no longer kept
+  bool BeginAsOf(coro_yield_t& yield, tx_id_t as_of_ts, const char* name = "as_of");
+
+  // The oldest timestamp whose snapshot of the table is kept for BeginAsOf. The retention floor moves only to
+  // a next floor announced GC_FLOOR_GRACE_MS earlier, and only while no AS OF reader pins it. This returns my
+  // view of the next floor, so a BeginAsOf at the returned time succeeds if it pins within GC_FLOOR_GRACE_MS
+  // of my last refresh. An AS OF reader that crashes holding its pin keeps the floor, and the writers then
+  // reuse fewer versions, until the pin count is reset. Only the read-only tables in the table cache differ
+  // by table, since they keep their loaded version. Without the watermark, only the present is kept
+  tx_id_t OldestReadableTime(table_id_t table_id) const;
+
+  // Read the rows of a table that are visible at my start time, and deliver them to the handler. The buckets
+  // are split into part_num partitions and this call scans part_id, e.g., one partition per coroutine of a CN.
+  // The partitions form one snapshot if their txns begin with the same start time, e.g., Begin(ts, kROTxn).
+  // A row with no visible version is skipped only if it is inserted after my start time. If its visible version
+  // may have been reused, the scan aborts, unless a long reader finds it in the overflow chain. The scan takes no locks. It must be the only access of a read-only txn, since the items and
+  // buffers of a batch are recycled once its rows are delivered
+  bool Scan(coro_yield_t& yield, table_id_t table_id, int part_id, int part_num, const ScanHandler& handler);
+
+  // Single-key operations that each run as a whole txn, i.e., Begin, Execute and Commit in one call. They
+  // take no new timestamp except Commit's, and no validation. With a cached address, Get reads the CVT
+  // and the value together in one round. Put, Delete and Insert lock the CVT and read it in one round,
+  // together with the value for Put, and write and unlock in the next. value has TABLE_VALUE_SIZE bytes
+  KVStatus Get(coro_yield_t& yield, table_id_t table_id, itemkey_t key, void* value);
+
+  // Insert the key if it does not exist. Only the attributes that differ from the current value are
+  // recorded as undo attributes, and an unchanged value writes nothing
+  KVStatus Put(coro_yield_t& yield, table_id_t table_id, itemkey_t key, const void* value);
+
+  // A missing key aborts, as in the txns. kNotFound if all its versions are deleted
+  KVStatus Delete(coro_yield_t& yield, table_id_t table_id, itemkey_t key);
+
+  KVStatus Insert(coro_yield_t& yield, table_id_t table_id, itemkey_t key, const void* value);
+
   // void CheckAddr(offset_t start, size_t len, const std::string desc) {
   //   if ((start < 0) ||
   //       (start + len > (global_meta_man->delta_start_off + global_meta_man->per_thread_delta_size * MAX_CLIENT_NUM_PER_MN))) {
@@ -76,23 +142,61 @@ class TXN {
       LocalBufferAllocator* rdma_buffer_allocator,
       RemoteDeltaOffsetAllocator* delta_offset_allocator,
       LockedKeyTable* locked_key_table,
-      AddrCache* addr_buf) {
+      AddrCache* addr_buf,
+      TableCache* ro_table_cache = nullptr,
+      VersionCache* rm_version_cache = nullptr,
+      CommitStage* thread_commit_stage = nullptr,
+      TxnWatermark* cn_txn_watermark = nullptr,
+      GCWatermark* thread_gc_watermark = nullptr,
+      LeaseClock* thread_lease_clock = nullptr) {
     // Transaction setup
     tx_id = 0;
+    txn_name = "default";
     t_id = tid;
     coro_id = coroid;
     coro_sched = sched;
     global_meta_man = meta_man;
     thread_qp_man = qp_man;
-    thread_rdma_buffer_alloc = rdma_buffer_allocator;
+    coro_rdma_buffer_alloc = new CoroBufferAllocator(rdma_buffer_allocator->Reserve(PER_CORO_ALLOC_SIZE), PER_CORO_ALLOC_SIZE, sched, coroid);
     thread_delta_offset_alloc = delta_offset_allocator;
     thread_locked_key_table = locked_key_table;
     addr_cache = addr_buf;
+    table_cache = ro_table_cache;
+    version_cache = rm_version_cache;
+    commit_stage = thread_commit_stage;
+    txn_watermark = cn_txn_watermark;
+    gc_watermark = thread_gc_watermark;
     select_backup = 0;
+
+    coord_id = GetCoordID(tid, coroid);
+    txn_seq = 0;
+    lock_word = STATE_UNLOCKED;
+    status_word = MakeStatus(0, CoordStatus::kIdle);
+    status_active = false;
+    lease_clock = thread_lease_clock;
+    lease_buf = lease_clock ? rdma_buffer_allocator->Reserve(sizeof(uint64_t)) : nullptr;
+    lease_refreshing = false;
+    redo_capture = nullptr;
+
+    // The status and unlock requests of Abort are unsignaled, so their buffers are never reused
+    status_buf = rdma_buffer_allocator->Reserve(sizeof(status_t));
+    abort_unlock_buf = rdma_buffer_allocator->Reserve(sizeof(lock_t));
+    *((lock_t*)abort_unlock_buf) = STATE_UNLOCKED;
+
+    // My slot and all the slots read back. They are filled across txns
+    gc_refreshing = false;
+    is_long_reader = false;
+    is_as_of = false;
+    as_of_pinned = false;
+    gc_slot_buf = gc_watermark ? rdma_buffer_allocator->Reserve(GC_SLOT_SIZE * (1 + MAX_CLIENT_NUM_PER_MN) + 2 * GC_FLOOR_SIZE) : nullptr;
+    // Receives the old floor words of my pin and unpin, which may be in flight together
+    gc_pin_buf = gc_watermark ? rdma_buffer_allocator->Reserve(2 * sizeof(uint64_t)) : nullptr;
   }
 
   ~TXN() {
     Clean();
+    if (txn_watermark) txn_watermark->Clear(t_id, coro_id);
+    delete coro_rdma_buffer_alloc;
   }
 
  private:
@@ -103,27 +207,97 @@ class TXN {
 
   bool Validate(coro_yield_t& yield);  // RDMA read value versions
 
+  // Grab a delta chunk if the thread's current one cannot hold the writes of CommitAll
+  void EnsureDeltaSpace(coro_yield_t& yield);
+
+  // Allocate the remote space of the written items and build their payloads into commit_writes
+  void PrepareCommit();
+
+  // Write the prepared payloads to all the replicas
   void CommitAll();
 
+  void PreparePayload(DataSetItem* item,
+                      int write_pos,
+                      uint8_t user_op,
+                      bool new_attr_bar,
+                      CommitPayload& payload);
+
   void WriteReplica(RCQP* qp,
                     const DataSetItem* item,
                     int write_pos,
                     uint8_t user_op,
-                    bool new_attr_bar);
+                    bool new_attr_bar,
+                    const CommitPayload& payload);
 
-  void HandleDelete(RCQP* qp, const DataSetItem* item, int write_pos);
+  void HandleDelete(RCQP* qp, const DataSetItem* item, int write_pos, const CommitPayload& payload);
 
   void HandleUpdate(RCQP* qp,
                     const DataSetItem* item,
                     int write_pos,
-                    bool new_attr_bar);
+                    bool new_attr_bar,
+                    const CommitPayload& payload);
 
   void HandleInsert(RCQP* qp,
                     const DataSetItem* item,
-                    int write_pos);
+                    int write_pos,
+                    const CommitPayload& payload);
+
+  // Post a commit doorbell, or stage it if group commit is enabled. Without a qp, the writes are recorded in
+  // the redo log instead. The doorbell can be on the stack, since staging copies its requests
+  template <typename Batch>
+  void SendCommitReqs(Batch& doorbell, RCQP* qp) {
+    if (!qp) {
+      doorbell.LogReqs(redo_capture);
+    } else if (commit_stage) {
+      doorbell.SendReqs(commit_stage, qp, coro_id);
+    } else {
+      doorbell.SendReqs(coro_sched, qp, coro_id);
+    }
+  }
+
+  void SendCommitWrite(RCQP* qp, char* local_buf, offset_t remote_off, size_t size) {
+    if (!qp) {
+      redo_capture->AddWrite(remote_off, local_buf, size);
+    } else if (commit_stage) {
+      commit_stage->AddWriteReq(qp, coro_id, local_buf, remote_off, size);
+    } else {
+      coro_sched->RDMAWrite(coro_id, qp, local_buf, remote_off, size);
+    }
+  }
 
   void Abort();
 
+  // Return whether the fetched lock word is held by others. An expired one is recorded to be released
+  bool IsLocked(lock_t lock, const DataSetItem* item);
+
+  // Mark my status slot ACTIVE before I acquire any lock
+  void IssueActiveStatus();
+
+  bool CheckActiveStatus();
+
+  // Mark my status slot COMMITTED. Locks held by me are no longer released by others after that, but my
+  // commit is rolled forward with my redo log
+  void IssueCommitStatus();
+
+  bool CheckCommitStatus();
+
+  // Whether my lease leaves time for my commit writes, and my redo log fits in REDO_LOG_SIZE
+  bool CanLogRedo();
+
+  // Write my redo log, and wait until it is complete in the memory node before any commit write is posted
+  void LogRedo(coro_yield_t& yield);
+
+  // Release the recorded expired locks whose owners have not committed, and roll forward the committed ones
+  void ReleaseExpiredLocks(coro_yield_t& yield);
+
+  // Replay the redo log of a committed owner whose status slot I have moved to ROLL_FORWARD. Only the items
+  // still locked by the owner are written, and unlocked. Return false if the log is incomplete, in which case
+  // no commit write of the owner is posted, and the owner is aborted instead
+  bool RollForward(coro_yield_t& yield, coord_id_t owner, uint16_t seq);
+
+  // Read the lease epoch counter, or tick it in the ticker thread
+  void RefreshLeaseEpoch();
+
   void RecoverPrimary(table_id_t table_id, PrimaryCrashTime p_crash_time = PrimaryCrashTime::kBeforeCommit);
 
   void RecoverBackup(table_id_t table_id, node_id_t to_recover_backup_node_id);
@@ -146,6 +320,32 @@ class TXN {
 
   int FindWritePos(CVT* cvt, int& max_pos);
 
+  bool CanReclaimVCell(CVT* cvt, int min_pos);
+
+  // Whether a long reader walks the overflow chain of this CVT, which has no visible version
+  bool CanReadOverflow(const CVT* cvt) const {
+    return is_long_reader && read_write_set.empty() && cvt->header.remote_overflow_offset != UN_INIT_POS;
+  }
+
+  // Read the spilled versions in overflow_reads hop by hop
+  bool ReadOverflow(coro_yield_t& yield);
+
+  // Resolve the visible version of a scanned CVT, and issue the reads of its value. A CVT being written is
+  // added to reread_offs. Return false if the version in my snapshot is lost, which aborts the scan
+  bool ReadScanRow(RCQP* qp,
+                   node_id_t node_id,
+                   table_id_t table_id,
+                   CVT* fetched_cvt,
+                   std::vector<DataSetItem*>& rows,
+                   std::vector<ValueRead>& pending_value_read,
+                   std::vector<offset_t>& reread_offs);
+
+  // Whether my update spills the version it supersedes for the long readers
+  bool NeedSpill(const DataSetItem* item) const;
+
+  // Spill the superseded version, or unlink the overflow chain if no long reader runs
+  void PrepareOverflow(DataSetItem* item, CommitPayload& payload);
+
   void RecordLockKey(node_id_t n, offset_t o) {
 #if HAVE_COORD_CRASH
     int& ne = thread_locked_key_table[coro_id].num_entry;
@@ -161,6 +361,10 @@ class TXN {
 
   void Clean();  // Clean data sets after commit/abort
 
+  AttrPos* NewAttrPos();
+
+  std::vector<OldAttrPos>* NewOldAttrPos();
+
  private:
   // For coroutine issues RDMA requests before yield
   bool IssueReadROCVT(std::vector<DirectRead>& pending_direct_ro,
@@ -223,6 +427,10 @@ class TXN {
 
   bool CheckValueRO(std::vector<ValueRead>& pending_value_read);
 
+  bool CheckValueRO(ValueRead& fetched_it);
+
+  bool UseSpecValue(DataSetItem* item, char* value_buf);
+
   bool CheckValueRW(std::vector<ValueRead>& pending_value_read,
                     std::vector<LockReadCVT>& pending_cvt_insert);
 
@@ -276,8 +484,8 @@ class TXN {
 
   QPManager* thread_qp_man;  // Thread local qp connection manager. Each transaction thread has one
 
-  // Thread local RDMA buffer allocator
-  LocalBufferAllocator* thread_rdma_buffer_alloc;
+  // Coroutine local RDMA buffer allocator. A buffer is reused only after its requests complete
+  CoroBufferAllocator* coro_rdma_buffer_alloc;
 
   // Thread local remote delta address assigner
   RemoteDeltaOffsetAllocator* thread_delta_offset_alloc;
@@ -290,13 +498,29 @@ class TXN {
 
   std::vector<size_t> locked_rw_set;  // For release lock during abort
 
+  PendingReads pending;  // Reused by each execution and validation
+
+  // Doorbells of the validation, one per remote node. Created on first use and reused
+  std::vector<std::unique_ptr<ValidateBatch>> validate_doorbells;
+
+  std::vector<std::pair<node_id_t, offset_t>> validate_self_locked;  // Sorted. Reused by each validation
+
   AddrCache* addr_cache;
 
+  TableCache* table_cache;  // CN-resident read-only tables shared by all threads. nullptr if disabled
+
+  VersionCache* version_cache;  // CN-resident versions of read-mostly records shared by all threads. nullptr if disabled
+
+  CommitStage* commit_stage;  // Thread local group commit stage. nullptr if disabled
+
+  TxnWatermark* txn_watermark;  // Start times of the running txns in this CN. nullptr if delta reclamation is disabled
+
   // For backup-enabled read. Which backup is selected (the backup index, not the backup's machine id)
   size_t select_backup;
 
   struct pair_hash {
-    inline std::size_t operator()(const std::pair<node_id_t, offset_t>& v) const {
+    template <typename T1, typename T2>
+    inline std::size_t operator()(const std::pair<T1, T2>& v) const {
       return v.first * 31 + v.second;
     }
   };
@@ -306,7 +530,92 @@ class TXN {
 
   TXN_TYPE txn_type;
 
-  std::string txn_name;
+  int iso_level;  // Isolation level of this transaction
+
+  const char* txn_name;
+
+  /************ For lease-based locks ************/
+  coord_id_t coord_id;
+
+  uint16_t txn_seq;  // Sequence of my txns, used to match my lock words and my status slot
+
+  lock_t lock_word;  // Written into the locked CVTs: coord_id | txn_seq | lease epoch
+
+  status_t status_word;  // The last known value of my status slot
+
+  char* status_buf;
+
+  char* abort_unlock_buf;  // Holds STATE_UNLOCKED for unlock WRITEs, or receives the old lock words of CASes
+
+  bool status_active;  // Whether the ACTIVE status of this txn is issued
+
+  LeaseClock* lease_clock;  // Thread local view of the lease epoch. nullptr without LEASE_LOCK
+
+  char* lease_buf;
+
+  bool lease_refreshing;  // Whether my read or tick of the lease epoch is in flight
+
+  RedoLogBuilder* redo_capture;  // Receives the commit writes when they are recorded instead of posted
+
+  std::vector<CommitWrite> commit_writes;
+
+  std::vector<ExpiredLock> expired_locks;
+
+  /************ For delta reclamation ************/
+  std::vector<UnlinkedDelta> unlinked_deltas;  // Unlinked by this txn. Retired if it commits
+
+  std::vector<UnlinkedDelta> committed_unlinked_deltas;  // Retired once my writes complete
+
+  void RetireUnlinkedDeltas();
+
+  std::vector<UnlinkedChain> unlinked_chains;  // Unlinked by this txn. Retired if it commits
+
+  std::vector<UnlinkedChain> committed_unlinked_chains;
+
+  void RetireUnlinkedChains(coro_yield_t& yield);
+
+  /************ For GC watermark ************/
+  GCWatermark* gc_watermark;  // Thread local view of the cluster-wide GC watermark. nullptr if disabled
+
+  char* gc_slot_buf;
+
+  bool gc_refreshing;  // Whether my refresh is in flight
+
+  void RefreshGCWatermark();
+
+  // The thread 0 of the cluster moves the retention floor of the AS OF readers, see BeginAsOf
+  void AdvanceGCFloor(uint64_t now_us);
+
+  // My start time no longer holds back the watermarks once the txn ends. The next Begin publishes again
+  void Unpublish();
+
+  /************ For long readers ************/
+  bool is_long_reader;
+
+  bool is_as_of;  // Whether I read the snapshot at a past timestamp
+
+  bool as_of_pinned;  // Whether I hold a pin on the retention floor
+
+  char* gc_pin_buf;
+
+  void UnpinGCFloor();
+
+  std::vector<OverflowRead> overflow_reads;  // The CVTs whose visible versions are in their overflow chains
+
+  /************ Per-txn memory, reused across txns ************/
+  ItemArena item_arena;
+
+  std::vector<BatchKey> batch_keys;  // Used in ExecuteBatch
+
+  std::vector<std::pair<DataSetItem*, DataSetItem*>> batch_dups;  // <duplicate, the read one>, used in ExecuteBatch
+
+  std::vector<std::unique_ptr<AttrPos>> attr_pos_pool;
+
+  size_t attr_pos_used = 0;
+
+  std::vector<std::unique_ptr<std::vector<OldAttrPos>>> old_attr_pos_pool;
+
+  size_t old_attr_pos_used = 0;
 };
 
 /*************************************************************
@@ -314,15 +623,48 @@ class TXN {
  **************************************************************/
 
 ALWAYS_INLINE
-void TXN::Begin(tx_id_t txid, TXN_TYPE txn_t, const std::string& name) {
+void TXN::Begin(tx_id_t txid, TXN_TYPE txn_t, const char* name, int iso) {
   Clean();  // Clean the last transaction states
+  if (txn_watermark) {
+    txn_watermark->Publish(t_id, coro_id, txid);
+    RetireUnlinkedDeltas();
+  }
+  coro_rdma_buffer_alloc->BeginTxn();
+  item_arena.Reset();
+  attr_pos_used = 0;
+  old_attr_pos_used = 0;
   tx_id = txid;
   start_time = txid;
   txn_type = txn_t;
   txn_name = name;
+  iso_level = (iso == GLOBAL_ISO_LEVEL) ? (int)global_meta_man->iso_level : iso;
+
+  txn_seq++;
+  lock_word = MakeLockWord(coord_id, txn_seq, lease_clock ? lease_clock->Epoch() : 0);
+  status_active = false;
+  if (lease_clock) {
+    RefreshLeaseEpoch();
+  }
 
   thread_locked_key_table[coro_id].num_entry = 0;
   thread_locked_key_table[coro_id].tx_id = txid;
+  thread_locked_key_table[coro_id].lock = lock_word;
+
+  is_long_reader = false;
+  is_as_of = false;
+  if (as_of_pinned) UnpinGCFloor();
+  if (gc_watermark) {
+    gc_watermark->Publish(coro_id, txid);
+    RefreshGCWatermark();
+  }
+}
+
+ALWAYS_INLINE
+DataSetItemPtr TXN::NewItem(table_id_t table_id, size_t size, itemkey_t key, UserOP op) {
+  uint8_t* old_value_buf = (uint8_t*)item_arena.Alloc(TABLE_VALUE_SIZE[table_id]);
+  // The item is sized for its table's value, so the control block is allocated separately from the arena
+  DataSetItem* item = new (item_arena.Alloc(DataSetItem::SizeOf(table_id))) DataSetItem(table_id, size, key, op, old_value_buf);
+  return DataSetItemPtr(item, ArenaDeleter<DataSetItem>(), ArenaAllocator<DataSetItem>(&item_arena));
 }
 
 ALWAYS_INLINE
@@ -361,7 +703,7 @@ int TXN::FindReadPos(CVT* cvt, bool& is_read_newest, int& max_pos, bool& is_ea,
       is_read_newest = false;
 
 #if EARLY_ABORT
-      if ((global_meta_man->iso_level == ISOLATION::SR) &&
+      if ((iso_level == ISOLATION::SR) &&
           (txn_type == TXN_TYPE::kRWTxn)) {
         // In SR and rw txn, if reading a version larger than start time, I can early abort,
         // since in Validation I must abort by acquiring a more larger Tcommit
@@ -419,7 +761,7 @@ int TXN::FindReadPos(CVT* cvt, bool& is_read_newest, int& max_pos, bool& is_ea,
 //       min_pos = i;
 //     }
 
-//     if (ts > start_time && global_meta_man->iso_level == ISOLATION::SR) {
+//     if (ts > start_time && iso_level == ISOLATION::SR) {
 //       return NO_POS;
 //     }
 //   }
@@ -509,7 +851,7 @@ int TXN::FindCasReadPos(CVT* cvt,
       is_read_newest = false;
 
 #if EARLY_ABORT
-      if ((global_meta_man->iso_level == ISOLATION::SR) && (txn_type == TXN_TYPE::kRWTxn)) {
+      if ((iso_level == ISOLATION::SR) && (txn_type == TXN_TYPE::kRWTxn)) {
         // In SR and rw txn, if reading a version larger than start time, I can early abort,
         // since in Validation I must abort due to acquiring a larger Tcommit
         is_ea = true;
@@ -556,8 +898,8 @@ int TXN::FindCasReadPos(CVT* cvt,
     return empty_idx;
   }
 
-  // Triggering coordinator-active GC
-  if (start_time >= cvt->vcell[min_pos].version) {
+  // Triggering GC
+  if (CanReclaimVCell(cvt, min_pos)) {
     return min_pos;
   }
 
@@ -606,7 +948,7 @@ int TXN::FindReadWritePos(CVT* cvt, int& new_read_pos, int& max_pos, bool& is_ea
 
     if (!is_ea && (cvt->vcell[i].valid) && (ts > start_time)) {
 #if EARLY_ABORT
-      if ((global_meta_man->iso_level == ISOLATION::SR) && (txn_type == TXN_TYPE::kRWTxn)) {
+      if ((iso_level == ISOLATION::SR) && (txn_type == TXN_TYPE::kRWTxn)) {
         // In SR and rw txn, if reading a version larger than start time, I can early abort,
         // since in Validation I must abort due to acquiring a larger Tcommit
         new_read_pos = NO_POS;
@@ -621,9 +963,8 @@ int TXN::FindReadWritePos(CVT* cvt, int& new_read_pos, int& max_pos, bool& is_ea
     return empty_idx;
   }
 
-  // Triggering coordinator-active GC
-  if (start_time >= cvt->vcell[min_pos].version) {
-    // RDMA_LOG(DBG) << "Trigger GC. Txn " << tx_id;
+  // Triggering GC
+  if (CanReclaimVCell(cvt, min_pos)) {
     return min_pos;
   }
 
@@ -668,15 +1009,49 @@ int TXN::FindWritePos(CVT* cvt, int& max_pos) {
     return empty_idx;
   }
 
-  // Triggering coordinator-active GC
-  if (start_time >= cvt->vcell[min_pos].version) {
-    // RDMA_LOG(DBG) << "Trigger GC. Txn " << tx_id;
+  // Triggering GC
+  if (CanReclaimVCell(cvt, min_pos)) {
     return min_pos;
   }
 
   return NO_POS;
 }
 
+// Whether the oldest vcell can be overwritten. Without the GC watermark, it is coordinator-active GC judged
+// by my start time, which drops versions that older readers still need. With the watermark, the oldest
+// version is reclaimed only if the next one is not after the watermark, i.e., every running txn reads the
+// next version or a newer one. All the vcells are valid here
+ALWAYS_INLINE
+bool TXN::CanReclaimVCell(CVT* cvt, int min_pos) {
+  if (!gc_watermark) {
+    return start_time >= cvt->vcell[min_pos].version;
+  }
+
+  // An AS OF reader at the retention floor may not be in the GC watermark yet
+  tx_id_t watermark = gc_watermark->GetReclaim();
+  if (watermark == GCWatermark::UNKNOWN) {
+    vcell_in_use_cnt[t_id]++;
+    event_counter.RegEvent(t_id, txn_name, "CanReclaimVCell:WatermarkUnknown");
+    return false;
+  }
+
+  version_t next_ts = std::numeric_limits<version_t>::max();
+  for (int i = 0; i < MAX_VCELL_NUM; i++) {
+    if (i != min_pos && cvt->vcell[i].version < next_ts) {
+      next_ts = cvt->vcell[i].version;
+    }
+  }
+
+  if (next_ts <= watermark) {
+    vcell_reclaim_cnt[t_id]++;
+    return true;
+  }
+
+  vcell_in_use_cnt[t_id]++;
+  event_counter.RegEvent(t_id, txn_name, "CanReclaimVCell:VersionInUse");
+  return false;
+}
+
 // RDMA write `wt_data' with size `size' to remote
 ALWAYS_INLINE
 bool TXN::RDMAWriteRoundTrip(RCQP* qp, char* wt_data,
@@ -713,4 +1088,168 @@ void TXN::Clean() {
   read_write_set.clear();
   locked_rw_set.clear();
   inserted_pos.clear();
+  expired_locks.clear();
+  unlinked_deltas.clear();
+  unlinked_chains.clear();
+  overflow_reads.clear();
+  commit_writes.clear();
+}
+
+// Like the GC refresh, my last read is collected once my requests complete. The ticker's FAA both ticks the
+// counter and reads it
+ALWAYS_INLINE
+void TXN::RefreshLeaseEpoch() {
+  if (lease_refreshing) {
+    if (coro_sched->PendingCount(coro_id) != 0) return;
+    lease_clock->FinishRefresh(*(uint64_t*)lease_buf);
+    lease_refreshing = false;
+  }
+
+  if (!lease_clock->StartRefresh(SteadyUs())) {
+    return;
+  }
+  lease_refreshing = true;
+
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetLeaseEpochNodeID());
+  if (lease_clock->IsTicker()) {
+    coro_sched->RDMAFAA(coro_id, qp, lease_buf, global_meta_man->GetLeaseEpochOffset(), 1);
+  } else {
+    coro_sched->RDMARead(coro_id, qp, lease_buf, global_meta_man->GetLeaseEpochOffset(), sizeof(uint64_t));
+  }
+}
+
+// The writes of my committed txns have completed if I have no pending request. Then no txn that
+// starts afterwards reads the unlinked blocks
+ALWAYS_INLINE
+void TXN::RetireUnlinkedDeltas() {
+  if (committed_unlinked_deltas.empty() || coro_sched->PendingCount(coro_id) != 0) {
+    return;
+  }
+  tx_id_t unlink_ts = tx_id_generator.load();
+  for (auto& d : committed_unlinked_deltas) {
+    thread_delta_offset_alloc->Retire(d.offset, d.size, unlink_ts);
+  }
+  committed_unlinked_deltas.clear();
+}
+
+// Collect my last refresh once its read completes, and start a new one if it is due. The slots are
+// read asynchronously, and collected in a later Begin or Commit, where my requests have completed
+ALWAYS_INLINE
+void TXN::RefreshGCWatermark() {
+  static_assert(sizeof(GCSlot) == GC_SLOT_SIZE, "GC slot layout mismatch");
+
+  uint64_t now_us = WallClockUs();
+
+  if (gc_refreshing) {
+    if (coro_sched->PendingCount(coro_id) != 0) return;
+    gc_watermark->FinishRefresh((GCSlot*)(gc_slot_buf + GC_SLOT_SIZE),
+                                MAX_CLIENT_NUM_PER_MN,
+                                (uint64_t*)(gc_slot_buf + GC_SLOT_SIZE * (1 + MAX_CLIENT_NUM_PER_MN)),
+                                now_us);
+    gc_refreshing = false;
+    if (t_id == 0) AdvanceGCFloor(now_us);
+  }
+
+  if (!gc_watermark->StartRefresh(now_us)) {
+    return;
+  }
+  gc_refreshing = true;
+
+  GCSlot* my_slot = (GCSlot*)gc_slot_buf;
+  tx_id_t thread_min = gc_watermark->ThreadMin(now_us);
+  tx_id_t thread_long_min = gc_watermark->ThreadLongMin();
+  my_slot->min_start_time = (thread_min == TxnWatermark::IDLE) ? 0 : thread_min;
+  my_slot->min_long_start_time = (thread_long_min == TxnWatermark::IDLE) ? 0 : thread_long_min;
+  my_slot->publish_ms = now_us / 1000;
+  my_slot->padding = 0;
+
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetGCSlotNodeID());
+  coro_sched->RDMAWrite(coro_id, qp, gc_slot_buf, global_meta_man->GetGCSlotOffset(t_id), GC_SLOT_SIZE);
+  coro_sched->RDMARead(coro_id, qp, gc_slot_buf + GC_SLOT_SIZE, global_meta_man->GetGCSlotStartOffset(),
+                       GC_SLOT_SIZE * MAX_CLIENT_NUM_PER_MN + GC_FLOOR_SIZE);
+}
+
+// The floor moves only to a next floor announced at least GC_FLOOR_GRACE_MS ago, and only when no AS OF
+// reader pins it. The CAS compares the pin count too, so a pin that arrives meanwhile fails it. Each step
+// is checked by my next refresh, which reads the floor words again
+ALWAYS_INLINE
+void TXN::AdvanceGCFloor(uint64_t now_us) {
+  uint64_t floor_word = gc_watermark->GetFloorWord();
+  tx_id_t floor = GCWatermark::FloorTs(floor_word);
+  char* scratch = gc_slot_buf + GC_SLOT_SIZE * (1 + MAX_CLIENT_NUM_PER_MN) + GC_FLOOR_SIZE;
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetGCSlotNodeID());
+
+  if (gc_watermark->GetNextFloor() > floor) {
+    if (!gc_watermark->IsNextFloorDue(now_us)) return;
+    if (GCWatermark::FloorPins(floor_word) != 0) {
+      event_counter.RegEvent(t_id, txn_name, "AdvanceGCFloor:Pinned");
+      return;
+    }
+    coro_sched->RDMACAS(coro_id, qp, scratch, global_meta_man->GetGCFloorOffset(), floor_word,
+                        GCWatermark::MakeFloorWord(gc_watermark->GetNextFloor(), 0));
+    return;
+  }
+
+  // The next floor is no newer than the watermark, so no running txn but the AS OF readers reads below it
+  tx_id_t next_floor = gc_watermark->Get();
+  if (next_floor == GCWatermark::UNKNOWN) return;
+  if (next_floor == TxnWatermark::IDLE) next_floor = tx_id_generator.load();
+  if (next_floor <= floor) return;
+
+  *(uint64_t*)(scratch + sizeof(uint64_t)) = next_floor;
+  coro_sched->RDMAWrite(coro_id, qp, scratch + sizeof(uint64_t), global_meta_man->GetGCFloorOffset() + sizeof(uint64_t),
+                        sizeof(uint64_t));
+  gc_watermark->AnnounceNextFloor(next_floor, now_us);
+}
+
+ALWAYS_INLINE
+void TXN::UnpinGCFloor() {
+  // Nothing waits for the unpin
+  RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(global_meta_man->GetGCSlotNodeID());
+  coro_sched->RDMAFAA(coro_id, qp, gc_pin_buf + sizeof(uint64_t), global_meta_man->GetGCFloorOffset(), (uint64_t)-1);
+  as_of_pinned = false;
+}
+
+ALWAYS_INLINE
+void TXN::Unpublish() {
+  if (as_of_pinned) UnpinGCFloor();
+  if (txn_watermark) txn_watermark->Clear(t_id, coro_id);
+  if (gc_watermark) gc_watermark->Clear(coro_id);
+}
+
+ALWAYS_INLINE
+AttrPos* TXN::NewAttrPos() {
+  if (attr_pos_used == attr_pos_pool.size()) {
+    attr_pos_pool.emplace_back(new AttrPos());
+  }
+  AttrPos* attr_pos = attr_pos_pool[attr_pos_used++].get();
+  attr_pos->local_attr_buf = nullptr;
+  attr_pos->offs_within_struct.clear();
+  attr_pos->lens.clear();
+  return attr_pos;
+}
+
+ALWAYS_INLINE
+std::vector<OldAttrPos>* TXN::NewOldAttrPos() {
+  if (old_attr_pos_used == old_attr_pos_pool.size()) {
+    old_attr_pos_pool.emplace_back(new std::vector<OldAttrPos>());
+  }
+  std::vector<OldAttrPos>* old_attr_pos = old_attr_pos_pool[old_attr_pos_used++].get();
+  old_attr_pos->clear();
+  return old_attr_pos;
+}
+
+ALWAYS_INLINE
+bool TXN::IsLocked(lock_t lock, const DataSetItem* item) {
+  if (lock == STATE_UNLOCKED) {
+    return false;
+  }
+#if LEASE_LOCK
+  if (unlikely(lease_clock && IsLeaseExpired(lock, lease_clock->Epoch()))) {
+    expired_locks.emplace_back(ExpiredLock{.node_id = item->read_which_node,
+                                           .lock_off = (offset_t)item->GetRemoteLockAddr(),
+                                           .lock = lock});
+  }
+#endif
+  return true;
 }
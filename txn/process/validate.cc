@@ -4,17 +4,64 @@
 #include "process/txn.h"
 
 void TXN::IssueValidate(std::vector<ValidateRead>& pending_validate) {
-  // For read-only items, we only need to read their versions
+  // For SI and RC, R-O items do not need validation
+  if (iso_level != ISOLATION::SR) {
+    return;
+  }
+
+  // The CVTs locked by myself cannot be modified by others, so their validations are skipped
+  auto& self_locked = validate_self_locked;
+  self_locked.clear();
+  for (auto& index : locked_rw_set) {
+    auto& item = read_write_set[index];
+    self_locked.emplace_back(item->read_which_node, item->header.remote_offset);
+  }
+  std::sort(self_locked.begin(), self_locked.end());
+
+  // For read-only items, we only need to read their locks and versions.
+  // The reads to the same node are doorbelled with one signaled completion. The doorbells are empty
+  // between validations, since each one is sent before IssueValidate returns
+
   for (auto& set_it : read_only_set) {
+    // Tables never written after loading do not need validation
+    if (READ_ONLY_TABLE[set_it->header.table_id]) {
+      continue;
+    }
+
+    if (std::binary_search(self_locked.begin(), self_locked.end(), std::make_pair(set_it->read_which_node, set_it->header.remote_offset))) {
+      continue;
+    }
+
     // If reading from backup, using backup's qp to validate the version on backup.
     // Otherwise, the qp mismatches the remote version addr
     RCQP* qp = thread_qp_man->GetRemoteDataQPWithNodeID(set_it->read_which_node);
-    char* cvt_buf = thread_rdma_buffer_alloc->Alloc(CVTSize);
+
+    // The buffer keeps the CVT layout so that the fetched lock and vcells are accessed via CVT*
+    char* cvt_buf = coro_rdma_buffer_alloc->Alloc(CVTSize);
 
     pending_validate.emplace_back(ValidateRead{.item = set_it.get(), .cvt_buf = cvt_buf});
-    
-    coro_sched->RDMARead(coro_id, qp, cvt_buf, set_it->header.remote_offset, CVTSize);
-    // CheckAddr(set_it->header.remote_offset, CVTSize, "IssueValidate");
+
+    if ((size_t)set_it->read_which_node >= validate_doorbells.size()) {
+      validate_doorbells.resize(set_it->read_which_node + 1);
+    }
+    auto& doorbell = validate_doorbells[set_it->read_which_node];
+    if (!doorbell) {
+      doorbell.reset(new ValidateBatch());
+    }
+
+    doorbell->AddReadReq(cvt_buf + offsetof(Header, lock), set_it->GetRemoteLockAddr(), ValidateReadSize);
+    // CheckAddr(set_it->GetRemoteLockAddr(), ValidateReadSize, "IssueValidate");
+
+    if (doorbell->IsFull()) {
+      doorbell->SendReqs(coro_sched, qp, coro_id);
+    }
+  }
+
+  for (size_t node_id = 0; node_id < validate_doorbells.size(); node_id++) {
+    auto& doorbell = validate_doorbells[node_id];
+    if (doorbell && !doorbell->IsEmpty()) {
+      doorbell->SendReqs(coro_sched, thread_qp_man->GetRemoteDataQPWithNodeID(node_id), coro_id);
+    }
   }
 }
 
@@ -24,17 +71,19 @@ bool TXN::CheckValidate(std::vector<ValidateRead>& pending_validate) {
   // For those eagerly locked R-W, we have choosen write_pos at read, since the lock succeeds at read
   // For those delayed locked R-W, we have choosen write_pos at CheckValue, since the lock succeeds at CheckValue
 
-  // -> Requirements for SI
-  // --- For R-O: Nothing to do
-  if (global_meta_man->iso_level == ISOLATION::SI) {
+  // -> Requirements for SI and RC
+  // --- For R-O: Nothing to do. No validation is issued
+  if (iso_level != ISOLATION::SR) {
     return true;
   }
 
   // -> Requirements for SR
   // --- For R-O: Whether the R-O is locked? Using Tcommit to identify version
+  // --- Only the lock and vcells are fetched into cvt_buf. R-O items locked by myself are not in pending_validate
   for (auto& re : pending_validate) {
     CVT* re_read_cvt = (CVT*)re.cvt_buf;
-    if ((*(CVT*)(re.cvt_buf)).header.lock == STATE_LOCKED) {
+    // A locked CVT holds the locker's lock word
+    if (IsLocked(re_read_cvt->header.lock, re.item)) {
       event_counter.RegEvent(t_id, txn_name, "CheckValidate:RO is Locked");
       return false;
     }
@@ -0,0 +1,313 @@
+// Author: Ming Zhang
+// Copyright (c) 2023
+
+#pragma once
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <new>
+
+#include "base/common.h"
+#include "rlib/logging.hpp"
+
+// The start times of the running txns in this CN. Each coordinator publishes its start time
+// before issuing any read. The minimum is the low watermark: a txn that starts later cannot
+// read the data unlinked before the watermark is computed
+class TxnWatermark {
+ public:
+  TxnWatermark(t_id_t thread_num_per_machine, int coro_num_per_thread)
+      : thread_num(thread_num_per_machine), coro_num(coro_num_per_thread) {
+    slot_num = (size_t)thread_num * coro_num;
+    // new[] does not honor the over-alignment of Slot before C++17
+    void* mem = nullptr;
+    if (posix_memalign(&mem, alignof(Slot), sizeof(Slot) * slot_num) != 0) {
+      RDMA_LOG(FATAL) << "Fail to allocate the txn watermark slots";
+    }
+    slots = (Slot*)mem;
+    for (size_t i = 0; i < slot_num; i++) {
+      new (&slots[i]) Slot();
+      slots[i].start_time.store(IDLE, std::memory_order_relaxed);
+    }
+  }
+
+  ~TxnWatermark() {
+    free(slots);
+  }
+
+  ALWAYS_INLINE
+  void Publish(t_id_t global_tid, coro_id_t coro_id, tx_id_t start_time) {
+    slots[Index(global_tid, coro_id)].start_time.store(start_time, std::memory_order_seq_cst);
+  }
+
+  // The coordinator runs no more txns
+  ALWAYS_INLINE
+  void Clear(t_id_t global_tid, coro_id_t coro_id) {
+    slots[Index(global_tid, coro_id)].start_time.store(IDLE, std::memory_order_release);
+  }
+
+  // Give the minimum start time of the running txns. IDLE if there is none
+  tx_id_t Compute() const {
+    tx_id_t min_ts = IDLE;
+    for (size_t i = 0; i < slot_num; i++) {
+      tx_id_t ts = slots[i].start_time.load(std::memory_order_seq_cst);
+      if (ts < min_ts) min_ts = ts;
+    }
+    return min_ts;
+  }
+
+  static constexpr tx_id_t IDLE = std::numeric_limits<tx_id_t>::max();
+
+ private:
+  // Global thread ids in a CN are consecutive
+  ALWAYS_INLINE
+  size_t Index(t_id_t global_tid, coro_id_t coro_id) const {
+    return (size_t)(global_tid % thread_num) * coro_num + coro_id;
+  }
+
+  struct Slot {
+    std::atomic<tx_id_t> start_time;
+  } __attribute__((aligned(64)));  // Avoid false sharing among coordinators
+
+  Slot* slots;
+
+  size_t slot_num;
+
+  t_id_t thread_num;
+
+  int coro_num;
+};
+
+// Wall clock (us). The publish times in the GC slots are compared across CNs, so the clock skew should be far below GC_SLOT_EXPIRE_MS
+ALWAYS_INLINE
+uint64_t WallClockUs() {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+// One slot per CN thread in the GC watermark region of a memory node
+struct GCSlot {
+  tx_id_t min_start_time;       // Minimum start time of the thread's running txns. 0 if none
+  tx_id_t min_long_start_time;  // Minimum start time of the thread's registered long readers. 0 if none
+  uint64_t publish_ms;          // Wall clock of the publication. 0 if never published
+  uint64_t padding;
+};
+
+// A thread's view of the cluster-wide GC watermark, i.e., the minimum start time of the running
+// txns in all CNs. Each thread periodically writes the minimum of its coordinators into its slot,
+// and reads back all the slots in one RDMA read. A txn that starts later has a larger start time,
+// so a version superseded by one not after the watermark is readable by no one.
+// The slots of the threads that have stopped are not refreshed, and are skipped after GC_SLOT_EXPIRE_MS.
+// Skipping a live but slow thread is safe: its readers would abort with no readable version.
+//
+// Long readers are excluded from the watermark, so that they do not hold back the writers. Instead, the
+// writers spill the versions they supersede into the overflow chains while a long reader older than them
+// runs. A long reader stays in the watermark until its registration reaches all the CN threads,
+// i.e., two refresh intervals
+class GCWatermark {
+ public:
+  GCWatermark(int coro_num_per_thread, uint64_t refresh_interval_us)
+      : coro_num(coro_num_per_thread), refresh_us(refresh_interval_us), watermark(UNKNOWN),
+        long_watermark(UNKNOWN), last_refresh_us(0), refreshing(false), floor_word(0), next_floor(UNKNOWN),
+        seen_next_floor(UNKNOWN), seen_next_since_us(0) {
+    coro_start_times = new tx_id_t[coro_num];
+    coro_long_start_times = new tx_id_t[coro_num];
+    coro_long_since_us = new uint64_t[coro_num];
+    for (int i = 0; i < coro_num; i++) {
+      coro_start_times[i] = TxnWatermark::IDLE;
+      coro_long_start_times[i] = TxnWatermark::IDLE;
+      coro_long_since_us[i] = 0;
+    }
+  }
+
+  ~GCWatermark() {
+    delete[] coro_start_times;
+    delete[] coro_long_start_times;
+    delete[] coro_long_since_us;
+  }
+
+  // Coroutines of a thread run one at a time, so no atomics are needed
+  ALWAYS_INLINE
+  void Publish(coro_id_t coro_id, tx_id_t start_time) {
+    coro_start_times[coro_id] = start_time;
+    coro_long_start_times[coro_id] = TxnWatermark::IDLE;
+  }
+
+  // The coroutine runs no txn until its next Publish
+  ALWAYS_INLINE
+  void Clear(coro_id_t coro_id) {
+    coro_start_times[coro_id] = TxnWatermark::IDLE;
+    coro_long_start_times[coro_id] = TxnWatermark::IDLE;
+  }
+
+  ALWAYS_INLINE
+  void PublishLong(coro_id_t coro_id, tx_id_t start_time, uint64_t now_us) {
+    coro_start_times[coro_id] = TxnWatermark::IDLE;
+    coro_long_start_times[coro_id] = start_time;
+    coro_long_since_us[coro_id] = now_us;
+  }
+
+  // Whether the writers in all CNs know this long reader
+  ALWAYS_INLINE
+  bool IsLongRegistered(coro_id_t coro_id, uint64_t now_us) const {
+    return now_us >= coro_long_since_us[coro_id] + 2 * refresh_us;
+  }
+
+  ALWAYS_INLINE
+  tx_id_t ThreadMin(uint64_t now_us) const {
+    tx_id_t min_ts = TxnWatermark::IDLE;
+    for (int i = 0; i < coro_num; i++) {
+      if (coro_start_times[i] < min_ts) min_ts = coro_start_times[i];
+      if (coro_long_start_times[i] < min_ts && !IsLongRegistered(i, now_us)) min_ts = coro_long_start_times[i];
+    }
+    return min_ts;
+  }
+
+  ALWAYS_INLINE
+  tx_id_t ThreadLongMin() const {
+    tx_id_t min_ts = TxnWatermark::IDLE;
+    for (int i = 0; i < coro_num; i++) {
+      if (coro_long_start_times[i] < min_ts) min_ts = coro_long_start_times[i];
+    }
+    return min_ts;
+  }
+
+  // Whether a refresh is due. At most one refresh of a thread is in flight
+  ALWAYS_INLINE
+  bool StartRefresh(uint64_t now_us) {
+    if (refreshing || now_us - last_refresh_us < refresh_us) return false;
+    refreshing = true;
+    last_refresh_us = now_us;
+    return true;
+  }
+
+  // The floor words are read right after the slots
+  void FinishRefresh(const GCSlot* slots, size_t slot_num, const uint64_t* floor_words, uint64_t now_us) {
+    // My own slot may be read before my write lands
+    tx_id_t min_ts = ThreadMin(now_us);
+    tx_id_t min_long_ts = ThreadLongMin();
+    uint64_t now_ms = now_us / 1000;
+    for (size_t i = 0; i < slot_num; i++) {
+      if (slots[i].publish_ms == 0 || now_ms > slots[i].publish_ms + GC_SLOT_EXPIRE_MS) continue;
+      if (slots[i].min_start_time != 0 && slots[i].min_start_time < min_ts) {
+        min_ts = slots[i].min_start_time;
+      }
+      if (slots[i].min_long_start_time != 0 && slots[i].min_long_start_time < min_long_ts) {
+        min_long_ts = slots[i].min_long_start_time;
+      }
+    }
+    watermark = min_ts;
+    long_watermark = min_long_ts;
+
+    floor_word = floor_words[0];
+    next_floor = floor_words[1];
+    if (next_floor != seen_next_floor) {
+      // The grace period of a next floor is counted from when I first see it, which is never before it is announced
+      seen_next_floor = next_floor;
+      seen_next_since_us = now_us;
+    }
+    refreshing = false;
+  }
+
+  // UNKNOWN before the first refresh completes. IDLE if no txn is running
+  ALWAYS_INLINE
+  tx_id_t Get() const {
+    return watermark;
+  }
+
+  // The minimum start time of the long readers in all CNs. UNKNOWN before the first refresh completes. IDLE if none
+  ALWAYS_INLINE
+  tx_id_t GetLong() const {
+    return long_watermark;
+  }
+
+  // The writers reuse no version that is still visible at the retention floor. UNKNOWN until both are known
+  ALWAYS_INLINE
+  tx_id_t GetReclaim() const {
+    tx_id_t floor = GetFloor();
+    if (watermark == UNKNOWN || floor == UNKNOWN) return UNKNOWN;
+    return std::min(watermark, floor);
+  }
+
+  // The retention floor of the AS OF readers. UNKNOWN until the advancer sets it for the first time
+  ALWAYS_INLINE
+  tx_id_t GetFloor() const {
+    return FloorTs(floor_word);
+  }
+
+  // The floor never passes the announced next floor until GC_FLOOR_GRACE_MS after the next one is announced
+  ALWAYS_INLINE
+  tx_id_t GetNextFloor() const {
+    return std::max(GetFloor(), next_floor);
+  }
+
+  ALWAYS_INLINE
+  uint64_t GetFloorWord() const {
+    return floor_word;
+  }
+
+  // Whether the announced next floor has been seen for the grace period, so the advancer may move the floor to it
+  ALWAYS_INLINE
+  bool IsNextFloorDue(uint64_t now_us) const {
+    return next_floor > GetFloor() && now_us >= seen_next_since_us + GC_FLOOR_GRACE_MS * 1000;
+  }
+
+  // The advancer announces a next floor. I see it as announced now, before my read of it returns
+  ALWAYS_INLINE
+  void AnnounceNextFloor(tx_id_t ts, uint64_t now_us) {
+    seen_next_floor = ts;
+    seen_next_since_us = now_us;
+  }
+
+  ALWAYS_INLINE
+  static tx_id_t FloorTs(uint64_t word) {
+    return word >> FLOOR_PIN_BITS;
+  }
+
+  ALWAYS_INLINE
+  static uint64_t FloorPins(uint64_t word) {
+    return word & ((1ULL << FLOOR_PIN_BITS) - 1);
+  }
+
+  ALWAYS_INLINE
+  static uint64_t MakeFloorWord(tx_id_t floor, uint64_t pins) {
+    return (floor << FLOOR_PIN_BITS) | pins;
+  }
+
+  static constexpr tx_id_t UNKNOWN = 0;
+
+  static constexpr int FLOOR_PIN_BITS = 16;
+
+  static constexpr uint64_t GC_FLOOR_GRACE_MS = 10;
+
+  static constexpr uint64_t GC_SLOT_EXPIRE_MS = 1000;
+
+ private:
+  tx_id_t* coro_start_times;
+
+  tx_id_t* coro_long_start_times;
+
+  uint64_t* coro_long_since_us;  // When the long reader is registered
+
+  int coro_num;
+
+  uint64_t refresh_us;
+
+  tx_id_t watermark;
+
+  tx_id_t long_watermark;
+
+  uint64_t last_refresh_us;
+
+  bool refreshing;
+
+  uint64_t floor_word;  // My view of <floor << 16 | pin count>
+
+  tx_id_t next_floor;  // My view of the announced next floor
+
+  tx_id_t seen_next_floor;
+
+  uint64_t seen_next_since_us;  // When I first see the next floor
+};
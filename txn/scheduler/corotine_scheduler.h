@@ -4,6 +4,8 @@
 #pragma once
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "base/common.h"
 #include "rlib/logging.hpp"
@@ -12,6 +14,9 @@
 
 using namespace rdmaio;
 
+// The wr_id of a batch posted on behalf of a group of coroutines
+static const uint64_t GROUP_WR_FLAG = (1ULL << 63);
+
 // Scheduling coroutines. Each txn thread only has ONE scheduler
 class CoroutineScheduler {
  public:
@@ -60,6 +65,16 @@ class CoroutineScheduler {
 
   bool RDMAMaskedCAS(coro_id_t coro_id, RCQP* qp, char* local_buf, uint64_t remote_offset, uint64_t compare, uint64_t swap, uint64_t compare_mask, uint64_t swap_mask);
 
+  bool RDMAFAA(coro_id_t coro_id, RCQP* qp, char* local_buf, uint64_t remote_offset, uint64_t add);
+
+  // For group commit. The coroutine waits for requests that will be posted later, maybe by others
+  void HoldCoroutine(coro_id_t coro_id);
+
+  // Create a group whose member coroutines are held. They are woken up after all the batches of the group complete
+  uint64_t NewGroup(const std::vector<coro_id_t>& members);
+
+  void RDMAGroupBatch(uint64_t group_id, RCQP* qp, ibv_send_wr* send_sr, ibv_send_wr** bad_sr_addr, int piggyback_num);
+
   // For polling
   void PollCompletion(t_id_t tid);  // There is a coroutine polling ACKs
 
@@ -69,6 +84,9 @@ class CoroutineScheduler {
   // For coroutine yield, used by transactions
   void Yield(coro_yield_t& yield, coro_id_t cid);
 
+  // For a coroutine that has no work, e.g., no incoming request. It stays in the yield-able coroutine list
+  void YieldIdle(coro_yield_t& yield, coro_id_t cid);
+
   // Append this coroutine to the tail of the yield-able coroutine list
   // Used by coroutine 0
   void AppendCoroutine(Coroutine* coro);
@@ -76,6 +94,15 @@ class CoroutineScheduler {
   // Start this coroutine. Used by coroutine 0
   void RunCoroutine(coro_yield_t& yield, Coroutine* coro);
 
+  // Whether all the coroutines except coroutine 0 are waiting
+  bool AllWaiting();
+
+  // Number of signaled requests of this coroutine that have not completed
+  int PendingCount(coro_id_t coro_id) const { return pending_counts[coro_id]; }
+
+  // Whether any signaled request of this thread has not completed
+  bool HasPending() const { return !pending_qps.empty(); }
+
  public:
   Coroutine* coro_array;
 
@@ -90,6 +117,17 @@ class CoroutineScheduler {
 
   // number of pending qps (i.e., the ack has not received) per coroutine
   int* pending_counts;
+
+  struct CoroGroup {
+    std::vector<coro_id_t> members;
+    int pending_batch_num;
+  };
+
+  std::unordered_map<uint64_t, CoroGroup> groups;
+
+  uint64_t next_group_id = 0;
+
+  void ReleaseCoroutine(coro_id_t coro_id);
 };
 
 ALWAYS_INLINE
@@ -223,6 +261,49 @@ bool CoroutineScheduler::RDMAMaskedCAS(coro_id_t coro_id,
   return true;
 }
 
+ALWAYS_INLINE
+bool CoroutineScheduler::RDMAFAA(coro_id_t coro_id, RCQP* qp, char* local_buf, uint64_t remote_offset, uint64_t add) {
+  auto rc = qp->post_faa(local_buf, remote_offset, add, IBV_SEND_SIGNALED, coro_id);
+  if (rc != SUCC) {
+    RDMA_LOG(ERROR) << "client: post faa fail. rc=" << rc << ", tid = " << t_id << ", coroid = " << coro_id;
+    return false;
+  }
+  AddPendingQP(coro_id, qp);
+  return true;
+}
+
+ALWAYS_INLINE
+void CoroutineScheduler::HoldCoroutine(coro_id_t coro_id) {
+  pending_counts[coro_id] += 1;
+}
+
+ALWAYS_INLINE
+void CoroutineScheduler::ReleaseCoroutine(coro_id_t coro_id) {
+  assert(pending_counts[coro_id] > 0);
+  pending_counts[coro_id] -= 1;
+  if (pending_counts[coro_id] == 0) {
+    AppendCoroutine(&coro_array[coro_id]);
+  }
+}
+
+ALWAYS_INLINE
+uint64_t CoroutineScheduler::NewGroup(const std::vector<coro_id_t>& members) {
+  uint64_t group_id = next_group_id++;
+  groups[group_id] = CoroGroup{.members = members, .pending_batch_num = 0};
+  return group_id;
+}
+
+ALWAYS_INLINE
+void CoroutineScheduler::RDMAGroupBatch(uint64_t group_id, RCQP* qp, ibv_send_wr* send_sr, ibv_send_wr** bad_sr_addr, int piggyback_num) {
+  send_sr[piggyback_num].wr_id = GROUP_WR_FLAG | group_id;
+  auto rc = qp->post_batch(send_sr, bad_sr_addr);
+  if (rc != SUCC) {
+    RDMA_LOG(FATAL) << "client: post group batch fail. rc=" << rc << ", tid = " << t_id << ", group = " << group_id;
+  }
+  groups[group_id].pending_batch_num += 1;
+  pending_qps.push_back(qp);
+}
+
 // Link coroutines in a loop manner
 ALWAYS_INLINE
 void CoroutineScheduler::LoopLinkCoroutine(coro_id_t coro_num) {
@@ -257,6 +338,11 @@ void CoroutineScheduler::Yield(coro_yield_t& yield, coro_id_t cid) {
   RunCoroutine(yield, next);
 }
 
+ALWAYS_INLINE
+void CoroutineScheduler::YieldIdle(coro_yield_t& yield, coro_id_t cid) {
+  RunCoroutine(yield, coro_array[cid].next_coro);
+}
+
 // Start this coroutine. Used by coroutine 0 and Yield()
 ALWAYS_INLINE
 void CoroutineScheduler::RunCoroutine(coro_yield_t& yield, Coroutine* coro) {
@@ -265,6 +351,11 @@ void CoroutineScheduler::RunCoroutine(coro_yield_t& yield, Coroutine* coro) {
   yield(coro->func);
 }
 
+ALWAYS_INLINE
+bool CoroutineScheduler::AllWaiting() {
+  return coro_head->next_coro == coro_head;
+}
+
 // Append this coroutine to the tail of the yield-able coroutine list. Used by coroutine 0
 ALWAYS_INLINE
 void CoroutineScheduler::AppendCoroutine(Coroutine* coro) {
@@ -296,6 +387,19 @@ void CoroutineScheduler::PollCompletion(t_id_t tid) {
         continue;
       }
     }
+    if (wc.wr_id & GROUP_WR_FLAG) {
+      auto group = groups.find(wc.wr_id & ~GROUP_WR_FLAG);
+      assert(group != groups.end());
+      group->second.pending_batch_num -= 1;
+      if (group->second.pending_batch_num == 0) {
+        for (auto member : group->second.members) {
+          ReleaseCoroutine(member);
+        }
+        groups.erase(group);
+      }
+      it = pending_qps.erase(it);
+      continue;
+    }
     auto coro_id = wc.wr_id;
     if (coro_id == 0) continue;
     assert(pending_counts[coro_id] > 0);
@@ -9,6 +9,7 @@
 /* Called by main. Only initialize here. The worker threads will populate. */
 void MICRO::LoadTable(node_id_t node_id,
                       node_id_t num_server,
+                      const int* table_backup_num,
                       MemStoreAllocParam* mem_store_alloc_param,
                       size_t& total_size,
                       size_t& ht_loadfv_size,
@@ -44,9 +45,10 @@ void MICRO::LoadTable(node_id_t node_id,
   std::cout << "----------------------------------------------------------" << std::endl;
   // Assign backup
 
-  if (BACKUP_NUM < num_server) {
-    for (node_id_t i = 1; i <= BACKUP_NUM; i++) {
-      if ((node_id_t)MicroTableType::kMicroTable % num_server == (node_id - i + num_server) % num_server) {
+  // The i-th backup is on the i-th MN after the primary. Co-located tables follow the first one
+  if (num_server > 1) {
+    for (node_id_t i = 1; i < num_server; i++) {
+      if ((node_id_t)MicroTableType::kMicroTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)MicroTableType::kMicroTable]) {
         RDMA_LOG(EMPH) << "[Backup] MICRO table ID: " << (node_id_t)MicroTableType::kMicroTable;
         std::cerr << "Number of initial records: " << std::dec << micro_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(micro_table);
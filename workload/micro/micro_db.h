@@ -41,6 +41,7 @@ class MICRO {
 
   void LoadTable(node_id_t node_id,
                  node_id_t num_server,
+                 const int* table_backup_num,
                  MemStoreAllocParam* mem_store_alloc_param,
                  size_t& total_size,
                  size_t& ht_loadfv_size,
@@ -14,10 +14,10 @@ bool TxReadOne(coro_yield_t& yield,
   micro_key_t micro_key;
   micro_key.item_key = key;
 
-  DataSetItemPtr micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                              micro_val_t_size,
-                                                              micro_key.item_key,
-                                                              UserOP::kRead);
+  DataSetItemPtr micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                             micro_val_t_size,
+                                             micro_key.item_key,
+                                             UserOP::kRead);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -42,10 +42,10 @@ bool TxUpdateOne(coro_yield_t& yield,
   micro_key_t micro_key;
   micro_key.item_key = key;
 
-  DataSetItemPtr micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                              micro_val_t_size,
-                                                              micro_key.item_key,
-                                                              UserOP::kUpdate);
+  DataSetItemPtr micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                             micro_val_t_size,
+                                             micro_key.item_key,
+                                             UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -90,17 +90,17 @@ bool TxRWOne(ZipfGen* zipf_gen,
     assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
     if (FastRand(seed) % 100 < write_ratio) {
-      micro_records[i] = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                       micro_val_t_size,
-                                                       micro_key.item_key,
-                                                       UserOP::kUpdate);
+      micro_records[i] = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                      micro_val_t_size,
+                                      micro_key.item_key,
+                                      UserOP::kUpdate);
       txn->AddToReadWriteSet(micro_records[i]);
       is_write[i] = true;
     } else {
-      micro_records[i] = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                       micro_val_t_size,
-                                                       micro_key.item_key,
-                                                       UserOP::kRead);
+      micro_records[i] = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                      micro_val_t_size,
+                                      micro_key.item_key,
+                                      UserOP::kRead);
       txn->AddToReadOnlySet(micro_records[i]);
       is_write[i] = false;
     }
@@ -140,10 +140,10 @@ bool TxTest100(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 10;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -227,10 +227,10 @@ bool TxTest101(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 10;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kRead);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kRead);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -267,10 +267,10 @@ bool TxTest1(ZipfGen* zipf_gen,
 
   assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -313,10 +313,10 @@ bool TxTest2(ZipfGen* zipf_gen,
 
   assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -366,10 +366,10 @@ bool TxTest3(ZipfGen* zipf_gen,
 
   assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -421,10 +421,10 @@ bool TxTest4(ZipfGen* zipf_gen,
 
   assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kRead);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kRead);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -476,10 +476,10 @@ bool TxTest5(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 20;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    sizeof(micro_val_t),  // User Insert
-                                                    micro_key.item_key,
-                                                    UserOP::kInsert);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   sizeof(micro_val_t),  // User Insert
+                                   micro_key.item_key,
+                                   UserOP::kInsert);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -513,10 +513,10 @@ bool TxTest6(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 20;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kRead);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kRead);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -559,10 +559,10 @@ bool TxTest7(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 20;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -611,10 +611,10 @@ bool TxTest8(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 20;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kRead);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kRead);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -657,10 +657,10 @@ bool TxTest9(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 10;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kDelete);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kDelete);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -703,10 +703,10 @@ bool TxTest10(ZipfGen* zipf_gen,
   micro_key_t micro_key;
   micro_key.micro_id = 10;
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kRead);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kRead);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -751,10 +751,10 @@ bool TxTest11(ZipfGen* zipf_gen,
 
   assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -798,10 +798,10 @@ bool TxTest12(ZipfGen* zipf_gen,
 
   assert(micro_key.item_key >= 0 && micro_key.item_key < num_keys_global);
 
-  auto micro_record = std::make_shared<DataSetItem>((table_id_t)MicroTableType::kMicroTable,
-                                                    micro_val_t_size,
-                                                    micro_key.item_key,
-                                                    UserOP::kUpdate);
+  auto micro_record = txn->NewItem((table_id_t)MicroTableType::kMicroTable,
+                                   micro_val_t_size,
+                                   micro_key.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadOnlySet(micro_record);
 
   if (!txn->Execute(yield)) {
@@ -821,4 +821,10 @@ bool TxTest12(ZipfGen* zipf_gen,
   return commit_status;
 }
 
-/******************** The business logic (Transaction) end ********************/
\ No newline at end of file
+/******************** The business logic (Transaction) end ********************/
+
+void RegisterMicroProcedures(ProcRegistry* registry, uint64_t write_ratio) {
+  registry->AddWorkload("micro", nullptr);
+  registry->Register("micro", MicroTxType::kUpdateOne, MICRO_TX_NAME[MicroTxType::kUpdateOne], KeyedProc<TxUpdateOne>, (int)write_ratio);
+  registry->Register("micro", MicroTxType::kReadOne, MICRO_TX_NAME[MicroTxType::kReadOne], KeyedProc<TxReadOne>, 100 - (int)write_ratio);
+}
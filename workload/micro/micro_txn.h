@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "micro/micro_db.h"
+#include "process/procedure.h"
 #include "process/txn.h"
 #include "util/zipf.h"
 
@@ -171,4 +172,7 @@ bool TxTest101(ZipfGen* zipf_gen,
                uint64_t num_keys_global,
                uint64_t write_ratio);
 
-/******************** The business logic (Transaction) end ********************/
\ No newline at end of file
+/******************** The business logic (Transaction) end ********************/
+
+// Register the procedures. The write ratio (%) is the weight of updates. The ids are the MicroTxType
+void RegisterMicroProcedures(ProcRegistry* registry, uint64_t write_ratio);
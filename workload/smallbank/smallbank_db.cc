@@ -9,6 +9,7 @@
 /* Called by main. Only initialize here. The worker threads will populate. */
 void SmallBank::LoadTable(node_id_t node_id,
                           node_id_t num_server,
+                          const int* table_backup_num,
                           MemStoreAllocParam* mem_store_alloc_param,
                           size_t& total_size,
                           size_t& ht_loadfv_size,
@@ -62,15 +63,16 @@ void SmallBank::LoadTable(node_id_t node_id,
 
   std::cout << "----------------------------------------------------------" << std::endl;
   // Assign backup
-  if (BACKUP_NUM < num_server) {
-    for (node_id_t i = 1; i <= BACKUP_NUM; i++) {
-      if ((node_id_t)SmallBankTableType::kSavingsTable % num_server == (node_id - i + num_server) % num_server) {
+  // The i-th backup is on the i-th MN after the primary. Co-located tables follow the first one
+  if (num_server > 1) {
+    for (node_id_t i = 1; i < num_server; i++) {
+      if ((node_id_t)SmallBankTableType::kSavingsTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)SmallBankTableType::kSavingsTable]) {
         RDMA_LOG(DBG) << "[Backup] SAVINGS table ID: " << (node_id_t)SmallBankTableType::kSavingsTable;
         std::cerr << "Number of initial records: " << std::dec << savings_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(savings_table);
       }
 
-      if ((node_id_t)SmallBankTableType::kCheckingTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)SmallBankTableType::kCheckingTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)SmallBankTableType::kCheckingTable]) {
         RDMA_LOG(DBG) << "[Backup] CHECKING table ID: " << (node_id_t)SmallBankTableType::kCheckingTable;
         std::cerr << "Number of initial records: " << std::dec << checking_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(checking_table);
@@ -48,33 +48,6 @@ class SmallBank {
     if (checking_table) delete checking_table;
   }
 
-  SmallBankTxType* CreateWorkgenArray() {
-    SmallBankTxType* workgen_arr = new SmallBankTxType[100];
-
-    int i = 0, j = 0;
-
-    j += FREQUENCY_AMALGAMATE;
-    for (; i < j; i++) workgen_arr[i] = SmallBankTxType::kAmalgamate;
-
-    j += FREQUENCY_BALANCE;
-    for (; i < j; i++) workgen_arr[i] = SmallBankTxType::kBalance;
-
-    j += FREQUENCY_DEPOSIT_CHECKING;
-    for (; i < j; i++) workgen_arr[i] = SmallBankTxType::kDepositChecking;
-
-    j += FREQUENCY_SEND_PAYMENT;
-    for (; i < j; i++) workgen_arr[i] = SmallBankTxType::kSendPayment;
-
-    j += FREQUENCY_TRANSACT_SAVINGS;
-    for (; i < j; i++) workgen_arr[i] = SmallBankTxType::kTransactSaving;
-
-    j += FREQUENCY_WRITE_CHECK;
-    for (; i < j; i++) workgen_arr[i] = SmallBankTxType::kWriteCheck;
-
-    assert(i == 100 && j == 100);
-    return workgen_arr;
-  }
-
   /*
    * Generators for new account IDs. Called once per transaction because
    * we need to decide hot-or-not per transaction, not per account.
@@ -105,6 +78,7 @@ class SmallBank {
 
   void LoadTable(node_id_t node_id,
                  node_id_t num_server,
+                 const int* table_backup_num,
                  MemStoreAllocParam* mem_store_alloc_param,
                  size_t& total_size,
                  size_t& ht_loadfv_size,
@@ -19,27 +19,27 @@ bool TxAmalgamate(SmallBank* smallbank_client,
   /* Read from savings and checking tables for acct_id_0 */
   smallbank_savings_key_t sav_key_0;
   sav_key_0.acct_id = acct_id_0;
-  auto sav_record_0 = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kSavingsTable,
-                                                    smallbank_savings_val_t_size,
-                                                    sav_key_0.item_key,
-                                                    UserOP::kUpdate);
+  auto sav_record_0 = txn->NewItem((table_id_t)SmallBankTableType::kSavingsTable,
+                                   smallbank_savings_val_t_size,
+                                   sav_key_0.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(sav_record_0);
 
   smallbank_checking_key_t chk_key_0;
   chk_key_0.acct_id = acct_id_0;
-  auto chk_record_0 = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                    smallbank_checking_val_t_size,
-                                                    chk_key_0.item_key,
-                                                    UserOP::kUpdate);
+  auto chk_record_0 = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                   smallbank_checking_val_t_size,
+                                   chk_key_0.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(chk_record_0);
 
   /* Read from checking account for acct_id_1 */
   smallbank_checking_key_t chk_key_1;
   chk_key_1.acct_id = acct_id_1;
-  auto chk_record_1 = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                    smallbank_checking_val_t_size,
-                                                    chk_key_1.item_key,
-                                                    UserOP::kUpdate);
+  auto chk_record_1 = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                   smallbank_checking_val_t_size,
+                                   chk_key_1.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(chk_record_1);
 
   if (!txn->Execute(yield)) return false;
@@ -87,18 +87,18 @@ bool TxBalance(SmallBank* smallbank_client,
   /* Read from savings and checking tables */
   smallbank_savings_key_t sav_key;
   sav_key.acct_id = acct_id;
-  auto sav_record = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kSavingsTable,
-                                                  smallbank_savings_val_t_size,
-                                                  sav_key.item_key,
-                                                  UserOP::kRead);
+  auto sav_record = txn->NewItem((table_id_t)SmallBankTableType::kSavingsTable,
+                                 smallbank_savings_val_t_size,
+                                 sav_key.item_key,
+                                 UserOP::kRead);
   txn->AddToReadOnlySet(sav_record);
 
   smallbank_checking_key_t chk_key;
   chk_key.acct_id = acct_id;
-  auto chk_record = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                  smallbank_checking_val_t_size,
-                                                  chk_key.item_key,
-                                                  UserOP::kRead);
+  auto chk_record = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                 smallbank_checking_val_t_size,
+                                 chk_key.item_key,
+                                 UserOP::kRead);
   txn->AddToReadOnlySet(chk_record);
 
   if (!txn->Execute(yield)) return false;
@@ -133,10 +133,10 @@ bool TxDepositChecking(SmallBank* smallbank_client,
   /* Read from checking table */
   smallbank_checking_key_t chk_key;
   chk_key.acct_id = acct_id;
-  auto chk_record = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                  smallbank_checking_val_t_size,
-                                                  chk_key.item_key,
-                                                  UserOP::kUpdate);
+  auto chk_record = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                 smallbank_checking_val_t_size,
+                                 chk_key.item_key,
+                                 UserOP::kUpdate);
   txn->AddToReadWriteSet(chk_record);
 
   if (!txn->Execute(yield)) return false;
@@ -170,19 +170,19 @@ bool TxSendPayment(SmallBank* smallbank_client,
   /* Read from checking table */
   smallbank_checking_key_t chk_key_0;
   chk_key_0.acct_id = acct_id_0;
-  auto chk_record_0 = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                    smallbank_checking_val_t_size,
-                                                    chk_key_0.item_key,
-                                                    UserOP::kUpdate);
+  auto chk_record_0 = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                   smallbank_checking_val_t_size,
+                                   chk_key_0.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(chk_record_0);
 
   /* Read from checking account for acct_id_1 */
   smallbank_checking_key_t chk_key_1;
   chk_key_1.acct_id = acct_id_1;
-  auto chk_record_1 = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                    smallbank_checking_val_t_size,
-                                                    chk_key_1.item_key,
-                                                    UserOP::kUpdate);
+  auto chk_record_1 = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                   smallbank_checking_val_t_size,
+                                   chk_key_1.item_key,
+                                   UserOP::kUpdate);
   txn->AddToReadWriteSet(chk_record_1);
 
   if (!txn->Execute(yield)) return false;
@@ -228,10 +228,10 @@ bool TxTransactSaving(SmallBank* smallbank_client,
   /* Read from saving table */
   smallbank_savings_key_t sav_key;
   sav_key.acct_id = acct_id;
-  auto sav_record = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kSavingsTable,
-                                                  smallbank_savings_val_t_size,
-                                                  sav_key.item_key,
-                                                  UserOP::kUpdate);
+  auto sav_record = txn->NewItem((table_id_t)SmallBankTableType::kSavingsTable,
+                                 smallbank_savings_val_t_size,
+                                 sav_key.item_key,
+                                 UserOP::kUpdate);
   txn->AddToReadWriteSet(sav_record);
 
   if (!txn->Execute(yield)) return false;
@@ -265,18 +265,18 @@ bool TxWriteCheck(SmallBank* smallbank_client,
   /* Read from savings. Read checking record for update. */
   smallbank_savings_key_t sav_key;
   sav_key.acct_id = acct_id;
-  auto sav_record = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kSavingsTable,
-                                                  smallbank_savings_val_t_size,
-                                                  sav_key.item_key,
-                                                  UserOP::kRead);
+  auto sav_record = txn->NewItem((table_id_t)SmallBankTableType::kSavingsTable,
+                                 smallbank_savings_val_t_size,
+                                 sav_key.item_key,
+                                 UserOP::kRead);
   txn->AddToReadOnlySet(sav_record);
 
   smallbank_checking_key_t chk_key;
   chk_key.acct_id = acct_id;
-  auto chk_record = std::make_shared<DataSetItem>((table_id_t)SmallBankTableType::kCheckingTable,
-                                                  smallbank_checking_val_t_size,
-                                                  chk_key.item_key,
-                                                  UserOP::kUpdate);
+  auto chk_record = txn->NewItem((table_id_t)SmallBankTableType::kCheckingTable,
+                                 smallbank_checking_val_t_size,
+                                 chk_key.item_key,
+                                 UserOP::kUpdate);
   txn->AddToReadWriteSet(chk_record);
 
   if (!txn->Execute(yield)) return false;
@@ -303,4 +303,17 @@ bool TxWriteCheck(SmallBank* smallbank_client,
   return commit_status;
 }
 
-/******************** The business logic (Transaction) end ********************/
\ No newline at end of file
+/******************** The business logic (Transaction) end ********************/
+
+void RegisterSmallBankProcedures(ProcRegistry* registry, SmallBank* smallbank_client) {
+  registry->AddWorkload("smallbank", smallbank_client);
+  auto reg = [registry](SmallBankTxType type, ProcHandler handler, int weight) {
+    registry->Register("smallbank", (proc_id_t)type, SmallBank_TX_NAME[(int)type], handler, weight);
+  };
+  reg(SmallBankTxType::kAmalgamate, SeededProc<SmallBank, TxAmalgamate>, FREQUENCY_AMALGAMATE);
+  reg(SmallBankTxType::kBalance, SeededProc<SmallBank, TxBalance>, FREQUENCY_BALANCE);
+  reg(SmallBankTxType::kDepositChecking, SeededProc<SmallBank, TxDepositChecking>, FREQUENCY_DEPOSIT_CHECKING);
+  reg(SmallBankTxType::kSendPayment, SeededProc<SmallBank, TxSendPayment>, FREQUENCY_SEND_PAYMENT);
+  reg(SmallBankTxType::kTransactSaving, SeededProc<SmallBank, TxTransactSaving>, FREQUENCY_TRANSACT_SAVINGS);
+  reg(SmallBankTxType::kWriteCheck, SeededProc<SmallBank, TxWriteCheck>, FREQUENCY_WRITE_CHECK);
+}
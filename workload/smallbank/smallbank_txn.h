@@ -5,6 +5,7 @@
 
 #include <memory>
 
+#include "process/procedure.h"
 #include "process/txn.h"
 #include "smallbank/smallbank_db.h"
 
@@ -50,4 +51,7 @@ bool TxWriteCheck(SmallBank* smallbank_client,
                   coro_yield_t& yield,
                   tx_id_t tx_id,
                   TXN* txn);
-/******************** The business logic (Transaction) end ********************/
\ No newline at end of file
+/******************** The business logic (Transaction) end ********************/
+
+// Register the procedures with their mix weights. The ids are the SmallBankTxType
+void RegisterSmallBankProcedures(ProcRegistry* registry, SmallBank* smallbank_client);
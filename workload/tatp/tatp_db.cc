@@ -9,6 +9,7 @@
 /* Only initialize here. The worker threads will populate. */
 void TATP::LoadTable(node_id_t node_id,
                      node_id_t num_server,
+                     const int* table_backup_num,
                      MemStoreAllocParam* mem_store_alloc_param,
                      size_t& total_size,
                      size_t& ht_loadfv_size,
@@ -122,9 +123,10 @@ void TATP::LoadTable(node_id_t node_id,
   std::cout << "----------------------------------------------------------" << std::endl;
   // Assign backup
 
-  if (BACKUP_NUM < num_server) {
-    for (node_id_t i = 1; i <= BACKUP_NUM; i++) {
-      if ((node_id_t)TATPTableType::kSubscriberTable % num_server == (node_id - i + num_server) % num_server) {
+  // The i-th backup is on the i-th MN after the primary. Co-located tables follow the first one
+  if (num_server > 1) {
+    for (node_id_t i = 1; i < num_server; i++) {
+      if ((node_id_t)TATPTableType::kSubscriberTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TATPTableType::kSubscriberTable]) {
         // Meaning: I (current node_id) am the backup-SubscriberTable of my primary. My primary-SubscriberTable
         // resides on a node, whose id is TATPTableType::kSubscriberTable % num_server
         // A possible layout: | P (My primary) | B1 (I'm here) | B2 (Or I'm here) |
@@ -133,19 +135,19 @@ void TATP::LoadTable(node_id_t node_id,
         backup_table_ptrs.push_back(subscriber_table);
       }
 
-      if ((node_id_t)TATPTableType::kSecSubscriberTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TATPTableType::kSecSubscriberTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TATPTableType::kSecSubscriberTable]) {
         RDMA_LOG(DBG) << "[Backup] SECONDARY SUBSCRIBER table ID: " << (node_id_t)TATPTableType::kSecSubscriberTable;
         std::cerr << "Number of initial records: " << std::dec << sec_subscriber_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(sec_subscriber_table);
       }
 
-      if ((node_id_t)TATPTableType::kAccessInfoTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TATPTableType::kAccessInfoTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TATPTableType::kAccessInfoTable]) {
         RDMA_LOG(DBG) << "[Backup] ACCESS INFO table ID: " << (node_id_t)TATPTableType::kAccessInfoTable;
         std::cerr << "Number of initial records: " << std::dec << access_info_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(access_info_table);
       }
 
-      if ((node_id_t)TATPTableType::kSpecialFacilityTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TATPTableType::kSpecialFacilityTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TATPTableType::kSpecialFacilityTable]) {
         RDMA_LOG(DBG) << "[Backup] SPECIAL FACILITY+CALL FORWARDING table IDs: " << (node_id_t)TATPTableType::kSpecialFacilityTable << " + " << (node_id_t)TATPTableType::kCallForwardingTable;
         std::cerr << "Number of initial records: " << std::dec << special_facility_table->GetInitInsertNum() << std::endl;
         std::cerr << "Number of initial records: " << std::dec << call_forwarding_table->GetInitInsertNum() << std::endl;
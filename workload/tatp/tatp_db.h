@@ -80,38 +80,6 @@ class TATP {
     if (call_forwarding_table) delete call_forwarding_table;
   }
 
-  /* create workload generation array for benchmarking */
-  ALWAYS_INLINE
-  TATPTxType* CreateWorkgenArray() {
-    TATPTxType* workgen_arr = new TATPTxType[100];
-
-    int i = 0, j = 0;
-
-    j += FREQUENCY_GET_SUBSCRIBER_DATA;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kGetSubsciberData;
-
-    j += FREQUENCY_GET_ACCESS_DATA;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kGetAccessData;
-
-    j += FREQUENCY_GET_NEW_DESTINATION;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kGetNewDestination;
-
-    j += FREQUENCY_UPDATE_SUBSCRIBER_DATA;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kUpdateSubscriberData;
-
-    j += FREQUENCY_UPDATE_LOCATION;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kUpdateLocation;
-
-    j += FREQUENCY_INSERT_CALL_FORWARDING;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kInsertCallForwarding;
-
-    j += FREQUENCY_DELETE_CALL_FORWARDING;
-    for (; i < j; i++) workgen_arr[i] = TATPTxType::kDeleteCallForwarding;
-
-    assert(i == 100 && j == 100);
-    return workgen_arr;
-  }
-
   /*
    * Get a non-uniform-random distributed subscriber ID according to spec.
    * To get a non-uniformly random number between 0 and y:
@@ -191,6 +159,7 @@ class TATP {
   // For server-side usage
   void LoadTable(node_id_t node_id,
                  node_id_t num_server,
+                 const int* table_backup_num,
                  MemStoreAllocParam* mem_store_alloc_param,
                  size_t& total_size,
                  size_t& ht_loadfv_size,
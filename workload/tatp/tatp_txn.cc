@@ -21,10 +21,10 @@ bool TxGetSubsciberData(TATP* tatp_client,
   sub_key.s_id = tatp_client->GetNonUniformRandomSubscriber(seed);
 
   // This empty data sub_record will be filled by RDMA reading from remote when running transaction
-  auto sub_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSubscriberTable,
-                                                  tatp_sub_val_t_size,
-                                                  sub_key.item_key,
-                                                  UserOP::kRead);
+  auto sub_record = txn->NewItem((table_id_t)TATPTableType::kSubscriberTable,
+                                 tatp_sub_val_t_size,
+                                 sub_key.item_key,
+                                 UserOP::kRead);
   txn->AddToReadOnlySet(sub_record);
 
   if (!txn->Execute(yield)) return false;
@@ -69,10 +69,10 @@ bool TxGetNewDestination(TATP* tatp_client,
   specfac_key.s_id = s_id;
   specfac_key.sf_type = sf_type;
 
-  auto specfac_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSpecialFacilityTable,
-                                                      tatp_specfac_val_t_size,
-                                                      specfac_key.item_key,
-                                                      UserOP::kRead);
+  auto specfac_record = txn->NewItem((table_id_t)TATPTableType::kSpecialFacilityTable,
+                                     tatp_specfac_val_t_size,
+                                     specfac_key.item_key,
+                                     UserOP::kRead);
   txn->AddToReadOnlySet(specfac_record);
 
   if (!txn->Execute(yield)) return false;
@@ -100,10 +100,10 @@ bool TxGetNewDestination(TATP* tatp_client,
     callfwd_key[i].s_id = s_id;
     callfwd_key[i].sf_type = sf_type;
     callfwd_key[i].start_time = (i * 8);
-    callfwd_record[i] = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kCallForwardingTable,
-                                                      tatp_callfwd_val_t_size,
-                                                      callfwd_key[i].item_key,
-                                                      UserOP::kRead);
+    callfwd_record[i] = txn->NewItem((table_id_t)TATPTableType::kCallForwardingTable,
+                                     tatp_callfwd_val_t_size,
+                                     callfwd_key[i].item_key,
+                                     UserOP::kRead);
     txn->AddToReadOnlySet(callfwd_record[i]);
   }
 
@@ -148,10 +148,10 @@ bool TxGetAccessData(TATP* tatp_client,
   key.s_id = tatp_client->GetNonUniformRandomSubscriber(seed);
   key.ai_type = (FastRand(seed) & 3) + 1;
 
-  auto acc_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kAccessInfoTable,
-                                                  tatp_accinf_val_t_size,
-                                                  key.item_key,
-                                                  UserOP::kRead);
+  auto acc_record = txn->NewItem((table_id_t)TATPTableType::kAccessInfoTable,
+                                 tatp_accinf_val_t_size,
+                                 key.item_key,
+                                 UserOP::kRead);
   txn->AddToReadOnlySet(acc_record);
 
   if (!txn->Execute(yield)) return false;
@@ -189,10 +189,10 @@ bool TxUpdateSubscriberData(TATP* tatp_client,
   tatp_sub_key_t sub_key;
   sub_key.s_id = s_id;
 
-  auto sub_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSubscriberTable,
-                                                  tatp_sub_val_t_size,
-                                                  sub_key.item_key,
-                                                  UserOP::kUpdate);
+  auto sub_record = txn->NewItem((table_id_t)TATPTableType::kSubscriberTable,
+                                 tatp_sub_val_t_size,
+                                 sub_key.item_key,
+                                 UserOP::kUpdate);
   txn->AddToReadWriteSet(sub_record);
 
   /* Read + lock the special facilty record */
@@ -200,10 +200,10 @@ bool TxUpdateSubscriberData(TATP* tatp_client,
   specfac_key.s_id = s_id;
   specfac_key.sf_type = sf_type;
 
-  auto specfac_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSpecialFacilityTable,
-                                                      tatp_specfac_val_t_size,
-                                                      specfac_key.item_key,
-                                                      UserOP::kUpdate);
+  auto specfac_record = txn->NewItem((table_id_t)TATPTableType::kSpecialFacilityTable,
+                                     tatp_specfac_val_t_size,
+                                     specfac_key.item_key,
+                                     UserOP::kUpdate);
   txn->AddToReadWriteSet(specfac_record);
 
   if (!txn->Execute(yield)) return false;
@@ -246,10 +246,10 @@ bool TxUpdateLocation(TATP* tatp_client,
   tatp_sec_sub_key_t sec_sub_key;
   sec_sub_key.sub_number = tatp_client->FastGetSubscribeNumFromSubscribeID(s_id);
 
-  auto sec_sub_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSecSubscriberTable,
-                                                      tatp_sec_sub_val_t_size,
-                                                      sec_sub_key.item_key,
-                                                      UserOP::kRead);
+  auto sec_sub_record = txn->NewItem((table_id_t)TATPTableType::kSecSubscriberTable,
+                                     tatp_sec_sub_val_t_size,
+                                     sec_sub_key.item_key,
+                                     UserOP::kRead);
   txn->AddToReadOnlySet(sec_sub_record);
 
   if (!txn->Execute(yield)) return false;
@@ -267,10 +267,10 @@ bool TxUpdateLocation(TATP* tatp_client,
   tatp_sub_key_t sub_key;
   sub_key.s_id = sec_sub_val->s_id;
 
-  auto sub_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSubscriberTable,
-                                                  tatp_sub_val_t_size,
-                                                  sub_key.item_key,
-                                                  UserOP::kUpdate);
+  auto sub_record = txn->NewItem((table_id_t)TATPTableType::kSubscriberTable,
+                                 tatp_sub_val_t_size,
+                                 sub_key.item_key,
+                                 UserOP::kUpdate);
   txn->AddToReadWriteSet(sub_record);
 
   if (!txn->Execute(yield)) return false;
@@ -309,10 +309,10 @@ bool TxInsertCallForwarding(TATP* tatp_client,
   tatp_sec_sub_key_t sec_sub_key;
   sec_sub_key.sub_number = tatp_client->FastGetSubscribeNumFromSubscribeID(s_id);
 
-  auto sec_sub_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSecSubscriberTable,
-                                                      tatp_sec_sub_val_t_size,
-                                                      sec_sub_key.item_key,
-                                                      UserOP::kRead);
+  auto sec_sub_record = txn->NewItem((table_id_t)TATPTableType::kSecSubscriberTable,
+                                     tatp_sec_sub_val_t_size,
+                                     sec_sub_key.item_key,
+                                     UserOP::kRead);
   txn->AddToReadOnlySet(sec_sub_record);
 
   if (!txn->Execute(yield)) return false;
@@ -332,10 +332,10 @@ bool TxInsertCallForwarding(TATP* tatp_client,
   specfac_key.s_id = s_id;
   specfac_key.sf_type = sf_type;
 
-  auto specfac_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSpecialFacilityTable,
-                                                      tatp_specfac_val_t_size,
-                                                      specfac_key.item_key,
-                                                      UserOP::kRead);
+  auto specfac_record = txn->NewItem((table_id_t)TATPTableType::kSpecialFacilityTable,
+                                     tatp_specfac_val_t_size,
+                                     specfac_key.item_key,
+                                     UserOP::kRead);
   txn->AddToReadOnlySet(specfac_record);
 
   if (!txn->Execute(yield)) return false;
@@ -358,10 +358,10 @@ bool TxInsertCallForwarding(TATP* tatp_client,
   callfwd_key.sf_type = sf_type;
   callfwd_key.start_time = start_time;
 
-  auto callfwd_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kCallForwardingTable,
-                                                      tatp_callfwd_val_t_size,  // Here Insert
-                                                      callfwd_key.item_key,
-                                                      UserOP::kInsert);
+  auto callfwd_record = txn->NewItem((table_id_t)TATPTableType::kCallForwardingTable,
+                                     tatp_callfwd_val_t_size,  // Here Insert
+                                     callfwd_key.item_key,
+                                     UserOP::kInsert);
   // Handle Insert. Only read the remote offset of callfwd_record
   txn->AddToReadWriteSet(callfwd_record);
 
@@ -397,10 +397,10 @@ bool TxDeleteCallForwarding(TATP* tatp_client,
   // Read the secondary subscriber record
   tatp_sec_sub_key_t sec_sub_key;
   sec_sub_key.sub_number = tatp_client->FastGetSubscribeNumFromSubscribeID(s_id);
-  auto sec_sub_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kSecSubscriberTable,
-                                                      tatp_sec_sub_val_t_size,
-                                                      sec_sub_key.item_key,
-                                                      UserOP::kRead);
+  auto sec_sub_record = txn->NewItem((table_id_t)TATPTableType::kSecSubscriberTable,
+                                     tatp_sec_sub_val_t_size,
+                                     sec_sub_key.item_key,
+                                     UserOP::kRead);
   txn->AddToReadOnlySet(sec_sub_record);
 
   if (!txn->Execute(yield)) {
@@ -424,10 +424,10 @@ bool TxDeleteCallForwarding(TATP* tatp_client,
   callfwd_key.sf_type = sf_type;
   callfwd_key.start_time = start_time;
 
-  auto callfwd_record = std::make_shared<DataSetItem>((table_id_t)TATPTableType::kCallForwardingTable,
-                                                      tatp_callfwd_val_t_size,
-                                                      callfwd_key.item_key,
-                                                      UserOP::kDelete);
+  auto callfwd_record = txn->NewItem((table_id_t)TATPTableType::kCallForwardingTable,
+                                     tatp_callfwd_val_t_size,
+                                     callfwd_key.item_key,
+                                     UserOP::kDelete);
   txn->AddToReadWriteSet(callfwd_record);
 
   if (!txn->Execute(yield)) return false;
@@ -437,3 +437,17 @@ bool TxDeleteCallForwarding(TATP* tatp_client,
 }
 
 /******************** The business logic (Transaction) end ********************/
+
+void RegisterTATPProcedures(ProcRegistry* registry, TATP* tatp_client) {
+  registry->AddWorkload("tatp", tatp_client);
+  auto reg = [registry](TATPTxType type, ProcHandler handler, int weight) {
+    registry->Register("tatp", (proc_id_t)type, TATP_TX_NAME[(int)type], handler, weight);
+  };
+  reg(TATPTxType::kGetSubsciberData, SeededProc<TATP, TxGetSubsciberData>, FREQUENCY_GET_SUBSCRIBER_DATA);
+  reg(TATPTxType::kGetAccessData, SeededProc<TATP, TxGetAccessData>, FREQUENCY_GET_ACCESS_DATA);
+  reg(TATPTxType::kGetNewDestination, SeededProc<TATP, TxGetNewDestination>, FREQUENCY_GET_NEW_DESTINATION);
+  reg(TATPTxType::kUpdateSubscriberData, SeededProc<TATP, TxUpdateSubscriberData>, FREQUENCY_UPDATE_SUBSCRIBER_DATA);
+  reg(TATPTxType::kUpdateLocation, SeededProc<TATP, TxUpdateLocation>, FREQUENCY_UPDATE_LOCATION);
+  reg(TATPTxType::kInsertCallForwarding, SeededProc<TATP, TxInsertCallForwarding>, FREQUENCY_INSERT_CALL_FORWARDING);
+  reg(TATPTxType::kDeleteCallForwarding, SeededProc<TATP, TxDeleteCallForwarding>, FREQUENCY_DELETE_CALL_FORWARDING);
+}
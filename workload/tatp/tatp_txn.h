@@ -5,6 +5,7 @@
 
 #include <memory>
 
+#include "process/procedure.h"
 #include "process/txn.h"
 #include "tatp/tatp_db.h"
 
@@ -65,4 +66,7 @@ bool TxDeleteCallForwarding(TATP* tatp_client,
                             tx_id_t tx_id,
                             TXN* txn);
 
-/******************** The business logic (Transaction) end ********************/
\ No newline at end of file
+/******************** The business logic (Transaction) end ********************/
+
+// Register the procedures with their mix weights. The ids are the TATPTxType
+void RegisterTATPProcedures(ProcRegistry* registry, TATP* tatp_client);
@@ -8,6 +8,7 @@
 
 void TPCC::LoadTable(node_id_t node_id,
                      node_id_t num_server,
+                     const int* table_backup_num,
                      MemStoreAllocParam* mem_store_alloc_param,
                      size_t& total_size,
                      size_t& ht_loadfv_size,
@@ -261,21 +262,22 @@ void TPCC::LoadTable(node_id_t node_id,
 
   std::cout << "----------------------------------------------------------" << std::endl;
   // Assign backup
-  if (BACKUP_NUM < num_server) {
-    for (node_id_t i = 1; i <= BACKUP_NUM; i++) {
-      if ((node_id_t)TPCCTableType::kWarehouseTable % num_server == (node_id - i + num_server) % num_server) {
+  // The i-th backup is on the i-th MN after the primary. Co-located tables follow the first one
+  if (num_server > 1) {
+    for (node_id_t i = 1; i < num_server; i++) {
+      if ((node_id_t)TPCCTableType::kWarehouseTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TPCCTableType::kWarehouseTable]) {
         RDMA_LOG(DBG) << "[Backup] Warehouse table ID: " << (node_id_t)TPCCTableType::kWarehouseTable;
         std::cerr << "Number of initial records: " << std::dec << warehouse_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(warehouse_table);
       }
 
-      if ((node_id_t)TPCCTableType::kDistrictTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TPCCTableType::kDistrictTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TPCCTableType::kDistrictTable]) {
         RDMA_LOG(DBG) << "[Backup] District table ID: " << (node_id_t)TPCCTableType::kDistrictTable;
         std::cerr << "Number of initial records: " << std::dec << district_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(district_table);
       }
 
-      if ((node_id_t)TPCCTableType::kCustomerTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TPCCTableType::kCustomerTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TPCCTableType::kCustomerTable]) {
         RDMA_LOG(DBG) << "[Backup] Customer+CustomerIndex+History table IDs: " << (node_id_t)TPCCTableType::kCustomerTable
                       << " + " << (node_id_t)TPCCTableType::kCustomerIndexTable
                       << " + " << (node_id_t)TPCCTableType::kHistoryTable;
@@ -289,7 +291,7 @@ void TPCC::LoadTable(node_id_t node_id,
         backup_table_ptrs.push_back(history_table);
       }
 
-      if ((node_id_t)TPCCTableType::kOrderTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TPCCTableType::kOrderTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TPCCTableType::kOrderTable]) {
         RDMA_LOG(DBG) << "[Backup] Order+OrderIndex+NewOrder+OrderLine table IDs: " << (node_id_t)TPCCTableType::kOrderTable
                       << " + " << (node_id_t)TPCCTableType::kOrderIndexTable
                       << " + " << (node_id_t)TPCCTableType::kNewOrderTable
@@ -306,13 +308,13 @@ void TPCC::LoadTable(node_id_t node_id,
         backup_table_ptrs.push_back(order_line_table);
       }
 
-      if ((node_id_t)TPCCTableType::kStockTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TPCCTableType::kStockTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TPCCTableType::kStockTable]) {
         RDMA_LOG(DBG) << "[Backup] Stock table ID: " << (node_id_t)TPCCTableType::kStockTable;
         std::cerr << "Number of initial records: " << std::dec << stock_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(stock_table);
       }
 
-      if ((node_id_t)TPCCTableType::kItemTable % num_server == (node_id - i + num_server) % num_server) {
+      if ((node_id_t)TPCCTableType::kItemTable % num_server == (node_id - i + num_server) % num_server && i <= table_backup_num[(int)TPCCTableType::kItemTable]) {
         RDMA_LOG(DBG) << "[Backup] Item table ID: " << (node_id_t)TPCCTableType::kItemTable;
         std::cerr << "Number of initial records: " << std::dec << item_table->GetInitInsertNum() << std::endl;
         backup_table_ptrs.push_back(item_table);
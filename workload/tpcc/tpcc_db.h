@@ -79,35 +79,10 @@ class TPCC {
     delete stock_table;
   }
 
-  /* create workload generation array for benchmarking */
-  ALWAYS_INLINE
-  TPCCTxType* CreateWorkgenArray() {
-    TPCCTxType* workgen_arr = new TPCCTxType[100];
-
-    int i = 0, j = 0;
-
-    j += FREQUENCY_NEW_ORDER;
-    for (; i < j; i++) workgen_arr[i] = TPCCTxType::kNewOrder;
-
-    j += FREQUENCY_PAYMENT;
-    for (; i < j; i++) workgen_arr[i] = TPCCTxType::kPayment;
-
-    j += FREQUENCY_ORDER_STATUS;
-    for (; i < j; i++) workgen_arr[i] = TPCCTxType::kOrderStatus;
-
-    j += FREQUENCY_DELIVERY;
-    for (; i < j; i++) workgen_arr[i] = TPCCTxType::kDelivery;
-
-    j += FREQUENCY_STOCK_LEVEL;
-    for (; i < j; i++) workgen_arr[i] = TPCCTxType::kStockLevel;
-
-    assert(i == 100 && j == 100);
-    return workgen_arr;
-  }
-
   // For server-side usage
   void LoadTable(node_id_t node_id,
                  node_id_t num_server,
+                 const int* table_backup_num,
                  MemStoreAllocParam* mem_store_alloc_param,
                  size_t& total_size,
                  size_t& ht_loadfv_size,
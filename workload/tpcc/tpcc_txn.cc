@@ -108,28 +108,28 @@ bool TxNewOrder(TPCC* tpcc_client,
 
   tpcc_warehouse_key_t ware_key;
   ware_key.w_id = warehouse_id;
-  auto ware_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kWarehouseTable,
-                                                   tpcc_warehouse_val_t_size,
-                                                   ware_key.item_key,
-                                                   UserOP::kRead);
+  auto ware_record = txn->NewItem((table_id_t)TPCCTableType::kWarehouseTable,
+                                  tpcc_warehouse_val_t_size,
+                                  ware_key.item_key,
+                                  UserOP::kRead);
   txn->AddToReadOnlySet(ware_record);
 
   tpcc_customer_key_t cust_key;
   cust_key.c_id = c_key;
-  auto cust_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kCustomerTable,
-                                                   tpcc_customer_val_t_size,
-                                                   cust_key.item_key,
-                                                   UserOP::kRead);
+  auto cust_record = txn->NewItem((table_id_t)TPCCTableType::kCustomerTable,
+                                  tpcc_customer_val_t_size,
+                                  cust_key.item_key,
+                                  UserOP::kRead);
   txn->AddToReadOnlySet(cust_record);
 
   // read and update district value
   uint64_t d_key = tpcc_client->MakeDistrictKey(warehouse_id, district_id);
   tpcc_district_key_t dist_key;
   dist_key.d_id = d_key;
-  auto dist_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kDistrictTable,
-                                                   tpcc_district_val_t_size,
-                                                   dist_key.item_key,
-                                                   UserOP::kUpdate);
+  auto dist_record = txn->NewItem((table_id_t)TPCCTableType::kDistrictTable,
+                                  tpcc_district_val_t_size,
+                                  dist_key.item_key,
+                                  UserOP::kUpdate);
   txn->AddToReadWriteSet(dist_record);
 
   if (!txn->Execute(yield)) return false;
@@ -161,30 +161,30 @@ bool TxNewOrder(TPCC* tpcc_client,
   uint64_t no_key = tpcc_client->MakeNewOrderKey(warehouse_id, district_id, my_next_o_id);
   tpcc_new_order_key_t norder_key;
   norder_key.no_id = no_key;
-  auto norder_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kNewOrderTable,
-                                                     tpcc_new_order_val_t_size,  // Insert
-                                                     norder_key.item_key,
-                                                     UserOP::kInsert);
+  auto norder_record = txn->NewItem((table_id_t)TPCCTableType::kNewOrderTable,
+                                    tpcc_new_order_val_t_size,  // Insert
+                                    norder_key.item_key,
+                                    UserOP::kInsert);
   txn->AddToReadWriteSet(norder_record);
 
   // insert order record
   uint64_t o_key = tpcc_client->MakeOrderKey(warehouse_id, district_id, my_next_o_id);
   tpcc_order_key_t order_key;
   order_key.o_id = o_key;
-  auto order_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderTable,
-                                                    tpcc_order_val_t_size,  // Insert
-                                                    order_key.item_key,
-                                                    UserOP::kInsert);
+  auto order_record = txn->NewItem((table_id_t)TPCCTableType::kOrderTable,
+                                   tpcc_order_val_t_size,  // Insert
+                                   order_key.item_key,
+                                   UserOP::kInsert);
   txn->AddToReadWriteSet(order_record);
 
   // insert order index record
   uint64_t o_index_key = tpcc_client->MakeOrderIndexKey(warehouse_id, district_id, customer_id, my_next_o_id);
   tpcc_order_index_key_t order_index_key;
   order_index_key.o_index_id = o_index_key;
-  auto oidx_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderIndexTable,
-                                                   tpcc_order_index_val_t_size,  // Insert
-                                                   order_index_key.item_key,
-                                                   UserOP::kInsert);
+  auto oidx_record = txn->NewItem((table_id_t)TPCCTableType::kOrderIndexTable,
+                                  tpcc_order_index_val_t_size,  // Insert
+                                  order_index_key.item_key,
+                                  UserOP::kInsert);
   txn->AddToReadWriteSet(oidx_record);
 
   if (!txn->Execute(yield)) return false;
@@ -226,10 +226,10 @@ bool TxNewOrder(TPCC* tpcc_client,
     tpcc_item_key_t tpcc_item_key;
     tpcc_item_key.i_id = ol_i_id;
 
-    auto item_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kItemTable,
-                                                     tpcc_item_val_t_size,
-                                                     tpcc_item_key.item_key,
-                                                     UserOP::kRead);
+    auto item_record = txn->NewItem((table_id_t)TPCCTableType::kItemTable,
+                                    tpcc_item_val_t_size,
+                                    tpcc_item_key.item_key,
+                                    UserOP::kRead);
     txn->AddToReadOnlySet(item_record);
 
     int64_t s_key = local_stocks[ol_number - 1];
@@ -237,10 +237,10 @@ bool TxNewOrder(TPCC* tpcc_client,
     tpcc_stock_key_t stock_key;
     stock_key.s_id = s_key;
 
-    auto stock_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kStockTable,
-                                                      tpcc_stock_val_t_size,
-                                                      stock_key.item_key,
-                                                      UserOP::kUpdate);
+    auto stock_record = txn->NewItem((table_id_t)TPCCTableType::kStockTable,
+                                     tpcc_stock_val_t_size,
+                                     stock_key.item_key,
+                                     UserOP::kUpdate);
     txn->AddToReadWriteSet(stock_record);
 
     if (!txn->Execute(yield)) {
@@ -276,10 +276,10 @@ bool TxNewOrder(TPCC* tpcc_client,
     tpcc_order_line_key_t order_line_key;
     order_line_key.ol_id = ol_key;
     // RDMA_LOG(DBG) << warehouse_id << " " << district_id << " " << my_next_o_id << " " <<  ol_number << ". ol_key: " << ol_key;
-    auto ol_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderLineTable,
-                                                   sizeof(tpcc_order_line_val_t),  // Insert
-                                                   order_line_key.item_key,
-                                                   UserOP::kInsert);
+    auto ol_record = txn->NewItem((table_id_t)TPCCTableType::kOrderLineTable,
+                                  sizeof(tpcc_order_line_val_t),  // Insert
+                                  order_line_key.item_key,
+                                  UserOP::kInsert);
     txn->AddToReadWriteSet(ol_record);
 
     if (!txn->Execute(yield)) {
@@ -310,10 +310,10 @@ bool TxNewOrder(TPCC* tpcc_client,
     tpcc_item_key_t tpcc_item_key;
     tpcc_item_key.i_id = ol_i_id;
 
-    auto item_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kItemTable,
-                                                     tpcc_item_val_t_size,
-                                                     tpcc_item_key.item_key,
-                                                     UserOP::kRead);
+    auto item_record = txn->NewItem((table_id_t)TPCCTableType::kItemTable,
+                                    tpcc_item_val_t_size,
+                                    tpcc_item_key.item_key,
+                                    UserOP::kRead);
 
     txn->AddToReadOnlySet(item_record);
 
@@ -322,10 +322,10 @@ bool TxNewOrder(TPCC* tpcc_client,
     tpcc_stock_key_t stock_key;
     stock_key.s_id = s_key;
 
-    auto stock_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kStockTable,
-                                                      tpcc_stock_val_t_size,
-                                                      stock_key.item_key,
-                                                      UserOP::kUpdate);
+    auto stock_record = txn->NewItem((table_id_t)TPCCTableType::kStockTable,
+                                     tpcc_stock_val_t_size,
+                                     stock_key.item_key,
+                                     UserOP::kUpdate);
     txn->AddToReadWriteSet(stock_record);
 
     if (!txn->Execute(yield)) return false;
@@ -359,10 +359,10 @@ bool TxNewOrder(TPCC* tpcc_client,
     tpcc_order_line_key_t order_line_key;
     order_line_key.ol_id = ol_key;
     // RDMA_LOG(DBG) << warehouse_id << " " << district_id << " " << my_next_o_id << " " <<  num_local_stocks + ol_number << ". ol_key: " << ol_key;
-    auto ol_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderLineTable,
-                                                   sizeof(tpcc_order_line_val_t),  // Insert
-                                                   order_line_key.item_key,
-                                                   UserOP::kInsert);
+    auto ol_record = txn->NewItem((table_id_t)TPCCTableType::kOrderLineTable,
+                                  sizeof(tpcc_order_line_val_t),  // Insert
+                                  order_line_key.item_key,
+                                  UserOP::kInsert);
     txn->AddToReadWriteSet(ol_record);
 
     if (!txn->Execute(yield)) return false;
@@ -460,35 +460,35 @@ bool TxPayment(TPCC* tpcc_client,
 
   tpcc_warehouse_key_t ware_key;
   ware_key.w_id = warehouse_id;
-  auto ware_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kWarehouseTable,
-                                                   tpcc_warehouse_val_t_size,
-                                                   ware_key.item_key,
-                                                   UserOP::kUpdate);
+  auto ware_record = txn->NewItem((table_id_t)TPCCTableType::kWarehouseTable,
+                                  tpcc_warehouse_val_t_size,
+                                  ware_key.item_key,
+                                  UserOP::kUpdate);
   txn->AddToReadWriteSet(ware_record);
 
   uint64_t d_key = tpcc_client->MakeDistrictKey(warehouse_id, district_id);
   tpcc_district_key_t dist_key;
   dist_key.d_id = d_key;
-  auto dist_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kDistrictTable,
-                                                   tpcc_district_val_t_size,
-                                                   dist_key.item_key,
-                                                   UserOP::kUpdate);
+  auto dist_record = txn->NewItem((table_id_t)TPCCTableType::kDistrictTable,
+                                  tpcc_district_val_t_size,
+                                  dist_key.item_key,
+                                  UserOP::kUpdate);
   txn->AddToReadWriteSet(dist_record);
 
   tpcc_customer_key_t cust_key;
   cust_key.c_id = tpcc_client->MakeCustomerKey(c_w_id, c_d_id, customer_id);
-  auto cust_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kCustomerTable,
-                                                   tpcc_customer_val_t_size,
-                                                   cust_key.item_key,
-                                                   UserOP::kUpdate);
+  auto cust_record = txn->NewItem((table_id_t)TPCCTableType::kCustomerTable,
+                                  tpcc_customer_val_t_size,
+                                  cust_key.item_key,
+                                  UserOP::kUpdate);
   txn->AddToReadWriteSet(cust_record);
 
   tpcc_history_key_t hist_key;
   hist_key.h_id = tpcc_client->MakeHistoryKey(warehouse_id, district_id, c_w_id, c_d_id, customer_id);
-  auto hist_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kHistoryTable,
-                                                   tpcc_history_val_t_size,  // Insert
-                                                   hist_key.item_key,
-                                                   UserOP::kInsert);
+  auto hist_record = txn->NewItem((table_id_t)TPCCTableType::kHistoryTable,
+                                  tpcc_history_val_t_size,  // Insert
+                                  hist_key.item_key,
+                                  UserOP::kInsert);
   txn->AddToReadWriteSet(hist_record);
 
   if (!txn->Execute(yield)) return false;
@@ -591,6 +591,10 @@ bool TxDelivery(TPCC* tpcc_client,
   const int o_carrier_id = tpcc_client->RandomNumber(random_generator[txn->coro_id], tpcc_order_val_t::MIN_CARRIER_ID, tpcc_order_val_t::MAX_CARRIER_ID);
   const uint32_t current_ts = tpcc_client->GetCurrentTimeMillis();
 
+  // Probe the new order records of all districts in one batch
+  std::vector<int> o_ids;
+  std::vector<DataSetItemPtr> norder_records_try_read;
+
   for (int d_id = 1; d_id <= tpcc_client->num_district_per_warehouse; d_id++) {
     // FIXME: select the lowest NO_O_ID with matching NO_W_ID (equals W_ID) and NO_D_ID (equals D_ID) in the NEW-ORDER table
     int min_o_id = tpcc_client->num_customer_per_district * tpcc_new_order_val_t::SCALE_CONSTANT_BETWEEN_NEWORDER_ORDER + 1;
@@ -600,39 +604,55 @@ bool TxDelivery(TPCC* tpcc_client,
     int64_t no_key = tpcc_client->MakeNewOrderKey(warehouse_id, d_id, o_id);
     tpcc_new_order_key_t norder_key;
     norder_key.no_id = no_key;
-    auto norder_record_try_read = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kNewOrderTable,
-                                                                tpcc_new_order_val_t_size,
-                                                                norder_key.item_key,
-                                                                UserOP::kRead);
-    txn->AddToReadOnlySet(norder_record_try_read);
-
-    // Get the new order record with the o_id. Probe if the new order record exists
-    if (!txn->Execute(yield, false)) {
-      txn->RemoveLastROItem();
+    auto norder_record_try_read = txn->NewItem((table_id_t)TPCCTableType::kNewOrderTable,
+                                               tpcc_new_order_val_t_size,
+                                               norder_key.item_key,
+                                               UserOP::kRead);
+    o_ids.push_back(o_id);
+    norder_records_try_read.emplace_back(norder_record_try_read);
+  }
+
+  if (!txn->ExecuteBatch(yield, norder_records_try_read)) return false;
+
+  for (int d_id = 1; d_id <= tpcc_client->num_district_per_warehouse; d_id++) {
+    // The new order record does not exist
+    if (norder_records_try_read[d_id - 1]->IsNotFound()) {
       continue;
     }
 
-    // The new order record exists. Remove the new order record from read only set
-    txn->RemoveLastROItem();
+    int o_id = o_ids[d_id - 1];
 
     // Add the new order record to read write set to be deleted
-    auto norder_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kNewOrderTable,
-                                                       tpcc_new_order_val_t_size,
-                                                       norder_key.item_key,
-                                                       UserOP::kDelete);
+    auto norder_record = txn->NewItem((table_id_t)TPCCTableType::kNewOrderTable,
+                                      tpcc_new_order_val_t_size,
+                                      norder_records_try_read[d_id - 1]->header.key,
+                                      UserOP::kDelete);
     txn->AddToReadWriteSet(norder_record);
 
     uint64_t o_key = tpcc_client->MakeOrderKey(warehouse_id, d_id, o_id);
     tpcc_order_key_t order_key;
     order_key.o_id = o_key;
-    auto order_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderTable,
-                                                      tpcc_order_val_t_size,
-                                                      order_key.item_key,
-                                                      UserOP::kUpdate);
+    auto order_record = txn->NewItem((table_id_t)TPCCTableType::kOrderTable,
+                                     tpcc_order_val_t_size,
+                                     order_key.item_key,
+                                     UserOP::kUpdate);
     txn->AddToReadWriteSet(order_record);
 
-    // The row in the ORDER table with matching O_W_ID (equals W_ ID), O_D_ID (equals D_ID), and O_ID (equals NO_O_ID) is selected
-    if (!txn->Execute(yield)) return false;
+    // Probe the order lines together with the order
+    std::vector<DataSetItemPtr> ol_records_try_read;
+    for (int line_number = 1; line_number <= tpcc_order_line_val_t::MAX_OL_CNT; ++line_number) {
+      int64_t ol_key = tpcc_client->MakeOrderLineKey(warehouse_id, d_id, o_id, line_number);
+      tpcc_order_line_key_t order_line_key;
+      order_line_key.ol_id = ol_key;
+      auto ol_record_try_read = txn->NewItem((table_id_t)TPCCTableType::kOrderLineTable,
+                                             tpcc_order_line_val_t_size,
+                                             order_line_key.item_key,
+                                             UserOP::kRead);
+      ol_records_try_read.emplace_back(ol_record_try_read);
+    }
+
+    // The row in the ORDER table with matching O_W_ID (equals W_ID), O_D_ID (equals D_ID), and O_ID (equals NO_O_ID) is selected
+    if (!txn->ExecuteBatch(yield, ol_records_try_read)) return false;
 
     auto* no_val = (tpcc_new_order_val_t*)norder_record->Value();
     if (!norder_record->is_delete_no_read_value) {
@@ -657,35 +677,34 @@ bool TxDelivery(TPCC* tpcc_client,
     // All rows in the ORDER-LINE table with matching OL_W_ID (equals O_W_ID), OL_D_ID (equals O_D_ID), and OL_O_ID (equals O_ID) are selected.
     // All OL_DELIVERY_D, the delivery dates, are updated to the current system time
     // The sum of all OL_AMOUNT is retrieved
-
-    float sum_ol_amount = 0;
-
-    for (int line_number = 1; line_number <= tpcc_order_line_val_t::MAX_OL_CNT; ++line_number) {
-      int64_t ol_key = tpcc_client->MakeOrderLineKey(warehouse_id, d_id, o_id, line_number);
-      tpcc_order_line_key_t order_line_key;
-      order_line_key.ol_id = ol_key;
-      auto ol_record_try_read = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderLineTable,
-                                                              tpcc_order_line_val_t_size,
-                                                              order_line_key.item_key,
-                                                              UserOP::kRead);
-      txn->AddToReadOnlySet(ol_record_try_read);
-
-      if (!txn->Execute(yield, false)) {
-        // Fail not abort
-        txn->RemoveLastROItem();
+    std::vector<DataSetItemPtr> ol_records;
+    for (auto& ol_record_try_read : ol_records_try_read) {
+      if (ol_record_try_read->IsNotFound()) {
         continue;
       }
 
-      txn->RemoveLastROItem();  // remove the successfully try read
-
-      auto ol_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderLineTable,
-                                                     tpcc_order_line_val_t_size,
-                                                     order_line_key.item_key,
-                                                     UserOP::kUpdate);
+      auto ol_record = txn->NewItem((table_id_t)TPCCTableType::kOrderLineTable,
+                                    tpcc_order_line_val_t_size,
+                                    ol_record_try_read->header.key,
+                                    UserOP::kUpdate);
       txn->AddToReadWriteSet(ol_record);
+      ol_records.emplace_back(ol_record);
+    }
+
+    // The row in the CUSTOMER table with matching C_W_ID (equals W_ID), C_D_ID (equals D_ID), and C_ID (equals O_C_ID) is selected
+    tpcc_customer_key_t cust_key;
+    cust_key.c_id = tpcc_client->MakeCustomerKey(warehouse_id, d_id, customer_id);
+    auto cust_record = txn->NewItem((table_id_t)TPCCTableType::kCustomerTable,
+                                    tpcc_customer_val_t_size,
+                                    cust_key.item_key,
+                                    UserOP::kUpdate);
+    txn->AddToReadWriteSet(cust_record);
+
+    if (!txn->Execute(yield)) return false;
 
-      if (!txn->Execute(yield)) return false;
+    float sum_ol_amount = 0;
 
+    for (auto& ol_record : ol_records) {
       tpcc_order_line_val_t* order_line_val = (tpcc_order_line_val_t*)ol_record->Value();
       if (order_line_val->debug_magic != tpcc_add_magic) {
         RDMA_LOG(FATAL) << "[FATAL] Read order line unmatch, tid-cid-txid: " << txn->t_id << "-" << txn->coro_id << "-" << tx_id;
@@ -697,17 +716,6 @@ bool TxDelivery(TPCC* tpcc_client,
       sum_ol_amount += order_line_val->ol_amount;
     }
 
-    // The row in the CUSTOMER table with matching C_W_ID (equals W_ID), C_D_ID (equals D_ID), and C_ID (equals O_C_ID) is selected
-    tpcc_customer_key_t cust_key;
-    cust_key.c_id = tpcc_client->MakeCustomerKey(warehouse_id, d_id, customer_id);
-    auto cust_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kCustomerTable,
-                                                     tpcc_customer_val_t_size,
-                                                     cust_key.item_key,
-                                                     UserOP::kUpdate);
-    txn->AddToReadWriteSet(cust_record);
-
-    if (!txn->Execute(yield)) return false;
-
     tpcc_customer_val_t* cust_val = (tpcc_customer_val_t*)cust_record->Value();
     // c_since never be 0
     if (cust_val->c_since == 0) {
@@ -764,10 +772,10 @@ bool TxOrderStatus(TPCC* tpcc_client,
 
   tpcc_customer_key_t cust_key;
   cust_key.c_id = tpcc_client->MakeCustomerKey(warehouse_id, district_id, customer_id);
-  auto cust_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kCustomerTable,
-                                                   tpcc_customer_val_t_size,
-                                                   cust_key.item_key,
-                                                   UserOP::kRead);
+  auto cust_record = txn->NewItem((table_id_t)TPCCTableType::kCustomerTable,
+                                  tpcc_customer_val_t_size,
+                                  cust_key.item_key,
+                                  UserOP::kRead);
   txn->AddToReadOnlySet(cust_record);
 
   // FIXME: Currently, we use a random order_id to maintain the distributed transaction payload,
@@ -776,10 +784,10 @@ bool TxOrderStatus(TPCC* tpcc_client,
   uint64_t o_key = tpcc_client->MakeOrderKey(warehouse_id, district_id, order_id);
   tpcc_order_key_t order_key;
   order_key.o_id = o_key;
-  auto order_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderTable,
-                                                    tpcc_order_val_t_size,
-                                                    order_key.item_key,
-                                                    UserOP::kRead);
+  auto order_record = txn->NewItem((table_id_t)TPCCTableType::kOrderTable,
+                                   tpcc_order_val_t_size,
+                                   order_key.item_key,
+                                   UserOP::kRead);
   txn->AddToReadOnlySet(order_record);
 
   if (!txn->Execute(yield)) return false;
@@ -800,10 +808,10 @@ bool TxOrderStatus(TPCC* tpcc_client,
     int64_t ol_key = tpcc_client->MakeOrderLineKey(warehouse_id, district_id, order_id, i);
     tpcc_order_line_key_t order_line_key;
     order_line_key.ol_id = ol_key;
-    auto ol_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderLineTable,
-                                                   tpcc_order_line_val_t_size,
-                                                   order_line_key.item_key,
-                                                   UserOP::kRead);
+    auto ol_record = txn->NewItem((table_id_t)TPCCTableType::kOrderLineTable,
+                                  tpcc_order_line_val_t_size,
+                                  order_line_key.item_key,
+                                  UserOP::kRead);
     txn->AddToReadOnlySet(ol_record);
   }
 
@@ -839,10 +847,10 @@ bool TxStockLevel(TPCC* tpcc_client,
   uint64_t d_key = tpcc_client->MakeDistrictKey(warehouse_id, district_id);
   tpcc_district_key_t dist_key;
   dist_key.d_id = d_key;
-  auto dist_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kDistrictTable,
-                                                   tpcc_district_val_t_size,
-                                                   dist_key.item_key,
-                                                   UserOP::kRead);
+  auto dist_record = txn->NewItem((table_id_t)TPCCTableType::kDistrictTable,
+                                  tpcc_district_val_t_size,
+                                  dist_key.item_key,
+                                  UserOP::kRead);
   txn->AddToReadOnlySet(dist_record);
 
   if (!txn->Execute(yield)) return false;
@@ -855,52 +863,73 @@ bool TxStockLevel(TPCC* tpcc_client,
 
   int32_t o_id = dist_val->d_next_o_id;
 
-  std::vector<int32_t> s_i_ids;
-  s_i_ids.reserve(300);
+  // Read all the order lines of [o_id-20, o_id) in one batch. Populate line_numer is random: [Min_OL_CNT, MAX_OL_CNT)
+  std::vector<DataSetItemPtr> ol_records;
+  ol_records.reserve(tpcc_stock_val_t::STOCK_LEVEL_ORDERS * tpcc_order_line_val_t::MAX_OL_CNT);
 
-  // Iterate over [o_id-20, o_id)
   for (int order_id = o_id - tpcc_stock_val_t::STOCK_LEVEL_ORDERS; order_id < o_id; ++order_id) {
-    // Populate line_numer is random: [Min_OL_CNT, MAX_OL_CNT)
     for (int line_number = 1; line_number <= tpcc_order_line_val_t::MAX_OL_CNT; ++line_number) {
       int64_t ol_key = tpcc_client->MakeOrderLineKey(warehouse_id, district_id, order_id, line_number);
       tpcc_order_line_key_t order_line_key;
       order_line_key.ol_id = ol_key;
-      auto ol_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kOrderLineTable,
-                                                     tpcc_order_line_val_t_size,
-                                                     order_line_key.item_key,
-                                                     UserOP::kRead);
-      txn->AddToReadOnlySet(ol_record);
-
-      if (!txn->Execute(yield, false)) {
-        // Not found, not abort
-        txn->RemoveLastROItem();
-        break;
-      }
+      auto ol_record = txn->NewItem((table_id_t)TPCCTableType::kOrderLineTable,
+                                    tpcc_order_line_val_t_size,
+                                    order_line_key.item_key,
+                                    UserOP::kRead);
+      ol_records.emplace_back(ol_record);
+    }
+  }
 
-      tpcc_order_line_val_t* ol_val = (tpcc_order_line_val_t*)ol_record->Value();
-      if (ol_val->debug_magic != tpcc_add_magic) {
-        RDMA_LOG(FATAL) << "[FATAL] Read order line unmatch, tid-cid-txid: " << txn->t_id << "-" << txn->coro_id << "-" << tx_id;
-      }
+  if (!txn->ExecuteBatch(yield, ol_records)) return false;
 
-      int64_t s_key = tpcc_client->MakeStockKey(warehouse_id, ol_val->ol_i_id);
-      tpcc_stock_key_t stock_key;
-      stock_key.s_id = s_key;
-      auto stock_record = std::make_shared<DataSetItem>((table_id_t)TPCCTableType::kStockTable,
-                                                        tpcc_stock_val_t_size,
-                                                        stock_key.item_key,
-                                                        UserOP::kRead);
-      txn->AddToReadOnlySet(stock_record);
+  // Read the stocks of the existing order lines in one batch. Multiple order lines can have the same item
+  std::vector<int32_t> ol_i_ids;
+  std::vector<DataSetItemPtr> stock_records;
+  ol_i_ids.reserve(ol_records.size());
+  stock_records.reserve(ol_records.size());
 
-      if (!txn->Execute(yield)) return false;
+  for (size_t i = 0; i < ol_records.size(); i++) {
+    if (ol_records[i]->IsNotFound()) {
+      // Not found, not abort. Skip the remaining lines of this order
+      i += tpcc_order_line_val_t::MAX_OL_CNT - 1 - i % tpcc_order_line_val_t::MAX_OL_CNT;
+      continue;
+    }
 
-      tpcc_stock_val_t* stock_val = (tpcc_stock_val_t*)stock_record->Value();
-      if (stock_val->debug_magic != tpcc_add_magic) {
-        RDMA_LOG(FATAL) << "[FATAL] Read stock unmatch, tid-cid-txid: " << txn->t_id << "-" << txn->coro_id << "-" << tx_id;
-      }
+    tpcc_order_line_val_t* ol_val = (tpcc_order_line_val_t*)ol_records[i]->Value();
+    if (ol_val->debug_magic != tpcc_add_magic) {
+      RDMA_LOG(FATAL) << "[FATAL] Read order line unmatch, tid-cid-txid: " << txn->t_id << "-" << txn->coro_id << "-" << tx_id;
+    }
 
-      if (stock_val->s_quantity < threshold) {
-        s_i_ids.push_back(ol_val->ol_i_id);
-      }
+    int64_t s_key = tpcc_client->MakeStockKey(warehouse_id, ol_val->ol_i_id);
+    tpcc_stock_key_t stock_key;
+    stock_key.s_id = s_key;
+    auto stock_record = txn->NewItem((table_id_t)TPCCTableType::kStockTable,
+                                     tpcc_stock_val_t_size,
+                                     stock_key.item_key,
+                                     UserOP::kRead);
+    ol_i_ids.push_back(ol_val->ol_i_id);
+    stock_records.emplace_back(stock_record);
+  }
+
+  if (!txn->ExecuteBatch(yield, stock_records)) return false;
+
+  std::vector<int32_t> s_i_ids;
+  s_i_ids.reserve(300);
+
+  for (size_t i = 0; i < stock_records.size(); i++) {
+    if (stock_records[i]->IsNotFound()) {
+      // A stock must exist
+      txn->TxAbortReadWrite();
+      return false;
+    }
+
+    tpcc_stock_val_t* stock_val = (tpcc_stock_val_t*)stock_records[i]->Value();
+    if (stock_val->debug_magic != tpcc_add_magic) {
+      RDMA_LOG(FATAL) << "[FATAL] Read stock unmatch, tid-cid-txid: " << txn->t_id << "-" << txn->coro_id << "-" << tx_id;
+    }
+
+    if (stock_val->s_quantity < threshold) {
+      s_i_ids.push_back(ol_i_ids[i]);
     }
   }
 
@@ -921,3 +950,16 @@ bool TxStockLevel(TPCC* tpcc_client,
 }
 
 /******************** The business logic (Transaction) end ********************/
+
+void RegisterTPCCProcedures(ProcRegistry* registry, TPCC* tpcc_client) {
+  registry->AddWorkload("tpcc", tpcc_client);
+  auto reg = [registry](TPCCTxType type, ProcHandler handler, int weight, int max_retry) {
+    registry->Register("tpcc", (proc_id_t)type, TPCC_TX_NAME[(int)type], handler, weight, max_retry);
+  };
+  reg(TPCCTxType::kNewOrder, RandomProc<TPCC, TxNewOrder>, FREQUENCY_NEW_ORDER, 0);
+  reg(TPCCTxType::kPayment, RandomProc<TPCC, TxPayment>, FREQUENCY_PAYMENT, 0);
+  reg(TPCCTxType::kDelivery, RandomProc<TPCC, TxDelivery>, FREQUENCY_DELIVERY, 0);
+  reg(TPCCTxType::kOrderStatus, RandomProc<TPCC, TxOrderStatus>, FREQUENCY_ORDER_STATUS, 0);
+  // A read-only scan of recent orders, which is retried rather than reported
+  reg(TPCCTxType::kStockLevel, RandomProc<TPCC, TxStockLevel>, FREQUENCY_STOCK_LEVEL, RETRY_UNTIL_COMMIT);
+}